@@ -7,11 +7,378 @@
 #ifndef CC0_ARR_H_INCLUDED__
 #define CC0_ARR_H_INCLUDED__
 
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__)
+	#include <emmintrin.h>
+#endif
+
+// Define CC0_ARR_CHECKED to assert that indices and sub-view bounds are within the bounds of arrays and slices. Without it, no checks are compiled in, and indexing decays to plain pointer arithmetic.
+#if defined(CC0_ARR_CHECKED)
+	#include <cassert>
+	#define CC0_ARR_ASSERT(condition) assert(condition)
+#else
+	#define CC0_ARR_ASSERT(condition) ((void)0)
+#endif
+
+// Define CC0_ARR_INSTRUMENT to count and report the allocations, frees, pool reuses and deep copies made by variable-size and small arrays. Without it, no instrumentation is compiled in.
+#if defined(CC0_ARR_INSTRUMENT)
+	#include <atomic>
+	#define CC0_ARR_INSTRUMENT_EVENT(event, mem, bytes) cc0::internal::instrument(cc0::event, mem, bytes)
+#else
+	#define CC0_ARR_INSTRUMENT_EVENT(event, mem, bytes) ((void)0)
+#endif
+
+// Define CC0_ARR_DISPATCH to select the SIMD variant of the bulk slice operations at runtime, based on the features of the CPU, instead of at compile time. Without it, bulk operations use the instruction sets the program is compiled for.
+#if defined(CC0_ARR_DISPATCH)
+	#include <atomic>
+	#include <cstdlib>
+	#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+		#include <immintrin.h>
+		#define CC0_ARR_DISPATCH_X86
+	#endif
+#endif
 
 namespace cc0
 {
 
+	/// @brief A common cache line size, in bytes, for use as array alignment.
+	constexpr uint64_t cache_line_align = 64;
+
+	/// @brief A common memory page size, in bytes, for use as array alignment.
+	constexpr uint64_t page_align = 4096;
+
+	/// @brief An interface for allocating and freeing the raw memory used by variable-size arrays. Implementing this interface allows arrays to be backed by arenas, pools, or other custom allocation strategies, and allows memory to be shared between array objects.
+	/// @note Arrays only reference their allocators - they do not own them. The programmer is responsible for ensuring that an allocator outlives all arrays using it.
+	class allocator
+	{
+	public:
+		/// @brief Destructor.
+		virtual ~allocator( void );
+
+		/// @brief Allocates raw, uninitialized memory.
+		/// @param size The number of bytes to allocate.
+		/// @param align The required alignment, in bytes, of the allocated memory.
+		/// @return The allocated memory.
+		virtual void *allocate(uint64_t size, uint64_t align) = 0;
+
+		/// @brief Frees memory previously allocated by the same allocator.
+		/// @param mem The memory to free.
+		/// @param size The number of bytes originally requested.
+		/// @param align The alignment originally requested.
+		virtual void deallocate(void *mem, uint64_t size, uint64_t align) = 0;
+	};
+
+	/// @brief An allocator that allocates memory from the global heap. This is the default allocator for variable-size arrays. Alignments stricter than that of the global heap are handled by over-allocating.
+	class heap_allocator : public cc0::allocator
+	{
+	public:
+		/// @brief Allocates raw, uninitialized memory from the global heap.
+		/// @param size The number of bytes to allocate.
+		/// @param align The required alignment, in bytes, of the allocated memory.
+		/// @return The allocated memory.
+		void *allocate(uint64_t size, uint64_t align);
+
+		/// @brief Frees memory back to the global heap.
+		/// @param mem The memory to free.
+		/// @param size The number of bytes originally requested.
+		/// @param align The alignment originally requested.
+		void deallocate(void *mem, uint64_t size, uint64_t align);
+	};
+
+	/// @brief Returns the allocator used by variable-size arrays unless otherwise specified. This is a heap allocator unless changed by set_default_allocator.
+	/// @return The default allocator.
+	cc0::allocator *default_allocator( void );
+
+	/// @brief Sets the allocator used by variable-size arrays created from now on unless otherwise specified. Existing arrays keep using the allocator they were created with.
+	/// @warning Not thread-safe. Set the default allocator before arrays are created on other threads, e.g. at program start.
+	/// @param allocator The new default allocator. A null allocator restores the heap allocator.
+	void set_default_allocator(cc0::allocator *allocator);
+
+#if defined(CC0_ARR_INSTRUMENT)
+	/// @brief The events reported by instrumentation. Only declared if CC0_ARR_INSTRUMENT is defined.
+	enum instrument_event
+	{
+		instrument_allocate,   // Memory for elements was allocated.
+		instrument_deallocate, // Memory for elements was freed.
+		instrument_pool_reuse, // An array was created within memory it already held instead of allocating new memory.
+		instrument_deep_copy,  // Elements were copied into an array from another array, slice, or list of values.
+		instrument_event_count
+	};
+
+	/// @brief Instrumentation statistics, accumulated over all threads. Only declared if CC0_ARR_INSTRUMENT is defined.
+	struct instrument_statistics
+	{
+		uint64_t allocations;       // The number of allocations.
+		uint64_t deallocations;     // The number of frees.
+		uint64_t pool_reuses;       // The number of times memory was reused rather than allocated.
+		uint64_t deep_copies;       // The number of deep copies.
+		uint64_t bytes_allocated;   // The number of bytes allocated.
+		uint64_t bytes_deallocated; // The number of bytes freed.
+		uint64_t bytes_reused;      // The number of bytes of elements created in reused memory.
+		uint64_t bytes_copied;      // The number of bytes of elements copied by deep copies.
+	};
+
+	/// @brief A function called for every instrumentation event.
+	/// @param event The event.
+	/// @param mem The memory allocated, freed, reused, or copied to.
+	/// @param bytes The number of bytes allocated, freed, reused, or copied.
+	/// @param user The user data passed to set_instrument_callback.
+	typedef void (*instrument_callback)(cc0::instrument_event event, const void *mem, uint64_t bytes, void *user);
+
+	/// @brief Gets the instrumentation statistics accumulated since program start or the last reset. Only declared if CC0_ARR_INSTRUMENT is defined.
+	/// @return The statistics.
+	cc0::instrument_statistics get_instrument_statistics( void );
+
+	/// @brief Sets all instrumentation statistics to zero. Only declared if CC0_ARR_INSTRUMENT is defined.
+	void reset_instrument_statistics( void );
+
+	/// @brief Sets a function to be called for every instrumentation event, e.g. to log or break on unexpected deep copies. Only declared if CC0_ARR_INSTRUMENT is defined.
+	/// @warning Not thread-safe. Set the callback before arrays are used on other threads. The callback itself may be called from any thread using arrays.
+	/// @param callback The function to call. A null callback disables callbacks.
+	/// @param user User data passed to the callback.
+	void set_instrument_callback(cc0::instrument_callback callback, void *user = nullptr);
+#endif
+
+#if defined(CC0_ARR_DISPATCH)
+	/// @brief The instruction set variants that bulk slice operations can be dispatched to. Only declared if CC0_ARR_DISPATCH is defined.
+	enum isa
+	{
+		isa_scalar, // Portable code, vectorized only as far as the compiler manages for the instruction sets the program is compiled for.
+		isa_sse2,   // 128-bit SSE2 kernels.
+		isa_avx2,   // 256-bit AVX2 kernels.
+		isa_avx512, // 512-bit AVX-512 kernels. Requires the F and BW subsets.
+		isa_count
+	};
+
+	/// @brief Gets the best instruction set variant supported by both the CPU and the compiler. Only declared if CC0_ARR_DISPATCH is defined.
+	/// @return The variant.
+	cc0::isa detected_isa( void );
+
+	/// @brief Gets the instruction set variant bulk operations are dispatched to. Unless changed by set_isa, this is the detected variant, or the variant named by the CC0_ARR_ISA environment variable ("scalar", "sse2", "avx2" or "avx512") if it is set to a supported variant when bulk operations are first used. Only declared if CC0_ARR_DISPATCH is defined.
+	/// @return The variant.
+	cc0::isa active_isa( void );
+
+	/// @brief Forces bulk operations to be dispatched to a given instruction set variant, e.g. to compare variants in benchmarks. Safe to call at any time, although operations already running on other threads finish on the previous variant. Only declared if CC0_ARR_DISPATCH is defined.
+	/// @param isa The variant.
+	/// @return False if the variant is not supported by the CPU or the compiler, in which case the active variant is left unchanged.
+	bool set_isa(cc0::isa isa);
+
+	/// @brief Checks if an instruction set variant is supported by both the CPU and the compiler. Only declared if CC0_ARR_DISPATCH is defined.
+	/// @param isa The variant.
+	/// @return True if the variant can be used.
+	bool isa_supported(cc0::isa isa);
+
+	/// @brief Gets the name of an instruction set variant, as accepted by the CC0_ARR_ISA environment variable. Only declared if CC0_ARR_DISPATCH is defined.
+	/// @param isa The variant.
+	/// @return The name.
+	const char *isa_name(cc0::isa isa);
+#endif
+
+	/// @brief Implementation details. Not intended to be used directly.
+	namespace internal
+	{
+		/// @brief Returns the global heap allocator.
+		/// @return The heap allocator.
+		cc0::allocator *heap( void );
+
+		/// @brief Returns the storage of the default allocator.
+		/// @return A reference to the default allocator.
+		cc0::allocator *&default_allocator( void );
+
+		/// @brief Allocates memory for elements from an allocator, reporting the allocation if instrumentation is enabled.
+		/// @param allocator The allocator.
+		/// @param size The number of bytes to allocate.
+		/// @param align The required alignment, in bytes, of the allocated memory.
+		/// @return The allocated memory.
+		void *allocate(cc0::allocator *allocator, uint64_t size, uint64_t align);
+
+		/// @brief Frees memory for elements back to an allocator, reporting the free if instrumentation is enabled.
+		/// @param allocator The allocator.
+		/// @param mem The memory to free.
+		/// @param size The number of bytes originally requested.
+		/// @param align The alignment originally requested.
+		void deallocate(cc0::allocator *allocator, void *mem, uint64_t size, uint64_t align);
+
+		/// @brief Computes the number of bytes needed to hold a number of elements.
+		/// @tparam type_t The type of the elements.
+		/// @param count The number of elements.
+		/// @return The number of bytes. Throws std::bad_alloc if the number does not fit in 64 bits.
+		template < typename type_t >
+		uint64_t array_bytes(uint64_t count);
+
+		/// @brief Frees memory for elements when going out of scope unless released, so that new memory is not leaked if constructing elements in it throws.
+		struct allocation_guard
+		{
+			cc0::allocator *allocator;
+			void           *mem;
+			uint64_t        size;
+			uint64_t        align;
+
+			/// @brief Frees the memory, unless released.
+			~allocation_guard( void );
+
+			/// @brief Keeps the memory from being freed.
+			void release( void );
+		};
+
+		/// @brief Destroys constructed elements when going out of scope, so that elements already constructed are not leaked if constructing a later element throws.
+		/// @tparam type_t The type of the elements.
+		template < typename type_t >
+		struct construct_guard
+		{
+			type_t   *dst;
+			uint64_t  count;
+
+			/// @brief Destroys the constructed elements.
+			~construct_guard( void );
+		};
+
+#if defined(CC0_ARR_INSTRUMENT)
+		/// @brief The global instrumentation state.
+		struct instrument_state
+		{
+			std::atomic<uint64_t>    counts[cc0::instrument_event_count];
+			std::atomic<uint64_t>    bytes[cc0::instrument_event_count];
+			cc0::instrument_callback callback;
+			void                    *user;
+		};
+
+		/// @brief Returns the global instrumentation state.
+		/// @return The state.
+		cc0::internal::instrument_state &instrumentation( void );
+
+		/// @brief Records an instrumentation event and calls the instrumentation callback.
+		/// @param event The event.
+		/// @param mem The memory of the event.
+		/// @param bytes The number of bytes of the event.
+		void instrument(cc0::instrument_event event, const void *mem, uint64_t bytes);
+#endif
+
+		template < typename type_t, uint64_t align_u >
+		struct is_valid_alignment : std::integral_constant<bool, align_u >= alignof(type_t) && (align_u & (align_u - 1)) == 0> {};
+
+		/// @brief Determines if elements of one type can be copied into elements of another type as raw memory.
+		/// @tparam type_t The destination type.
+		/// @tparam type2_t The source type.
+		template < typename type_t, typename type2_t >
+		struct is_bitwise_copyable : std::integral_constant<bool, std::is_same<typename std::remove_cv<type_t>::type, typename std::remove_cv<type2_t>::type>::value && std::is_trivially_copyable<type_t>::value> {};
+
+		/// @brief Converts a value implicitly, so that expanded construction accepts the same conversions as assignment in a loop, i.e. neither explicit conversions nor narrowing errors.
+		/// @tparam type_t The type to convert to.
+		/// @tparam type2_t The type to convert from.
+		/// @param value The value.
+		/// @return The converted value.
+		template < typename type_t, typename type2_t >
+		constexpr type_t implicit_convert(const type2_t &value) { return value; }
+
+		/// @brief A compile-time list of indices.
+		template < uint64_t... i_u >
+		struct index_list {};
+
+		/// @brief Generates the index list 0, 1, ..., n_u - 1.
+		template < uint64_t n_u, uint64_t... i_u >
+		struct make_index_list : make_index_list<n_u - 1, n_u - 1, i_u...> {};
+
+		template < uint64_t... i_u >
+		struct make_index_list<0, i_u...>
+		{
+			typedef index_list<i_u...> type;
+		};
+
+		/// @brief The largest fixed size for which element-wise operations and constant construction are expanded element by element at compile time. Larger fixed-size arrays use loops.
+		constexpr uint64_t unroll_limit = 16;
+
+		/// @brief Selects loops over compile-time expansion.
+		struct loop_tag {};
+
+		/// @brief Selects the index list of a fixed-size array if the array is small enough to be expanded at compile time, and loop_tag otherwise.
+		template < uint64_t size_u, bool unroll_b = (size_u <= unroll_limit) >
+		struct unroll_indices
+		{
+			typedef typename make_index_list<size_u>::type type;
+		};
+
+		template < uint64_t size_u >
+		struct unroll_indices<size_u,false>
+		{
+			typedef loop_tag type;
+		};
+
+		/// @brief Defines the given type only for non-zero sizes, so that operators on fixed-size arrays do not apply to variable-size arrays.
+		template < typename result_t, uint64_t size_u >
+		struct if_fixed
+		{
+			typedef result_t type;
+		};
+
+		template < typename result_t >
+		struct if_fixed<result_t,0> {};
+
+		/// @brief Default-constructs elements in uninitialized memory. Does nothing for trivially constructible types.
+		/// @tparam type_t The type of the elements.
+		/// @param dst The uninitialized memory.
+		/// @param count The number of elements to construct.
+		template < typename type_t >
+		void construct(type_t *dst, uint64_t count);
+
+		/// @brief Destroys elements, leaving behind uninitialized memory. Does nothing for trivially destructible types.
+		/// @tparam type_t The type of the elements.
+		/// @param dst The elements to destroy.
+		/// @param count The number of elements to destroy.
+		template < typename type_t >
+		void destruct(type_t *dst, uint64_t count);
+
+		/// @brief Copy-constructs elements into uninitialized memory. Reduces to a memcpy for trivially copyable elements of identical type.
+		/// @tparam type_t The destination type.
+		/// @tparam type2_t The source type.
+		/// @param dst The uninitialized memory to construct elements in.
+		/// @param src The elements to copy.
+		/// @param count The number of elements to copy.
+		template < typename type_t, typename type2_t >
+		void copy_construct(type_t *dst, const type2_t *src, uint64_t count);
+
+		/// @brief Copy-assigns elements in ascending order. Reduces to a memmove for trivially copyable elements of identical type.
+		/// @tparam type_t The destination type.
+		/// @tparam type2_t The source type.
+		/// @param dst The elements to assign to.
+		/// @param src The elements to copy.
+		/// @param count The number of elements to copy.
+		template < typename type_t, typename type2_t >
+		void copy_assign(type_t *dst, const type2_t *src, uint64_t count);
+
+		/// @brief Move-constructs elements into uninitialized memory. Reduces to a memcpy for trivially copyable elements of identical type. The source elements are left in a moved-from state, but are not destroyed.
+		/// @tparam type_t The destination type.
+		/// @tparam type2_t The source type.
+		/// @param dst The uninitialized memory to construct elements in.
+		/// @param src The elements to move.
+		/// @param count The number of elements to move.
+		template < typename type_t, typename type2_t >
+		void move_construct(type_t *dst, type2_t *src, uint64_t count);
+
+		/// @brief Move-assigns elements in ascending order. Reduces to a memmove for trivially copyable elements of identical type. The source elements are left in a moved-from state.
+		/// @tparam type_t The destination type.
+		/// @tparam type2_t The source type.
+		/// @param dst The elements to assign to.
+		/// @param src The elements to move.
+		/// @param count The number of elements to move.
+		template < typename type_t, typename type2_t >
+		void move_assign(type_t *dst, type2_t *src, uint64_t count);
+
+		/// @brief Determines if a variable-size array can take over the memory of another variable-size array as is, rather than moving its elements one by one.
+		/// @tparam type_t The element type of the receiving array.
+		/// @tparam type2_t The element type of the other array.
+		/// @tparam align_u The alignment of the receiving array.
+		/// @tparam align2_u The alignment of the other array.
+		template < typename type_t, typename type2_t, uint64_t align_u, uint64_t align2_u >
+		struct is_adoptable : std::integral_constant<bool, std::is_convertible<type2_t*,type_t*>::value && sizeof(type_t) == sizeof(type2_t) && align_u == align2_u> {};
+	}
+
 	// TODO: values may not be necessary if array<type,size> can be a substitute.
 
 	/// @brief A type of array mainly used for direct assignment in the other array types.
@@ -26,9 +393,9 @@ namespace cc0
 		/// @return The pointer to the array data.
 		operator type_t*( void );
 		
-		/// @brief Allows direct access to the value array.
+		/// @brief Allows direct access to the value array. Usable in constant expressions.
 		/// @return The pointer to the array data.
-		operator const type_t*( void ) const;
+		constexpr operator const type_t*( void ) const;
 	};
 
 	/// @brief A view into an existing array or slice. Slices do not own data - they only provide a view into it, in full or in part. This means that the programmer is responsible for ensuring that the data the slice is viewing is valid when being viewed, e.g. not our of scope or otherwise deleted. Elements in a slice can be manipulated, but the topography of the array itself can not be modified from within a slice even though subsets of the slice can be returned (create slices with smaller range from another slice).
@@ -91,6 +458,22 @@ namespace cc0
 		/// @return The pointer to the array data.
 		operator const type_t*( void ) const;
 
+#if defined(CC0_ARR_CHECKED)
+		/// @brief Accesses an element, asserting that the index is within bounds. Only declared in checked mode; otherwise indexing decays to the pointer to the array data.
+		/// @tparam index_t The type of the index.
+		/// @param i The index of the element.
+		/// @return A reference to the element.
+		template < typename index_t >
+		type_t &operator[](index_t i);
+
+		/// @brief Accesses an element, asserting that the index is within bounds. Only declared in checked mode; otherwise indexing decays to the pointer to the array data.
+		/// @tparam index_t The type of the index.
+		/// @param i The index of the element.
+		/// @return A reference to the element.
+		template < typename index_t >
+		const type_t &operator[](index_t i) const;
+#endif
+
 		/// @brief Implicitly converts the slice into a readonly slice.
 		/// @tparam type2_t The other type.
 		/// @return The const version of the slice. 
@@ -117,11 +500,16 @@ namespace cc0
 	/// @brief A fixed-size array.
 	/// @tparam type_t The type of the array.
 	/// @tparam size_u The number of elements in the array.
-	template < typename type_t, uint64_t size_u = 0 >
+	/// @tparam align_u The alignment, in bytes, of the first element in the array. Must be a power of two no less than the natural alignment of the type.
+	template < typename type_t, uint64_t size_u = 0, uint64_t align_u = alignof(type_t) >
 	class array
 	{
+		template < typename, uint64_t, uint64_t > friend class array;
+
 	private:
-		type_t m_values[size_u];
+		static_assert(cc0::internal::is_valid_alignment<type_t,align_u>::value, "align_u must be a power of two no less than the natural alignment of type_t");
+
+		alignas(align_u) type_t m_values[size_u];
 
 	private:
 		/// @brief Copies memory into the object.
@@ -130,43 +518,56 @@ namespace cc0
 		template < typename type2_t >
 		void copy(const type2_t *values);
 
+		/// @brief Copies memory into the object element by element. Usable in constant expressions.
+		/// @tparam type2_t The type of the memory to copy.
+		/// @tparam i_u The indices of the elements.
+		/// @param values The values to copy.
+		template < typename type2_t, uint64_t... i_u >
+		constexpr array(const type2_t *values, cc0::internal::index_list<i_u...>);
+
+		/// @brief Copies memory into the object in a loop.
+		/// @tparam type2_t The type of the memory to copy.
+		/// @param values The values to copy.
+		template < typename type2_t >
+		array(const type2_t *values, cc0::internal::loop_tag);
+
 	public:
 		/// @brief The default constructor. Does nothing. Does not initialize array elements.
 		array( void ) = default;
 
 		/// @brief Copies a given array of identical type and size.
 		/// @param NA The array to copy.
-		array(const array<type_t,size_u>&) = default;
+		array(const array&) = default;
 
 		/// @brief Copies a given array of identical size, but of different type that can be converted to the target type. Allows copying e.g. a float array into an int array, or an array of pointers to derived objects to pointers of base class objects.
 		/// @tparam type2_t The second type.
 		/// @param arr The array to copy.
-		template < typename type2_t >
-		array(const array<type2_t,size_u> &arr);
+		template < typename type2_t, uint64_t align2_u >
+		constexpr array(const array<type2_t,size_u,align2_u> &arr);
 
 		/// @brief Copies a given array of values of identical size, but of different type that can be converted to the target type. Allows copying e.g. a float array into an int array, or an array of pointers to derived objects to pointers of base class objects.
 		/// @tparam type2_t The second type.
 		/// @param values The array of values to copy.
 		template < typename type2_t >
-		array(const type2_t (&values)[size_u]);
+		constexpr array(const type2_t (&values)[size_u]);
 
 		/// @brief Copies a given array of values of identical size, but of different type that can be converted to the target type. Allows copying e.g. a float array into an int array, or an array of pointers to derived objects to pointers of base class objects.
 		/// @tparam type2_t The second type.
 		/// @param vals The array of values to copy.
 		template < typename type2_t >
-		array(const values<type2_t,size_u> &vals);
+		constexpr array(const values<type2_t,size_u> &vals);
 
 		/// @brief Copies a given array of identical type and size.
 		/// @param NA The array to copy.
 		/// @return A reference to the object being assigned.
-		array &operator=(const array<type_t,size_u>&) = default;
+		array &operator=(const array&) = default;
 
 		/// @brief Copies a given array of identical size, but of different type that can be converted to the target type. Allows copying e.g. a float array into an int array, or an array of pointers to derived objects to pointers of base class objects.
 		/// @tparam type2_t The second type.
 		/// @param arr The array to copy.
 		/// @return A reference to the object being assigned.
-		template < typename type2_t >
-		array &operator=(const array<type2_t,size_u> &arr);
+		template < typename type2_t, uint64_t align2_u >
+		array &operator=(const array<type2_t,size_u,align2_u> &arr);
 
 		/// @brief Copies a given array of values of identical size, but of different type that can be converted to the target type. Allows copying e.g. a float array into an int array, or an array of pointers to derived objects to pointers of base class objects.
 		/// @tparam type2_t The second type.
@@ -186,9 +587,25 @@ namespace cc0
 		/// @return The pointer to the array data.
 		operator type_t*( void );
 
-		/// @brief Allows direct access to the value array.
+		/// @brief Allows direct access to the value array. Usable in constant expressions.
 		/// @return The pointer to the array data.
-		operator const type_t*( void ) const;
+		constexpr operator const type_t*( void ) const;
+
+#if defined(CC0_ARR_CHECKED)
+		/// @brief Accesses an element, asserting that the index is within bounds. Only declared in checked mode; otherwise indexing decays to the pointer to the array data.
+		/// @tparam index_t The type of the index.
+		/// @param i The index of the element.
+		/// @return A reference to the element.
+		template < typename index_t >
+		type_t &operator[](index_t i);
+
+		/// @brief Accesses an element, asserting that the index is within bounds. Only declared in checked mode; otherwise indexing decays to the pointer to the array data. Usable in constant expressions.
+		/// @tparam index_t The type of the index.
+		/// @param i The index of the element.
+		/// @return A reference to the element.
+		template < typename index_t >
+		constexpr const type_t &operator[](index_t i) const;
+#endif
 
 		/// @brief Converts the array into a slice covering the full span of the array.
 		/// @tparam type2_t The other type.
@@ -224,20 +641,50 @@ namespace cc0
 
 		/// @brief Gets the size of the array.
 		/// @return The number of elements in the array.
-		uint64_t size( void ) const;
+		constexpr uint64_t size( void ) const;
 	};
 
 	/// @brief A variable-size array.
 	/// @tparam type_t The type of the array.
-	template < typename type_t >
-	class array<type_t,0>
+	/// @tparam align_u The alignment, in bytes, of the first element in the array. Must be a power of two no less than the natural alignment of the type.
+	template < typename type_t, uint64_t align_u >
+	class array<type_t,0,align_u>
 	{
+		template < typename, uint64_t, uint64_t > friend class array;
+
 	private:
-		type_t   *m_values;
-		uint64_t  m_size;
-		uint64_t  m_capacity;
+		type_t         *m_values;
+		uint64_t        m_size;
+		uint64_t        m_capacity;
+		cc0::allocator *m_allocator;
+
+		static_assert(cc0::internal::is_valid_alignment<type_t,align_u>::value, "align_u must be a power of two no less than the natural alignment of type_t");
 
 	private:
+		/// @brief Constructs elements in the range [m_size, size) and destroys elements in the range [size, m_size) so that the array holds exactly the given number of live elements.
+		/// @param size The new number of live elements. Must not exceed the capacity.
+		void set_size(uint64_t size);
+
+		/// @brief Allocates uninitialized memory for a given number of elements using the array's allocator.
+		/// @param capacity The number of elements to allocate memory for.
+		/// @return The allocated memory, or null if the capacity is 0.
+		type_t *allocate(uint64_t capacity);
+
+		/// @brief Moves the live elements into new memory and frees the old memory. The new memory is freed if moving an element throws.
+		/// @param mem The new memory, allocated by the array's allocator. May be null if there are no live elements.
+		/// @param capacity The number of elements the new memory can hold. Must not be less than the size of the array.
+		void reallocate(type_t *mem, uint64_t capacity);
+
+		/// @brief Destroys the live elements and frees the old memory, and switches to new memory that the live elements have been moved into.
+		/// @param mem The new memory, allocated by the array's allocator.
+		/// @param capacity The number of elements the new memory can hold.
+		void replace(type_t *mem, uint64_t capacity);
+
+		/// @brief Computes the capacity to grow to in order to fit at least a given number of elements, growing geometrically to amortize the cost of repeated growth.
+		/// @param size The number of elements that need to fit.
+		/// @return The new capacity.
+		uint64_t grow(uint64_t size) const;
+
 		/// @brief Copies memory into the object.
 		/// @tparam type2_t The type of the memory to copy.
 		/// @param values The values to copy.
@@ -246,39 +693,77 @@ namespace cc0
 		template < typename type2_t >
 		void copy(const type2_t *values, uint64_t size, bool use_pool);
 
+		/// @brief Moves memory into the object element by element, leaving the source elements in a moved-from state.
+		/// @tparam type2_t The type of the memory to move.
+		/// @param values The values to move.
+		/// @param size The size of the array to move.
+		/// @param use_pool Determine if the array should pool memory if the size is less than the capacity of the array.
+		template < typename type2_t >
+		void move(type2_t *values, uint64_t size, bool use_pool);
+
+		/// @brief Takes over the memory of another array, leaving the other array empty.
+		/// @tparam type2_t The other type.
+		/// @tparam align2_u The other alignment.
+		/// @param arr The other array.
+		template < typename type2_t, uint64_t align2_u >
+		void take(array<type2_t,0,align2_u> &arr, std::true_type);
+
+		/// @brief Moves the elements of another array into the object, and frees the memory of the other array, leaving it empty.
+		/// @tparam type2_t The other type.
+		/// @tparam align2_u The other alignment.
+		/// @param arr The other array.
+		template < typename type2_t, uint64_t align2_u >
+		void take(array<type2_t,0,align2_u> &arr, std::false_type);
+
 	public:
 		/// @brief Default contstructor. Sets the array memory to null, and size to 0.
 		array( void );
 
-		/// @brief Moves data from one array of one type to another.
+		/// @brief Sets the array memory to null, and size to 0, and specifies the allocator to use for the array.
+		/// @param allocator The allocator to allocate and free memory with.
+		explicit array(cc0::allocator *allocator);
+
+		/// @brief Moves data from one array of one type to another. The memory of the other array is taken over as is if pointers to its elements convert to pointers to elements of this array, and the element sizes and alignments are identical. Otherwise, elements are move-constructed into new memory, e.g. std::string to a string type constructible from std::string&&.
 		/// @tparam type2_t The other type.
-		/// @param arr The other array.
-		template < typename type2_t >
-		array(array<type2_t> &&arr);
+		/// @tparam align2_u The other alignment.
+		/// @param arr The other array. Left empty.
+		template < typename type2_t, uint64_t align2_u >
+		array(array<type2_t,0,align2_u> &&arr);
 
 		/// @brief Moves data from one array to another.
 		/// @param arr The other array.
-		array(array<type_t> &&arr);
+		array(array &&arr);
 
 		/// @brief Allocate new memory for the array given a new size.
 		/// @param size The number of elements in the newly created array.
 		explicit array(uint64_t size);
 
+		/// @brief Allocate new memory for the array given a new size using the specified allocator.
+		/// @param size The number of elements in the newly created array.
+		/// @param allocator The allocator to allocate and free memory with.
+		array(uint64_t size, cc0::allocator *allocator);
+
 		/// @brief Copies an array of a potentially different type, allowing for implicit conversions e.g. int to float array or derived class pointer to base class pointer.
 		/// @tparam type2_t The other type.
 		/// @param arr The array to copy.
-		template < typename type2_t >
-		array(const array<type2_t> &arr);
+		template < typename type2_t, uint64_t align2_u >
+		array(const array<type2_t,0,align2_u> &arr);
 
 		/// @brief Copies an array.
 		/// @param arr The array to copy.
-		array(const array<type_t> &arr);
+		array(const array &arr);
 
 		/// @brief Copies an array of a potentially different type, allowing for implicit conversions e.g. int to float array or derived class pointer to base class pointer.
 		/// @tparam type2_t The other type.
 		/// @param arr The array to copy.
-		template < typename type2_t, uint64_t size_u >
-		array(const array<type2_t,size_u> &arr);
+		template < typename type2_t, uint64_t size_u, uint64_t align2_u >
+		array(const array<type2_t,size_u,align2_u> &arr);
+
+		/// @brief Moves the elements of a fixed-size array of a potentially different type into new memory, leaving the elements of the other array in a moved-from state.
+		/// @tparam type2_t The other type.
+		/// @param arr The array to move.
+		template < typename type2_t, uint64_t size_u, uint64_t align2_u >
+		array(array<type2_t,size_u,align2_u> &&arr);
 
 		/// @brief Copies a slice of an array of a potentially different type, allowing for implicit conversions e.g. int to float array or derived class pointer to base class pointer.
 		/// @tparam type2_t The other type.
@@ -313,6 +798,13 @@ namespace cc0
 		template < typename type2_t, uint64_t size_u >
 		array(const values<type2_t,size_u> &vals);
 
+		/// @brief Moves an array of values of a potentially different type into new memory, leaving the values in a moved-from state.
+		/// @tparam type2_t The other type.
+		/// @tparam size_u The size of the array of values to move.
+		/// @param vals The array of values to move.
+		template < typename type2_t, uint64_t size_u >
+		array(values<type2_t,size_u> &&vals);
+
 		/// @brief Frees allocated memory.
 		~array( void );
 
@@ -320,32 +812,40 @@ namespace cc0
 		/// @tparam type2_t The other type.
 		/// @param arr The array to copy.
 		/// @return A reference to the object being assigned.
-		template < typename type2_t >
-		array &operator=(const array<type2_t> &arr);
+		template < typename type2_t, uint64_t align2_u >
+		array &operator=(const array<type2_t,0,align2_u> &arr);
 
 		/// @brief Copies an array.
 		/// @param arr The array to copy.
 		/// @return A reference to the object being assigned.
-		array &operator=(const array<type_t> &arr);
+		array &operator=(const array &arr);
 
-		/// @brief Moves data from one array of one type to another.
+		/// @brief Moves data from one array of one type to another. The memory of the other array is taken over as is if pointers to its elements convert to pointers to elements of this array, and the element sizes and alignments are identical. Otherwise, elements are moved element by element.
 		/// @tparam type2_t The other type.
-		/// @param arr The other array.
+		/// @tparam align2_u The other alignment.
+		/// @param arr The other array. Left empty.
 		/// @return A reference to the object being assigned.
-		template < typename type2_t >
-		array &operator=(array<type2_t> &&arr);
+		template < typename type2_t, uint64_t align2_u >
+		array &operator=(array<type2_t,0,align2_u> &&arr);
 
 		/// @brief Moves data from one array to another.
 		/// @param arr The other array.
 		/// @return A reference to the object being assigned.
-		array &operator=(array<type_t> &&arr);
+		array &operator=(array &&arr);
 
 		/// @brief Copies an array of a potentially different type, allowing for implicit conversions e.g. int to float array or derived class pointer to base class pointer.
 		/// @tparam type2_t The other type.
 		/// @param arr The array to copy.
 		/// @return A reference to the object being assigned.
-		template < typename type2_t, uint64_t size_u >
-		array &operator=(const array<type2_t,size_u> &arr);
+		template < typename type2_t, uint64_t size_u, uint64_t align2_u >
+		array &operator=(const array<type2_t,size_u,align2_u> &arr);
+
+		/// @brief Moves the elements of a fixed-size array of a potentially different type into the array, leaving the elements of the other array in a moved-from state.
+		/// @tparam type2_t The other type.
+		/// @param arr The array to move.
+		/// @return A reference to the object being assigned.
+		template < typename type2_t, uint64_t size_u, uint64_t align2_u >
+		array &operator=(array<type2_t,size_u,align2_u> &&arr);
 
 		/// @brief Copies a slice of an array of a potentially different type, allowing for implicit conversions e.g. int to float array or derived class pointer to base class pointer.
 		/// @tparam type2_t The other type.
@@ -370,6 +870,14 @@ namespace cc0
 		template < typename type2_t, uint64_t size_u >
 		array &operator=(const values<type2_t,size_u> &vals);
 
+		/// @brief Moves an array of values of a potentially different type into the array, leaving the values in a moved-from state.
+		/// @tparam type2_t The other type.
+		/// @tparam size_u The size of the array of values to move.
+		/// @param vals The array of values to move.
+		/// @return A reference to the object being assigned.
+		template < typename type2_t, uint64_t size_u >
+		array &operator=(values<type2_t,size_u> &&vals);
+
 		/// @brief Allocate new memory for the array given a new size.
 		/// @param size The number of elements in the newly created array.
 		/// @param use_pool Determine if the array should pool memory if the size is less than the capacity of the array.
@@ -379,6 +887,52 @@ namespace cc0
 		/// @param use_pool Only sets the size of the array to zero without actually freeing the underlying memory.
 		void destroy(bool use_pool = true);
 
+		/// @brief Ensures that the array can hold a given number of elements without allocating new memory. Elements are preserved.
+		/// @param capacity The minimum number of elements the array should be able to hold.
+		void reserve(uint64_t capacity);
+
+		/// @brief Changes the number of elements in the array. Elements are preserved up to the new size, and new elements are default-constructed. Unlike create, memory grows geometrically if the new size exceeds the capacity.
+		/// @param size The new number of elements in the array.
+		void resize(uint64_t size);
+
+		/// @brief Adds a copy of an element to the end of the array, growing memory geometrically if needed.
+		/// @param value The value to add.
+		void push_back(const type_t &value);
+
+		/// @brief Moves an element to the end of the array, growing memory geometrically if needed.
+		/// @param value The value to add.
+		void push_back(type_t &&value);
+
+		/// @brief Constructs an element in place at the end of the array, growing memory geometrically if needed.
+		/// @tparam args_t The types of the constructor arguments.
+		/// @param args The constructor arguments.
+		/// @return A reference to the new element.
+		template < typename... args_t >
+		type_t &emplace_back(args_t&&... args);
+
+		/// @brief Frees memory not occupied by elements.
+		void shrink_to_fit( void );
+
+		/// @brief Frees allocated memory and takes ownership of an existing buffer without copying it, e.g. a buffer returned by a C API.
+		/// @warning The buffer must be freeable by the array's allocator as a block of capacity elements at the alignment of the array. For buffers allocated with malloc, set an allocator whose deallocate calls free.
+		/// @param values The buffer. Elements in the range [0, size) must be constructed, while the rest may be uninitialized.
+		/// @param size The number of constructed elements in the buffer.
+		/// @param capacity The number of elements the buffer can hold. Must not be less than size.
+		void adopt(type_t *values, uint64_t size, uint64_t capacity);
+
+		/// @brief Hands ownership of the array's memory to the caller without freeing it, leaving the array empty. Query size and capacity before releasing to learn how many elements are constructed and how large the buffer is.
+		/// @note The caller is responsible for destroying the elements and freeing the memory using the array's allocator.
+		/// @return The memory, or null if the array held no memory.
+		type_t *release( void );
+
+		/// @brief Gets the allocator used to allocate and free memory for the array.
+		/// @return The allocator.
+		cc0::allocator *get_allocator( void ) const;
+
+		/// @brief Frees allocated memory and sets the allocator used to allocate and free memory for the array.
+		/// @param allocator The allocator to use. A null allocator resets the array to the default allocator.
+		void set_allocator(cc0::allocator *allocator);
+
 		/// @brief Allows direct access to the value array.
 		/// @return The pointer to the array data.
 		operator type_t*( void );
@@ -387,6 +941,22 @@ namespace cc0
 		/// @return The pointer to the array data.
 		operator const type_t*( void ) const;
 
+#if defined(CC0_ARR_CHECKED)
+		/// @brief Accesses an element, asserting that the index is within bounds. Only declared in checked mode; otherwise indexing decays to the pointer to the array data.
+		/// @tparam index_t The type of the index.
+		/// @param i The index of the element.
+		/// @return A reference to the element.
+		template < typename index_t >
+		type_t &operator[](index_t i);
+
+		/// @brief Accesses an element, asserting that the index is within bounds. Only declared in checked mode; otherwise indexing decays to the pointer to the array data.
+		/// @tparam index_t The type of the index.
+		/// @param i The index of the element.
+		/// @return A reference to the element.
+		template < typename index_t >
+		const type_t &operator[](index_t i) const;
+#endif
+
 		/// @brief Converts the array into a slice covering the full span of the array.
 		/// @tparam type2_t The other type.
 		/// @return The slice.
@@ -422,541 +992,3737 @@ namespace cc0
 		/// @brief Gets the size of the array.
 		/// @return The number of elements in the array.
 		uint64_t size( void ) const;
-	};
 
-	/// @brief Selects a part of the input array and returns a slice within the specified
-	/// @tparam type_t The type of the returned slice.
-	/// @tparam type2_t The type of the input array.
-	/// @param values The input array.
-	/// @param start The first index (inclusive) of the view into the input array.
-	/// @param end The last index (non-inclusive) of the view into the input array.
-	/// @return A slice of the input array.
-	template < typename type_t, typename type2_t >
-	cc0::slice<type_t> view(type2_t *values, uint64_t start, uint64_t end);
+		/// @brief Gets the capacity of the array.
+		/// @return The number of elements the array can hold without allocating new memory.
+		uint64_t capacity( void ) const;
+	};
 
-	/// @brief Selects a part of the input array and returns a slice within the specified
-	/// @tparam type_t The type of the returned slice.
-	/// @tparam type2_t The type of the input array.
-	/// @param values The input array.
-	/// @param start The first index (inclusive) of the view into the input array.
-	/// @param end The last index (non-inclusive) of the view into the input array.
-	/// @return A slice of the input array.
-	template < typename type_t, typename type2_t >
-	cc0::slice<const type_t> view(const type2_t *values, uint64_t start, uint64_t end);
+	/// @brief A slice whose first element is guaranteed at compile-time to be aligned to a given number of bytes, allowing kernels to skip alignment checks. Aligned slices convert implicitly to regular slices.
+	/// @tparam type_t The type of the array.
+	/// @tparam align_u The guaranteed alignment, in bytes, of the first element.
+	template < typename type_t, uint64_t align_u >
+	class aligned_slice : public cc0::slice<type_t>
+	{
+	public:
+		/// @brief Default constructor. Sets data reference to null and size to zero.
+		aligned_slice( void );
 
-	/// @brief Selects a part of the input array and returns a slice within the specified
-	/// @tparam type_t The type of the returned slice.
-	/// @tparam type2_t The type of the input array.
-	/// @param values The input array.
-	/// @param count The number of elements in the array (or part thereof).
-	/// @return A slice of the input array.
-	template < typename type_t, typename type2_t >
-	cc0::slice<type_t> view(type2_t *values, uint64_t count);
+		/// @brief Copies a reference to another aligned slice with at least the same alignment.
+		/// @tparam type2_t The other type.
+		/// @tparam align2_u The alignment of the other slice.
+		/// @param arr The slice to copy the reference of.
+		template < typename type2_t, uint64_t align2_u >
+		aligned_slice(const cc0::aligned_slice<type2_t,align2_u> &arr);
 
-	/// @brief Selects a part of the input array and returns a slice within the specified
-	/// @tparam type_t The type of the returned slice.
-	/// @tparam type2_t The type of the input array.
-	/// @param values The input array.
-	/// @param count The number of elements in the array (or part thereof).
-	/// @return A slice of the input array.
-	template < typename type_t, typename type2_t >
-	cc0::slice<const type_t> view(const type2_t *values, uint64_t count);
+		/// @brief References an array with at least the same alignment.
+		/// @tparam type2_t The other type.
+		/// @tparam size_u The size of the array.
+		/// @tparam align2_u The alignment of the array.
+		/// @param arr The array to reference.
+		template < typename type2_t, uint64_t size_u, uint64_t align2_u >
+		aligned_slice(cc0::array<type2_t,size_u,align2_u> &arr);
 
-	/// @brief Writes a given value to the entirety of the slice.
-	/// @tparam type_t 
-	/// @param dst The slice to write the value to.
-	/// @param value The value to write to the slice.
-	template < typename type_t >
-	void fill(cc0::slice<type_t> dst, const type_t &value);
-}
+		/// @brief References an array with at least the same alignment.
+		/// @tparam type2_t The other type.
+		/// @tparam size_u The size of the array.
+		/// @tparam align2_u The alignment of the array.
+		/// @param arr The array to reference.
+		template < typename type2_t, uint64_t size_u, uint64_t align2_u >
+		aligned_slice(const cc0::array<type2_t,size_u,align2_u> &arr);
+
+		/// @brief References memory that is known to be aligned.
+		/// @warning The alignment of the values is not checked. The programmer is responsible for ensuring that the values are aligned.
+		/// @tparam type2_t The other type.
+		/// @param values The array to reference.
+		/// @param size The size of the array to reference.
+		template < typename type2_t >
+		aligned_slice(type2_t *values, uint64_t size);
 
-template < typename type_t, uint64_t size_u >
-cc0::values<type_t,size_u>::operator type_t*( void )
-{
-	return v;
-}
+		/// @brief Allows direct access to the value array. Informs the compiler of the alignment where supported.
+		/// @return The pointer to the array data.
+		operator type_t*( void );
 
-template < typename type_t, uint64_t size_u >
-cc0::values<type_t,size_u>::operator const type_t*( void ) const
-{
-	return v;
-}
+		/// @brief Allows direct access to the value array. Informs the compiler of the alignment where supported.
+		/// @return The pointer to the array data.
+		operator const type_t*( void ) const;
+	};
 
-template < typename type_t >
-cc0::slice<type_t>::slice( void ) : m_values(nullptr), m_size(0)
-{}
+	/// @brief A variable-size array that stores up to a given number of elements inline, only allocating memory via its allocator when the number of elements exceeds the inline capacity. Useful for arrays that are usually small, as it avoids allocations and pointer chasing.
+	/// @tparam type_t The type of the array.
+	/// @tparam size_u The number of elements that fit in the inline storage.
+	template < typename type_t, uint64_t size_u >
+	class small_array
+	{
+		static_assert(size_u > 0, "size_u must be greater than zero");
 
-template < typename type_t >
-template < typename type2_t >
-cc0::slice<type_t>::slice(const cc0::slice<type2_t> &arr) : m_values(arr), m_size(arr.size())
-{}
+	private:
+		alignas(type_t) unsigned char  m_storage[sizeof(type_t) * size_u];
+		type_t                        *m_values;
+		uint64_t                       m_size;
+		uint64_t                       m_capacity;
+		cc0::allocator                *m_allocator;
 
-template < typename type_t >
-template < typename type2_t >
-cc0::slice<type_t>::slice(type2_t *values, uint64_t size) : m_values(values), m_size(size)
-{}
+	private:
+		/// @brief Gets the inline storage.
+		/// @return The inline storage.
+		type_t *storage( void );
 
-template < typename type_t >
-template < typename type2_t, uint64_t size_u >
-cc0::slice<type_t>::slice(type2_t (&values)[size_u]) : m_values(values), m_size(size_u)
-{}
+		/// @brief Moves the live elements into new memory and frees the old memory if it was allocated. New allocated memory is freed if moving an element throws.
+		/// @param mem The new memory. Either the inline storage or memory allocated by the array's allocator.
+		/// @param capacity The number of elements the new memory can hold. Must not be less than the size of the array.
+		void reallocate(type_t *mem, uint64_t capacity);
 
-template < typename type_t >
-template < typename type2_t >
-cc0::slice<type_t> &cc0::slice<type_t>::operator=(const cc0::slice<type2_t> &arr)
-{
-	m_values = arr.m_values;
-	m_size = arr.m_size;
-	return *this;
-}
+		/// @brief Destroys the live elements and frees the old memory if it was allocated, and switches to new memory that the live elements have been moved into.
+		/// @param mem The new memory. Either the inline storage or memory allocated by the array's allocator.
+		/// @param capacity The number of elements the new memory can hold.
+		void replace(type_t *mem, uint64_t capacity);
 
-template < typename type_t >
-template < typename type2_t, uint64_t size_u >
-cc0::slice<type_t> &cc0::slice<type_t>::operator=(type2_t (&values)[size_u])
-{
-	m_values = values;
-	m_size = size_u;
-	return *this;
-}
+		/// @brief Copies memory into the object, replacing previous contents.
+		/// @tparam type2_t The type of the memory to copy.
+		/// @param values The values to copy.
+		/// @param size The size of the array to copy.
+		template < typename type2_t >
+		void copy(const type2_t *values, uint64_t size);
 
-template < typename type_t >
-void cc0::slice<type_t>::release( void )
-{
-	m_values = nullptr;
-	m_size = 0;
-}
+		/// @brief Moves the contents of another array into the object, leaving the other array empty.
+		/// @param arr The array to move.
+		void steal(small_array &arr);
 
-template < typename type_t >
-cc0::slice<type_t>::operator type_t*( void )
-{
-	return m_values;
-}
+	public:
+		/// @brief Default constructor. Sets the size to 0.
+		small_array( void );
 
-template < typename type_t >
-cc0::slice<type_t>::operator const type_t*( void ) const
-{
-	return m_values;
-}
+		/// @brief Sets the size to 0, and specifies the allocator to use if the array outgrows its inline storage.
+		/// @param allocator The allocator to allocate and free memory with.
+		explicit small_array(cc0::allocator *allocator);
 
-template < typename type_t >
-cc0::slice<type_t> cc0::slice<type_t>::operator()(uint64_t start, uint64_t end)
-{
-	return cc0::slice<type_t>(m_values + start, (end - start));
-}
+		/// @brief Creates an array of a given size.
+		/// @param size The number of elements in the newly created array.
+		explicit small_array(uint64_t size);
 
-template < typename type_t >
-cc0::slice<const type_t> cc0::slice<type_t>::operator()(uint64_t start, uint64_t end) const
-{
-	return cc0::slice<const type_t>(m_values + start, (end - start));
-}
+		/// @brief Copies an array.
+		/// @param arr The array to copy.
+		small_array(const small_array &arr);
 
-template < typename type_t >
-uint64_t cc0::slice<type_t>::size( void ) const
-{
-	return m_size;
-}
+		/// @brief Moves data from one array to another. Elements stored inline are moved one by one.
+		/// @param arr The other array.
+		small_array(small_array &&arr);
 
-template < typename type_t >
+		/// @brief Copies a slice of an array of a potentially different type, allowing for implicit conversions e.g. int to float array or derived class pointer to base class pointer.
+		/// @tparam type2_t The other type.
+		/// @param arr The array slice to copy.
+		template < typename type2_t >
+		small_array(const cc0::slice<type2_t> &arr);
+
+		/// @brief Copies an array of a potentially different type, allowing for implicit conversions e.g. int to float array or derived class pointer to base class pointer.
+		/// @tparam type2_t The other type.
+		/// @tparam size2_u The size of the array to copy.
+		/// @param values The array to copy.
+		template < typename type2_t, uint64_t size2_u >
+		small_array(const type2_t (&values)[size2_u]);
+
+		/// @brief Frees allocated memory.
+		~small_array( void );
+
+		/// @brief Copies an array.
+		/// @param arr The array to copy.
+		/// @return A reference to the object being assigned.
+		small_array &operator=(const small_array &arr);
+
+		/// @brief Moves data from one array to another. Elements stored inline are moved one by one.
+		/// @param arr The other array.
+		/// @return A reference to the object being assigned.
+		small_array &operator=(small_array &&arr);
+
+		/// @brief Copies a slice of an array of a potentially different type, allowing for implicit conversions e.g. int to float array or derived class pointer to base class pointer.
+		/// @tparam type2_t The other type.
+		/// @param arr The array slice to copy.
+		/// @return A reference to the object being assigned.
+		template < typename type2_t >
+		small_array &operator=(const cc0::slice<type2_t> &arr);
+
+		/// @brief Sets the number of elements in the array. Contents are not preserved.
+		/// @param size The number of elements in the newly created array.
+		/// @param use_pool Determine if the array should keep allocated memory if the size is less than the capacity of the array.
+		void create(uint64_t size, bool use_pool = true);
+
+		/// @brief Destroys all elements and sets the array size to 0.
+		/// @param use_pool Keeps allocated memory rather than returning to the inline storage.
+		void destroy(bool use_pool = true);
+
+		/// @brief Ensures that the array can hold a given number of elements without allocating new memory. Elements are preserved.
+		/// @param capacity The minimum number of elements the array should be able to hold.
+		void reserve(uint64_t capacity);
+
+		/// @brief Changes the number of elements in the array. Elements are preserved up to the new size, and new elements are default-constructed.
+		/// @param size The new number of elements in the array.
+		void resize(uint64_t size);
+
+		/// @brief Adds a copy of an element to the end of the array.
+		/// @param value The value to add.
+		void push_back(const type_t &value);
+
+		/// @brief Moves an element to the end of the array.
+		/// @param value The value to add.
+		void push_back(type_t &&value);
+
+		/// @brief Constructs an element in place at the end of the array.
+		/// @tparam args_t The types of the constructor arguments.
+		/// @param args The constructor arguments.
+		/// @return A reference to the new element.
+		template < typename... args_t >
+		type_t &emplace_back(args_t&&... args);
+
+		/// @brief Frees allocated memory not occupied by elements, moving elements back into the inline storage if they fit.
+		void shrink_to_fit( void );
+
+		/// @brief Allows direct access to the value array.
+		/// @return The pointer to the array data.
+		operator type_t*( void );
+
+		/// @brief Allows direct access to the value array.
+		/// @return The pointer to the array data.
+		operator const type_t*( void ) const;
+
+#if defined(CC0_ARR_CHECKED)
+		/// @brief Accesses an element, asserting that the index is within bounds. Only declared in checked mode; otherwise indexing decays to the pointer to the array data.
+		/// @tparam index_t The type of the index.
+		/// @param i The index of the element.
+		/// @return A reference to the element.
+		template < typename index_t >
+		type_t &operator[](index_t i);
+
+		/// @brief Accesses an element, asserting that the index is within bounds. Only declared in checked mode; otherwise indexing decays to the pointer to the array data.
+		/// @tparam index_t The type of the index.
+		/// @param i The index of the element.
+		/// @return A reference to the element.
+		template < typename index_t >
+		const type_t &operator[](index_t i) const;
+#endif
+
+		/// @brief Converts the array into a slice covering the full span of the array.
+		/// @tparam type2_t The other type.
+		/// @return The slice.
+		template < typename type2_t >
+		operator cc0::slice<type2_t>( void );
+
+		/// @brief Converts the array into a slice covering the full span of the array.
+		/// @return The slice.
+		operator cc0::slice<type_t>( void );
+
+		/// @brief Converts the array into a read-only slice covering the full span of the array.
+		/// @tparam type2_t The other type.
+		/// @return The slice.
+		template < typename type2_t >
+		operator const cc0::slice<const type2_t>( void ) const;
+
+		/// @brief Converts the array into a read-only slice covering the full span of the array.
+		/// @return The slice.
+		operator const cc0::slice<const type_t>( void ) const;
+
+		/// @brief Provides a view of the array with the given index bounds.
+		/// @param start The start index of the view (inclusive).
+		/// @param end The end index of the view (non-inclusive).
+		/// @return The slice view of the array.
+		cc0::slice<type_t> operator()(uint64_t start, uint64_t end);
+
+		/// @brief Provides a view of the array with the given index bounds.
+		/// @param start The start index of the view (inclusive).
+		/// @param end The end index of the view (non-inclusive).
+		/// @return The slice view of the array.
+		cc0::slice<const type_t> operator()(uint64_t start, uint64_t end) const;
+
+		/// @brief Gets the size of the array.
+		/// @return The number of elements in the array.
+		uint64_t size( void ) const;
+
+		/// @brief Gets the capacity of the array.
+		/// @return The number of elements the array can hold without allocating new memory.
+		uint64_t capacity( void ) const;
+
+		/// @brief Determines if the elements are stored inline in the array.
+		/// @return True if no memory is allocated.
+		bool is_small( void ) const;
+	};
+
+	/// @brief A view into an existing array or slice where consecutive elements are a fixed number of elements apart, e.g. a column of a row-major matrix, or every N:th sample of a signal. Like slices, strided slices do not own the data they view.
+	/// @tparam type_t The type of the array.
+	template < typename type_t >
+	class strided_slice
+	{
+	private:
+		type_t   *m_values;
+		uint64_t  m_size;
+		uint64_t  m_stride;
+
+	public:
+		/// @brief Default constructor. Sets data reference to null and size to zero.
+		strided_slice( void );
+
+		/// @brief Views every element of a slice.
+		/// @param arr The slice to view.
+		strided_slice(cc0::slice<type_t> arr);
+
+		/// @brief Views elements a fixed number of elements apart.
+		/// @param values The first element to view.
+		/// @param size The number of elements to view.
+		/// @param stride The distance, in elements, between two consecutive elements in the view.
+		strided_slice(type_t *values, uint64_t size, uint64_t stride);
+
+		/// @brief Implicitly converts the strided slice into a read-only strided slice.
+		/// @tparam type2_t The other type.
+		/// @return The read-only strided slice.
+		template < typename type2_t >
+		operator cc0::strided_slice<const type2_t>( void ) const;
+
+		/// @brief Accesses an element in the view.
+		/// @param i The index of the element in the view.
+		/// @return A reference to the element.
+		type_t &operator[](uint64_t i);
+
+		/// @brief Accesses an element in the view.
+		/// @param i The index of the element in the view.
+		/// @return A reference to the element.
+		const type_t &operator[](uint64_t i) const;
+
+		/// @brief Provides a view of the strided slice with the given index bounds.
+		/// @param start The start index of the view (inclusive).
+		/// @param end The end index of the view (non-inclusive).
+		/// @return The strided view.
+		cc0::strided_slice<type_t> operator()(uint64_t start, uint64_t end);
+
+		/// @brief Provides a view of the strided slice with the given index bounds.
+		/// @param start The start index of the view (inclusive).
+		/// @param end The end index of the view (non-inclusive).
+		/// @return The strided view.
+		cc0::strided_slice<const type_t> operator()(uint64_t start, uint64_t end) const;
+
+		/// @brief Provides a view of every step:th element of the strided slice within the given index bounds.
+		/// @param start The start index of the view (inclusive).
+		/// @param end The end index of the view (non-inclusive).
+		/// @param step The number of elements to advance between elements in the view. Must not be zero.
+		/// @return The strided view.
+		cc0::strided_slice<type_t> operator()(uint64_t start, uint64_t end, uint64_t step);
+
+		/// @brief Provides a view of every step:th element of the strided slice within the given index bounds.
+		/// @param start The start index of the view (inclusive).
+		/// @param end The end index of the view (non-inclusive).
+		/// @param step The number of elements to advance between elements in the view. Must not be zero.
+		/// @return The strided view.
+		cc0::strided_slice<const type_t> operator()(uint64_t start, uint64_t end, uint64_t step) const;
+
+		/// @brief Determines if the elements in the view are adjacent in memory.
+		/// @return True if the stride is 1, or the view holds fewer than two elements.
+		bool is_contiguous( void ) const;
+
+		/// @brief Converts a contiguous view into a slice.
+		/// @warning The view must be contiguous.
+		/// @return The slice.
+		cc0::slice<type_t> contiguous( void );
+
+		/// @brief Converts a contiguous view into a slice.
+		/// @warning The view must be contiguous.
+		/// @return The slice.
+		cc0::slice<const type_t> contiguous( void ) const;
+
+		/// @brief Gets the size of the view.
+		/// @return The number of elements in the view.
+		uint64_t size( void ) const;
+
+		/// @brief Gets the stride of the view.
+		/// @return The distance, in elements, between two consecutive elements in the view.
+		uint64_t stride( void ) const;
+	};
+
+	/// @brief A multi-dimensional view into an existing array or slice, e.g. an image or a volume, or a sub-block thereof. The view is defined by a shape, i.e. the number of elements along each dimension, and strides, i.e. the distance in elements between consecutive elements along each dimension. In a dense row-major layout the last dimension varies fastest. Like slices, views do not own the data they view.
+	/// @tparam type_t The type of the array.
+	/// @tparam dims_u The number of dimensions.
+	template < typename type_t, uint64_t dims_u >
+	class ndview
+	{
+		static_assert(dims_u > 0, "The number of dimensions must be greater than zero.");
+
+		template < typename, uint64_t > friend class ndview;
+
+	private:
+		type_t   *m_values;
+		uint64_t  m_shape[dims_u];
+		uint64_t  m_strides[dims_u];
+
+	private:
+		/// @brief Computes the offset of an element.
+		/// @param index The index of the element along each dimension.
+		/// @return The offset, in elements, from the first element in the view.
+		uint64_t offset(const uint64_t (&index)[dims_u]) const;
+
+	public:
+		/// @brief Default constructor. Sets data reference to null and shape to zero.
+		ndview( void );
+
+		/// @brief Views a slice as a dense row-major array of a given shape.
+		/// @param arr The slice to view. Must hold at least as many elements as the product of the shape.
+		/// @param shape The number of elements along each dimension.
+		ndview(cc0::slice<type_t> arr, const uint64_t (&shape)[dims_u]);
+
+		/// @brief Views memory with a given shape and strides.
+		/// @param values The first element to view.
+		/// @param shape The number of elements along each dimension.
+		/// @param strides The distance, in elements, between consecutive elements along each dimension.
+		ndview(type_t *values, const uint64_t (&shape)[dims_u], const uint64_t (&strides)[dims_u]);
+
+		/// @brief Implicitly converts the view into a read-only view.
+		/// @tparam type2_t The other type.
+		/// @return The read-only view.
+		template < typename type2_t >
+		operator cc0::ndview<const type2_t,dims_u>( void ) const;
+
+		/// @brief Accesses an element in the view.
+		/// @tparam index_t The types of the indices.
+		/// @param index The index of the element along each dimension.
+		/// @return A reference to the element.
+		template < typename... index_t >
+		type_t &at(index_t... index);
+
+		/// @brief Accesses an element in the view.
+		/// @tparam index_t The types of the indices.
+		/// @param index The index of the element along each dimension.
+		/// @return A reference to the element.
+		template < typename... index_t >
+		const type_t &at(index_t... index) const;
+
+		/// @brief Provides a view of a sub-block of the view with the given index bounds.
+		/// @param start The start index along each dimension (inclusive).
+		/// @param end The end index along each dimension (non-inclusive).
+		/// @return The view of the sub-block.
+		cc0::ndview<type_t,dims_u> operator()(const uint64_t (&start)[dims_u], const uint64_t (&end)[dims_u]);
+
+		/// @brief Provides a view of a sub-block of the view with the given index bounds.
+		/// @param start The start index along each dimension (inclusive).
+		/// @param end The end index along each dimension (non-inclusive).
+		/// @return The view of the sub-block.
+		cc0::ndview<const type_t,dims_u> operator()(const uint64_t (&start)[dims_u], const uint64_t (&end)[dims_u]) const;
+
+		/// @brief Provides a view of all elements along one dimension, e.g. a row or a column of a matrix.
+		/// @param dim The dimension to view along.
+		/// @param index The index of an element on the line along each dimension. The index along the viewed dimension is ignored.
+		/// @return The strided view.
+		cc0::strided_slice<type_t> line(uint64_t dim, const uint64_t (&index)[dims_u]);
+
+		/// @brief Provides a view of all elements along one dimension, e.g. a row or a column of a matrix.
+		/// @param dim The dimension to view along.
+		/// @param index The index of an element on the line along each dimension. The index along the viewed dimension is ignored.
+		/// @return The strided view.
+		cc0::strided_slice<const type_t> line(uint64_t dim, const uint64_t (&index)[dims_u]) const;
+
+		/// @brief Determines if the elements in the view are dense and adjacent in memory in row-major order.
+		/// @return True if the view is contiguous.
+		bool is_contiguous( void ) const;
+
+		/// @brief Gets the number of elements along a dimension.
+		/// @param dim The dimension.
+		/// @return The number of elements.
+		uint64_t shape(uint64_t dim) const;
+
+		/// @brief Gets the stride along a dimension.
+		/// @param dim The dimension.
+		/// @return The distance, in elements, between consecutive elements along the dimension.
+		uint64_t stride(uint64_t dim) const;
+
+		/// @brief Gets the size of the view.
+		/// @return The total number of elements in the view.
+		uint64_t size( void ) const;
+	};
+
+	/// @brief Selects a part of the input array and returns a slice within the specified
+	/// @tparam type_t The type of the returned slice.
+	/// @tparam type2_t The type of the input array.
+	/// @param values The input array.
+	/// @param start The first index (inclusive) of the view into the input array.
+	/// @param end The last index (non-inclusive) of the view into the input array.
+	/// @return A slice of the input array.
+	template < typename type_t, typename type2_t >
+	cc0::slice<type_t> view(type2_t *values, uint64_t start, uint64_t end);
+
+	/// @brief Selects a part of the input array and returns a slice within the specified
+	/// @tparam type_t The type of the returned slice.
+	/// @tparam type2_t The type of the input array.
+	/// @param values The input array.
+	/// @param start The first index (inclusive) of the view into the input array.
+	/// @param end The last index (non-inclusive) of the view into the input array.
+	/// @return A slice of the input array.
+	template < typename type_t, typename type2_t >
+	cc0::slice<const type_t> view(const type2_t *values, uint64_t start, uint64_t end);
+
+	/// @brief Selects a part of the input array and returns a slice within the specified
+	/// @tparam type_t The type of the returned slice.
+	/// @tparam type2_t The type of the input array.
+	/// @param values The input array.
+	/// @param count The number of elements in the array (or part thereof).
+	/// @return A slice of the input array.
+	template < typename type_t, typename type2_t >
+	cc0::slice<type_t> view(type2_t *values, uint64_t count);
+
+	/// @brief Selects a part of the input array and returns a slice within the specified
+	/// @tparam type_t The type of the returned slice.
+	/// @tparam type2_t The type of the input array.
+	/// @param values The input array.
+	/// @param count The number of elements in the array (or part thereof).
+	/// @return A slice of the input array.
+	template < typename type_t, typename type2_t >
+	cc0::slice<const type_t> view(const type2_t *values, uint64_t count);
+
+	/// @brief Compares two fixed-size arrays element by element. Expanded at compile time for small arrays, and usable in constant expressions.
+	/// @tparam type_t The type of the first array.
+	/// @tparam type2_t The type of the second array.
+	/// @tparam size_u The number of elements in the arrays.
+	/// @tparam align_u The alignment of the first array.
+	/// @tparam align2_u The alignment of the second array.
+	/// @param a The first array.
+	/// @param b The second array.
+	/// @return True if all elements compare equal.
+	template < typename type_t, typename type2_t, uint64_t size_u, uint64_t align_u, uint64_t align2_u >
+	constexpr typename cc0::internal::if_fixed<bool,size_u>::type operator==(const cc0::array<type_t,size_u,align_u> &a, const cc0::array<type2_t,size_u,align2_u> &b);
+
+	/// @brief Compares two fixed-size arrays element by element. Expanded at compile time for small arrays, and usable in constant expressions.
+	/// @tparam type_t The type of the first array.
+	/// @tparam type2_t The type of the second array.
+	/// @tparam size_u The number of elements in the arrays.
+	/// @tparam align_u The alignment of the first array.
+	/// @tparam align2_u The alignment of the second array.
+	/// @param a The first array.
+	/// @param b The second array.
+	/// @return True if any elements compare unequal.
+	template < typename type_t, typename type2_t, uint64_t size_u, uint64_t align_u, uint64_t align2_u >
+	constexpr typename cc0::internal::if_fixed<bool,size_u>::type operator!=(const cc0::array<type_t,size_u,align_u> &a, const cc0::array<type2_t,size_u,align2_u> &b);
+
+	/// @brief Compares two value arrays element by element. Usable in constant expressions.
+	/// @tparam type_t The type of the first value array.
+	/// @tparam type2_t The type of the second value array.
+	/// @tparam size_u The number of elements in the value arrays.
+	/// @param a The first value array.
+	/// @param b The second value array.
+	/// @return True if all elements compare equal.
+	template < typename type_t, typename type2_t, uint64_t size_u >
+	constexpr bool operator==(const cc0::values<type_t,size_u> &a, const cc0::values<type2_t,size_u> &b);
+
+	/// @brief Compares two value arrays element by element. Usable in constant expressions.
+	/// @tparam type_t The type of the first value array.
+	/// @tparam type2_t The type of the second value array.
+	/// @tparam size_u The number of elements in the value arrays.
+	/// @param a The first value array.
+	/// @param b The second value array.
+	/// @return True if any elements compare unequal.
+	template < typename type_t, typename type2_t, uint64_t size_u >
+	constexpr bool operator!=(const cc0::values<type_t,size_u> &a, const cc0::values<type2_t,size_u> &b);
+
+	/// @brief Adds two fixed-size arrays element-wise. Expanded at compile time for small arrays, and usable in constant expressions.
+	/// @note Adding or subtracting a scalar is deliberately not provided, as it would change the meaning of pointer arithmetic on arrays.
+	/// @tparam type_t The type of the arrays.
+	/// @tparam size_u The number of elements in the arrays.
+	/// @tparam align_u The alignment of the arrays.
+	/// @param a The first array.
+	/// @param b The second array.
+	/// @return The element-wise sum.
+	template < typename type_t, uint64_t size_u, uint64_t align_u >
+	constexpr typename cc0::internal::if_fixed<cc0::array<type_t,size_u,align_u>,size_u>::type operator+(const cc0::array<type_t,size_u,align_u> &a, const cc0::array<type_t,size_u,align_u> &b);
+
+	/// @brief Subtracts two fixed-size arrays element-wise. Expanded at compile time for small arrays, and usable in constant expressions.
+	/// @tparam type_t The type of the arrays.
+	/// @tparam size_u The number of elements in the arrays.
+	/// @tparam align_u The alignment of the arrays.
+	/// @param a The first array.
+	/// @param b The second array.
+	/// @return The element-wise difference.
+	template < typename type_t, uint64_t size_u, uint64_t align_u >
+	constexpr typename cc0::internal::if_fixed<cc0::array<type_t,size_u,align_u>,size_u>::type operator-(const cc0::array<type_t,size_u,align_u> &a, const cc0::array<type_t,size_u,align_u> &b);
+
+	/// @brief Multiplies two fixed-size arrays element-wise. Expanded at compile time for small arrays, and usable in constant expressions.
+	/// @tparam type_t The type of the arrays.
+	/// @tparam size_u The number of elements in the arrays.
+	/// @tparam align_u The alignment of the arrays.
+	/// @param a The first array.
+	/// @param b The second array.
+	/// @return The element-wise product.
+	template < typename type_t, uint64_t size_u, uint64_t align_u >
+	constexpr typename cc0::internal::if_fixed<cc0::array<type_t,size_u,align_u>,size_u>::type operator*(const cc0::array<type_t,size_u,align_u> &a, const cc0::array<type_t,size_u,align_u> &b);
+
+	/// @brief Divides two fixed-size arrays element-wise. Expanded at compile time for small arrays, and usable in constant expressions.
+	/// @tparam type_t The type of the arrays.
+	/// @tparam size_u The number of elements in the arrays.
+	/// @tparam align_u The alignment of the arrays.
+	/// @param a The first array.
+	/// @param b The second array.
+	/// @return The element-wise quotient.
+	template < typename type_t, uint64_t size_u, uint64_t align_u >
+	constexpr typename cc0::internal::if_fixed<cc0::array<type_t,size_u,align_u>,size_u>::type operator/(const cc0::array<type_t,size_u,align_u> &a, const cc0::array<type_t,size_u,align_u> &b);
+
+	/// @brief Multiplies each element of a fixed-size array by a scalar. Expanded at compile time for small arrays, and usable in constant expressions.
+	/// @tparam type_t The type of the array.
+	/// @tparam size_u The number of elements in the array.
+	/// @tparam align_u The alignment of the array.
+	/// @param a The array.
+	/// @param s The scalar.
+	/// @return The scaled array.
+	template < typename type_t, uint64_t size_u, uint64_t align_u >
+	constexpr typename cc0::internal::if_fixed<cc0::array<type_t,size_u,align_u>,size_u>::type operator*(const cc0::array<type_t,size_u,align_u> &a, const typename std::remove_cv<type_t>::type &s);
+
+	/// @brief Multiplies each element of a fixed-size array by a scalar. Expanded at compile time for small arrays, and usable in constant expressions.
+	/// @tparam type_t The type of the array.
+	/// @tparam size_u The number of elements in the array.
+	/// @tparam align_u The alignment of the array.
+	/// @param s The scalar.
+	/// @param a The array.
+	/// @return The scaled array.
+	template < typename type_t, uint64_t size_u, uint64_t align_u >
+	constexpr typename cc0::internal::if_fixed<cc0::array<type_t,size_u,align_u>,size_u>::type operator*(const typename std::remove_cv<type_t>::type &s, const cc0::array<type_t,size_u,align_u> &a);
+
+	/// @brief Divides each element of a fixed-size array by a scalar. Expanded at compile time for small arrays, and usable in constant expressions.
+	/// @tparam type_t The type of the array.
+	/// @tparam size_u The number of elements in the array.
+	/// @tparam align_u The alignment of the array.
+	/// @param a The array.
+	/// @param s The scalar.
+	/// @return The scaled array.
+	template < typename type_t, uint64_t size_u, uint64_t align_u >
+	constexpr typename cc0::internal::if_fixed<cc0::array<type_t,size_u,align_u>,size_u>::type operator/(const cc0::array<type_t,size_u,align_u> &a, const typename std::remove_cv<type_t>::type &s);
+
+	/// @brief Negates each element of a fixed-size array. Expanded at compile time for small arrays, and usable in constant expressions.
+	/// @tparam type_t The type of the array.
+	/// @tparam size_u The number of elements in the array.
+	/// @tparam align_u The alignment of the array.
+	/// @param a The array.
+	/// @return The negated array.
+	template < typename type_t, uint64_t size_u, uint64_t align_u >
+	constexpr typename cc0::internal::if_fixed<cc0::array<type_t,size_u,align_u>,size_u>::type operator-(const cc0::array<type_t,size_u,align_u> &a);
+
+	/// @brief Adds a fixed-size array to another element-wise.
+	/// @tparam type_t The type of the arrays.
+	/// @tparam size_u The number of elements in the arrays.
+	/// @tparam align_u The alignment of the arrays.
+	/// @param a The array to add to.
+	/// @param b The array to add.
+	/// @return A reference to the array added to.
+	template < typename type_t, uint64_t size_u, uint64_t align_u >
+	typename cc0::internal::if_fixed<cc0::array<type_t,size_u,align_u>,size_u>::type &operator+=(cc0::array<type_t,size_u,align_u> &a, const cc0::array<type_t,size_u,align_u> &b);
+
+	/// @brief Subtracts a fixed-size array from another element-wise.
+	/// @tparam type_t The type of the arrays.
+	/// @tparam size_u The number of elements in the arrays.
+	/// @tparam align_u The alignment of the arrays.
+	/// @param a The array to subtract from.
+	/// @param b The array to subtract.
+	/// @return A reference to the array subtracted from.
+	template < typename type_t, uint64_t size_u, uint64_t align_u >
+	typename cc0::internal::if_fixed<cc0::array<type_t,size_u,align_u>,size_u>::type &operator-=(cc0::array<type_t,size_u,align_u> &a, const cc0::array<type_t,size_u,align_u> &b);
+
+	/// @brief Multiplies a fixed-size array by another element-wise.
+	/// @tparam type_t The type of the arrays.
+	/// @tparam size_u The number of elements in the arrays.
+	/// @tparam align_u The alignment of the arrays.
+	/// @param a The array to multiply.
+	/// @param b The array to multiply by.
+	/// @return A reference to the multiplied array.
+	template < typename type_t, uint64_t size_u, uint64_t align_u >
+	typename cc0::internal::if_fixed<cc0::array<type_t,size_u,align_u>,size_u>::type &operator*=(cc0::array<type_t,size_u,align_u> &a, const cc0::array<type_t,size_u,align_u> &b);
+
+	/// @brief Divides a fixed-size array by another element-wise.
+	/// @tparam type_t The type of the arrays.
+	/// @tparam size_u The number of elements in the arrays.
+	/// @tparam align_u The alignment of the arrays.
+	/// @param a The array to divide.
+	/// @param b The array to divide by.
+	/// @return A reference to the divided array.
+	template < typename type_t, uint64_t size_u, uint64_t align_u >
+	typename cc0::internal::if_fixed<cc0::array<type_t,size_u,align_u>,size_u>::type &operator/=(cc0::array<type_t,size_u,align_u> &a, const cc0::array<type_t,size_u,align_u> &b);
+
+	/// @brief Multiplies each element of a fixed-size array by a scalar.
+	/// @tparam type_t The type of the array.
+	/// @tparam size_u The number of elements in the array.
+	/// @tparam align_u The alignment of the array.
+	/// @param a The array to multiply.
+	/// @param s The scalar.
+	/// @return A reference to the multiplied array.
+	template < typename type_t, uint64_t size_u, uint64_t align_u >
+	typename cc0::internal::if_fixed<cc0::array<type_t,size_u,align_u>,size_u>::type &operator*=(cc0::array<type_t,size_u,align_u> &a, const typename std::remove_cv<type_t>::type &s);
+
+	/// @brief Divides each element of a fixed-size array by a scalar.
+	/// @tparam type_t The type of the array.
+	/// @tparam size_u The number of elements in the array.
+	/// @tparam align_u The alignment of the array.
+	/// @param a The array to divide.
+	/// @param s The scalar.
+	/// @return A reference to the divided array.
+	template < typename type_t, uint64_t size_u, uint64_t align_u >
+	typename cc0::internal::if_fixed<cc0::array<type_t,size_u,align_u>,size_u>::type &operator/=(cc0::array<type_t,size_u,align_u> &a, const typename std::remove_cv<type_t>::type &s);
+
+	/// @brief Computes the dot product of two fixed-size arrays. Expanded at compile time for small arrays, and usable in constant expressions.
+	/// @tparam type_t The type of the arrays.
+	/// @tparam size_u The number of elements in the arrays.
+	/// @tparam align_u The alignment of the first array.
+	/// @tparam align2_u The alignment of the second array.
+	/// @param a The first array.
+	/// @param b The second array.
+	/// @return The sum of the element-wise products.
+	template < typename type_t, uint64_t size_u, uint64_t align_u, uint64_t align2_u >
+	constexpr typename cc0::internal::if_fixed<typename std::remove_cv<type_t>::type,size_u>::type dot(const cc0::array<type_t,size_u,align_u> &a, const cc0::array<type_t,size_u,align2_u> &b);
+
+	/// @brief Writes a given value to the entirety of the slice. Reduces to a memset for byte-sized or zero-valued trivially copyable types, and to vectorized stores for other trivially copyable types where supported.
+	/// @tparam type_t The type of the slice.
+	/// @param dst The slice to write the value to.
+	/// @param value The value to write to the slice.
+	template < typename type_t >
+	void fill(cc0::slice<type_t> dst, const type_t &value);
+
+	/// @brief Copies elements from one slice to another, converting elements to the destination type where needed. Reduces to a memmove for trivially copyable elements of identical type.
+	/// @note Overlapping slices are only supported for trivially copyable elements of identical type.
+	/// @tparam type_t The type of the destination slice.
+	/// @tparam type2_t The type of the source slice.
+	/// @param dst The slice to copy to.
+	/// @param src The slice to copy from.
+	/// @return The number of elements copied, i.e. the smaller of the sizes of the slices.
+	template < typename type_t, typename type2_t >
+	uint64_t copy(cc0::slice<type_t> dst, cc0::slice<type2_t> src);
+
+	/// @brief Moves elements from one slice to another, leaving the source elements in a moved-from state. Reduces to a memmove for trivially copyable elements.
+	/// @note Overlapping slices are only supported for trivially copyable elements.
+	/// @tparam type_t The type of the destination slice.
+	/// @tparam type2_t The type of the source slice.
+	/// @param dst The slice to move to.
+	/// @param src The slice to move from.
+	/// @return The number of elements moved, i.e. the smaller of the sizes of the slices.
+	template < typename type_t, typename type2_t >
+	uint64_t move(cc0::slice<type_t> dst, cc0::slice<type2_t> src);
+
+	/// @brief Compares two slices element by element. Reduces to a memcmp for integral, enumeration and pointer elements of identical type.
+	/// @tparam type_t The type of the first slice.
+	/// @tparam type2_t The type of the second slice.
+	/// @param a The first slice.
+	/// @param b The second slice.
+	/// @return True if the slices are of equal size and all elements compare equal.
+	template < typename type_t, typename type2_t >
+	bool equal(cc0::slice<type_t> a, cc0::slice<type2_t> b);
+
+	/// @brief Finds the first occurrence of a value in a slice.
+	/// @tparam type_t The type of the slice.
+	/// @param arr The slice to search.
+	/// @param value The value to search for.
+	/// @return The index of the first element equal to the value, or the size of the slice if no element is equal to the value.
+	template < typename type_t >
+	uint64_t find(cc0::slice<type_t> arr, const typename std::remove_cv<type_t>::type &value);
+
+	/// @brief Counts the occurrences of a value in a slice.
+	/// @tparam type_t The type of the slice.
+	/// @param arr The slice to search.
+	/// @param value The value to count.
+	/// @return The number of elements equal to the value.
+	template < typename type_t >
+	uint64_t count(cc0::slice<type_t> arr, const typename std::remove_cv<type_t>::type &value);
+
+	/// @brief Finds the smallest value in a slice.
+	/// @warning The slice must not be empty. The result is unspecified if the slice contains values that are unordered, e.g. NaN.
+	/// @tparam type_t The type of the slice.
+	/// @param arr The slice to search.
+	/// @return The smallest value.
+	template < typename type_t >
+	typename std::remove_cv<type_t>::type min(cc0::slice<type_t> arr);
+
+	/// @brief Finds the largest value in a slice.
+	/// @warning The slice must not be empty. The result is unspecified if the slice contains values that are unordered, e.g. NaN.
+	/// @tparam type_t The type of the slice.
+	/// @param arr The slice to search.
+	/// @return The largest value.
+	template < typename type_t >
+	typename std::remove_cv<type_t>::type max(cc0::slice<type_t> arr);
+
+	/// @brief Sums the values in a slice.
+	/// @note The order in which values are added is unspecified, which may affect the rounding of floating-point sums.
+	/// @tparam type_t The type of the slice.
+	/// @param arr The slice to sum.
+	/// @return The sum of the values, or a value-initialized value if the slice is empty.
+	template < typename type_t >
+	typename std::remove_cv<type_t>::type sum(cc0::slice<type_t> arr);
+
+	/// @brief Provides a strided view of every step:th element of a slice.
+	/// @tparam type_t The type of the slice.
+	/// @param arr The slice.
+	/// @param step The number of elements to advance between elements in the view. Must not be zero.
+	/// @return The strided view.
+	template < typename type_t >
+	cc0::strided_slice<type_t> stride(cc0::slice<type_t> arr, uint64_t step);
+
+	/// @brief Writes a given value to every element of a strided slice. Reduces to the contiguous fill if the view is contiguous.
+	/// @tparam type_t The type of the strided slice.
+	/// @param dst The strided slice to write the value to.
+	/// @param value The value to write.
+	template < typename type_t >
+	void fill(cc0::strided_slice<type_t> dst, const type_t &value);
+
+	/// @brief Copies elements from one strided slice to another, converting elements to the destination type where needed. Reduces to the contiguous copy if both views are contiguous.
+	/// @tparam type_t The type of the destination.
+	/// @tparam type2_t The type of the source.
+	/// @param dst The strided slice to copy to.
+	/// @param src The strided slice to copy from.
+	/// @return The number of elements copied, i.e. the smaller of the sizes of the strided slices.
+	template < typename type_t, typename type2_t >
+	uint64_t copy(cc0::strided_slice<type_t> dst, cc0::strided_slice<type2_t> src);
+
+	/// @brief Writes a given value to every element of a multi-dimensional view. Each line along the last dimension is written using the strided fill.
+	/// @tparam type_t The type of the view.
+	/// @tparam dims_u The number of dimensions.
+	/// @param dst The view to write the value to.
+	/// @param value The value to write.
+	template < typename type_t, uint64_t dims_u >
+	void fill(cc0::ndview<type_t,dims_u> dst, const type_t &value);
+
+	/// @brief Copies elements from one multi-dimensional view to another, converting elements to the destination type where needed. Only the region that exists in both views is copied. Each line along the last dimension is copied using the strided copy.
+	/// @tparam type_t The type of the destination.
+	/// @tparam type2_t The type of the source.
+	/// @tparam dims_u The number of dimensions.
+	/// @param dst The view to copy to.
+	/// @param src The view to copy from.
+	/// @return The number of elements copied.
+	template < typename type_t, typename type2_t, uint64_t dims_u >
+	uint64_t copy(cc0::ndview<type_t,dims_u> dst, cc0::ndview<type2_t,dims_u> src);
+}
+
+inline cc0::allocator::~allocator( void )
+{}
+
+inline void *cc0::heap_allocator::allocate(uint64_t size, uint64_t align)
+{
+	if (align <= alignof(std::max_align_t)) {
+		return ::operator new(size);
+	}
+	// Over-allocate, and store the address of the actual allocation right before the aligned memory.
+	void *mem = ::operator new(size + align + sizeof(void*));
+	const uintptr_t addr = (reinterpret_cast<uintptr_t>(mem) + sizeof(void*) + align - 1) & ~uintptr_t(align - 1);
+	reinterpret_cast<void**>(addr)[-1] = mem;
+	return reinterpret_cast<void*>(addr);
+}
+
+inline void cc0::heap_allocator::deallocate(void *mem, uint64_t, uint64_t align)
+{
+	if (align <= alignof(std::max_align_t)) {
+		::operator delete(mem);
+	} else {
+		::operator delete(static_cast<void**>(mem)[-1]);
+	}
+}
+
+inline cc0::allocator *cc0::internal::heap( void )
+{
+	static cc0::heap_allocator a;
+	return &a;
+}
+
+inline cc0::allocator *&cc0::internal::default_allocator( void )
+{
+	static cc0::allocator *a = cc0::internal::heap();
+	return a;
+}
+
+inline cc0::allocator *cc0::default_allocator( void )
+{
+	return cc0::internal::default_allocator();
+}
+
+inline void cc0::set_default_allocator(cc0::allocator *allocator)
+{
+	cc0::internal::default_allocator() = allocator != nullptr ? allocator : cc0::internal::heap();
+}
+
+inline void *cc0::internal::allocate(cc0::allocator *allocator, uint64_t size, uint64_t align)
+{
+	void *mem = allocator->allocate(size, align);
+	CC0_ARR_INSTRUMENT_EVENT(instrument_allocate, mem, size);
+	return mem;
+}
+
+inline void cc0::internal::deallocate(cc0::allocator *allocator, void *mem, uint64_t size, uint64_t align)
+{
+	CC0_ARR_INSTRUMENT_EVENT(instrument_deallocate, mem, size);
+	allocator->deallocate(mem, size, align);
+}
+
+template < typename type_t >
+uint64_t cc0::internal::array_bytes(uint64_t count)
+{
+	if (count > ~uint64_t(0) / sizeof(type_t)) {
+		throw std::bad_alloc();
+	}
+	return count * sizeof(type_t);
+}
+
+inline cc0::internal::allocation_guard::~allocation_guard( void )
+{
+	if (mem != nullptr) {
+		cc0::internal::deallocate(allocator, mem, size, align);
+	}
+}
+
+inline void cc0::internal::allocation_guard::release( void )
+{
+	mem = nullptr;
+}
+
+template < typename type_t >
+cc0::internal::construct_guard<type_t>::~construct_guard( void )
+{
+	cc0::internal::destruct(dst, count);
+}
+
+#if defined(CC0_ARR_INSTRUMENT)
+inline cc0::internal::instrument_state &cc0::internal::instrumentation( void )
+{
+	static cc0::internal::instrument_state state = {};
+	return state;
+}
+
+inline void cc0::internal::instrument(cc0::instrument_event event, const void *mem, uint64_t bytes)
+{
+	cc0::internal::instrument_state &state = cc0::internal::instrumentation();
+	state.counts[event].fetch_add(1, std::memory_order_relaxed);
+	state.bytes[event].fetch_add(bytes, std::memory_order_relaxed);
+	if (state.callback != nullptr) {
+		state.callback(event, mem, bytes, state.user);
+	}
+}
+
+inline cc0::instrument_statistics cc0::get_instrument_statistics( void )
+{
+	cc0::internal::instrument_state &state = cc0::internal::instrumentation();
+	cc0::instrument_statistics stats;
+	stats.allocations       = state.counts[cc0::instrument_allocate].load(std::memory_order_relaxed);
+	stats.deallocations     = state.counts[cc0::instrument_deallocate].load(std::memory_order_relaxed);
+	stats.pool_reuses       = state.counts[cc0::instrument_pool_reuse].load(std::memory_order_relaxed);
+	stats.deep_copies       = state.counts[cc0::instrument_deep_copy].load(std::memory_order_relaxed);
+	stats.bytes_allocated   = state.bytes[cc0::instrument_allocate].load(std::memory_order_relaxed);
+	stats.bytes_deallocated = state.bytes[cc0::instrument_deallocate].load(std::memory_order_relaxed);
+	stats.bytes_reused      = state.bytes[cc0::instrument_pool_reuse].load(std::memory_order_relaxed);
+	stats.bytes_copied      = state.bytes[cc0::instrument_deep_copy].load(std::memory_order_relaxed);
+	return stats;
+}
+
+inline void cc0::reset_instrument_statistics( void )
+{
+	cc0::internal::instrument_state &state = cc0::internal::instrumentation();
+	for (uint64_t i = 0; i < cc0::instrument_event_count; ++i) {
+		state.counts[i].store(0, std::memory_order_relaxed);
+		state.bytes[i].store(0, std::memory_order_relaxed);
+	}
+}
+
+inline void cc0::set_instrument_callback(cc0::instrument_callback callback, void *user)
+{
+	cc0::internal::instrument_state &state = cc0::internal::instrumentation();
+	state.callback = callback;
+	state.user = user;
+}
+#endif
+
+namespace cc0
+{
+	namespace internal
+	{
+		template < typename type_t >
+		void construct(type_t*, uint64_t, std::true_type)
+		{}
+
+		template < typename type_t >
+		void construct(type_t *dst, uint64_t count, std::false_type)
+		{
+			cc0::internal::construct_guard<type_t> guard = { dst, 0 };
+			for (; guard.count < count; ++guard.count) {
+				new (dst + guard.count) type_t;
+			}
+			guard.count = 0;
+		}
+
+		template < typename type_t >
+		void destruct(type_t*, uint64_t, std::true_type)
+		{}
+
+		template < typename type_t >
+		void destruct(type_t *dst, uint64_t count, std::false_type)
+		{
+			for (uint64_t i = 0; i < count; ++i) {
+				dst[i].~type_t();
+			}
+		}
+
+		template < typename type_t, typename type2_t >
+		void copy_construct(type_t *dst, const type2_t *src, uint64_t count, std::true_type)
+		{
+			if (count > 0) {
+				memcpy(dst, src, count * sizeof(type_t));
+			}
+		}
+
+		template < typename type_t, typename type2_t >
+		void copy_construct(type_t *dst, const type2_t *src, uint64_t count, std::false_type)
+		{
+			cc0::internal::construct_guard<type_t> guard = { dst, 0 };
+			for (; guard.count < count; ++guard.count) {
+				new (dst + guard.count) type_t(src[guard.count]);
+			}
+			guard.count = 0;
+		}
+
+		template < typename type_t, typename type2_t >
+		void copy_assign(type_t *dst, const type2_t *src, uint64_t count, std::true_type)
+		{
+			if (count > 0) {
+				memmove(dst, src, count * sizeof(type_t));
+			}
+		}
+
+		template < typename type_t, typename type2_t >
+		void copy_assign(type_t *dst, const type2_t *src, uint64_t count, std::false_type)
+		{
+			for (uint64_t i = 0; i < count; ++i) {
+				dst[i] = src[i];
+			}
+		}
+
+		template < typename type_t, typename type2_t >
+		void move_construct(type_t *dst, type2_t *src, uint64_t count, std::true_type)
+		{
+			if (count > 0) {
+				memcpy(dst, src, count * sizeof(type_t));
+			}
+		}
+
+		template < typename type_t, typename type2_t >
+		void move_construct(type_t *dst, type2_t *src, uint64_t count, std::false_type)
+		{
+			cc0::internal::construct_guard<type_t> guard = { dst, 0 };
+			for (; guard.count < count; ++guard.count) {
+				new (dst + guard.count) type_t(std::move(src[guard.count]));
+			}
+			guard.count = 0;
+		}
+
+		template < typename type_t, typename type2_t >
+		void move_assign(type_t *dst, type2_t *src, uint64_t count, std::true_type)
+		{
+			if (count > 0) {
+				memmove(dst, src, count * sizeof(type_t));
+			}
+		}
+
+		template < typename type_t, typename type2_t >
+		void move_assign(type_t *dst, type2_t *src, uint64_t count, std::false_type)
+		{
+			for (uint64_t i = 0; i < count; ++i) {
+				dst[i] = std::move(src[i]);
+			}
+		}
+
+		/// @brief Operations on a range of elements of fixed-size arrays, recursively split in halves at compile time so that the operations are fully expanded, yet only nest logarithmically deep in constant expressions.
+		template < uint64_t start_u, uint64_t count_u >
+		struct unroll
+		{
+			template < typename type_t, typename type2_t >
+			static constexpr bool equal(const type_t *a, const type2_t *b)
+			{
+				return unroll<start_u, count_u / 2>::equal(a, b) && unroll<start_u + count_u / 2, count_u - count_u / 2>::equal(a, b);
+			}
+
+			template < typename type_t >
+			static constexpr type_t dot(const type_t *a, const type_t *b)
+			{
+				return unroll<start_u, count_u / 2>::dot(a, b) + unroll<start_u + count_u / 2, count_u - count_u / 2>::dot(a, b);
+			}
+		};
+
+		template < uint64_t start_u >
+		struct unroll<start_u,1>
+		{
+			template < typename type_t, typename type2_t >
+			static constexpr bool equal(const type_t *a, const type2_t *b)
+			{
+				return a[start_u] == b[start_u];
+			}
+
+			template < typename type_t >
+			static constexpr type_t dot(const type_t *a, const type_t *b)
+			{
+				return a[start_u] * b[start_u];
+			}
+		};
+
+		template < typename type_t, typename type2_t, uint64_t... i_u >
+		constexpr bool fixed_equal(const type_t *a, const type2_t *b, uint64_t, index_list<i_u...>)
+		{
+			return unroll<0, sizeof...(i_u)>::equal(a, b);
+		}
+
+		template < typename type_t, typename type2_t >
+		bool fixed_equal(const type_t *a, const type2_t *b, uint64_t count, loop_tag)
+		{
+			for (uint64_t i = 0; i < count; ++i) {
+				if (!(a[i] == b[i])) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+		template < typename type_t, uint64_t... i_u >
+		constexpr type_t fixed_dot(const type_t *a, const type_t *b, uint64_t, index_list<i_u...>)
+		{
+			return unroll<0, sizeof...(i_u)>::dot(a, b);
+		}
+
+		template < typename type_t >
+		type_t fixed_dot(const type_t *a, const type_t *b, uint64_t count, loop_tag)
+		{
+			type_t d = type_t();
+			for (uint64_t i = 0; i < count; ++i) {
+				d += a[i] * b[i];
+			}
+			return d;
+		}
+
+		struct add_op
+		{
+			template < typename type_t >
+			static constexpr type_t apply(const type_t &a, const type_t &b) { return a + b; }
+		};
+
+		struct sub_op
+		{
+			template < typename type_t >
+			static constexpr type_t apply(const type_t &a, const type_t &b) { return a - b; }
+		};
+
+		struct mul_op
+		{
+			template < typename type_t >
+			static constexpr type_t apply(const type_t &a, const type_t &b) { return a * b; }
+		};
+
+		struct div_op
+		{
+			template < typename type_t >
+			static constexpr type_t apply(const type_t &a, const type_t &b) { return a / b; }
+		};
+
+		struct neg_op
+		{
+			template < typename type_t >
+			static constexpr type_t apply(const type_t &a, const type_t&) { return -a; }
+		};
+
+		template < typename op_t, typename type_t, uint64_t size_u, uint64_t align_u, uint64_t... i_u >
+		constexpr cc0::array<type_t,size_u,align_u> fixed_map(const cc0::array<type_t,size_u,align_u> &a, const cc0::array<type_t,size_u,align_u> &b, index_list<i_u...>)
+		{
+			return cc0::array<type_t,size_u,align_u>(cc0::values<type_t,size_u>{{ op_t::apply(static_cast<const type_t*>(a)[i_u], static_cast<const type_t*>(b)[i_u])... }});
+		}
+
+		template < typename op_t, typename type_t, uint64_t size_u, uint64_t align_u >
+		cc0::array<type_t,size_u,align_u> fixed_map(const cc0::array<type_t,size_u,align_u> &a, const cc0::array<type_t,size_u,align_u> &b, loop_tag)
+		{
+			cc0::array<type_t,size_u,align_u> r;
+			for (uint64_t i = 0; i < size_u; ++i) {
+				r[i] = op_t::apply(a[i], b[i]);
+			}
+			return r;
+		}
+
+		template < typename op_t, typename type_t, uint64_t size_u, uint64_t align_u, uint64_t... i_u >
+		constexpr cc0::array<type_t,size_u,align_u> fixed_map(const cc0::array<type_t,size_u,align_u> &a, const type_t &s, index_list<i_u...>)
+		{
+			return cc0::array<type_t,size_u,align_u>(cc0::values<type_t,size_u>{{ op_t::apply(static_cast<const type_t*>(a)[i_u], s)... }});
+		}
+
+		template < typename op_t, typename type_t, uint64_t size_u, uint64_t align_u >
+		cc0::array<type_t,size_u,align_u> fixed_map(const cc0::array<type_t,size_u,align_u> &a, const type_t &s, loop_tag)
+		{
+			cc0::array<type_t,size_u,align_u> r;
+			for (uint64_t i = 0; i < size_u; ++i) {
+				r[i] = op_t::apply(a[i], s);
+			}
+			return r;
+		}
+	}
+}
+
+template < typename type_t >
+void cc0::internal::construct(type_t *dst, uint64_t count)
+{
+	cc0::internal::construct(dst, count, std::is_trivially_default_constructible<type_t>());
+}
+
+template < typename type_t >
+void cc0::internal::destruct(type_t *dst, uint64_t count)
+{
+	cc0::internal::destruct(dst, count, std::is_trivially_destructible<type_t>());
+}
+
+template < typename type_t, typename type2_t >
+void cc0::internal::copy_construct(type_t *dst, const type2_t *src, uint64_t count)
+{
+	cc0::internal::copy_construct(dst, src, count, cc0::internal::is_bitwise_copyable<type_t,type2_t>());
+}
+
+template < typename type_t, typename type2_t >
+void cc0::internal::copy_assign(type_t *dst, const type2_t *src, uint64_t count)
+{
+	cc0::internal::copy_assign(dst, src, count, cc0::internal::is_bitwise_copyable<type_t,type2_t>());
+}
+
+template < typename type_t, typename type2_t >
+void cc0::internal::move_construct(type_t *dst, type2_t *src, uint64_t count)
+{
+	cc0::internal::move_construct(dst, src, count, cc0::internal::is_bitwise_copyable<type_t,type2_t>());
+}
+
+template < typename type_t, typename type2_t >
+void cc0::internal::move_assign(type_t *dst, type2_t *src, uint64_t count)
+{
+	cc0::internal::move_assign(dst, src, count, cc0::internal::is_bitwise_copyable<type_t,type2_t>());
+}
+
+template < typename type_t, uint64_t size_u >
+cc0::values<type_t,size_u>::operator type_t*( void )
+{
+	return v;
+}
+
+template < typename type_t, uint64_t size_u >
+constexpr cc0::values<type_t,size_u>::operator const type_t*( void ) const
+{
+	return v;
+}
+
+template < typename type_t >
+cc0::slice<type_t>::slice( void ) : m_values(nullptr), m_size(0)
+{}
+
+template < typename type_t >
+template < typename type2_t >
+cc0::slice<type_t>::slice(const cc0::slice<type2_t> &arr) : m_values(arr), m_size(arr.size())
+{}
+
+template < typename type_t >
+template < typename type2_t >
+cc0::slice<type_t>::slice(type2_t *values, uint64_t size) : m_values(values), m_size(size)
+{}
+
+template < typename type_t >
+template < typename type2_t, uint64_t size_u >
+cc0::slice<type_t>::slice(type2_t (&values)[size_u]) : m_values(values), m_size(size_u)
+{}
+
+template < typename type_t >
+template < typename type2_t >
+cc0::slice<type_t> &cc0::slice<type_t>::operator=(const cc0::slice<type2_t> &arr)
+{
+	m_values = arr.m_values;
+	m_size = arr.m_size;
+	return *this;
+}
+
+template < typename type_t >
+template < typename type2_t, uint64_t size_u >
+cc0::slice<type_t> &cc0::slice<type_t>::operator=(type2_t (&values)[size_u])
+{
+	m_values = values;
+	m_size = size_u;
+	return *this;
+}
+
+template < typename type_t >
+void cc0::slice<type_t>::release( void )
+{
+	m_values = nullptr;
+	m_size = 0;
+}
+
+template < typename type_t >
+cc0::slice<type_t>::operator type_t*( void )
+{
+	return m_values;
+}
+
+template < typename type_t >
+cc0::slice<type_t>::operator const type_t*( void ) const
+{
+	return m_values;
+}
+
+#if defined(CC0_ARR_CHECKED)
+template < typename type_t >
+template < typename index_t >
+type_t &cc0::slice<type_t>::operator[](index_t i)
+{
+	CC0_ARR_ASSERT(static_cast<uint64_t>(i) < m_size);
+	return m_values[i];
+}
+
+template < typename type_t >
+template < typename index_t >
+const type_t &cc0::slice<type_t>::operator[](index_t i) const
+{
+	CC0_ARR_ASSERT(static_cast<uint64_t>(i) < m_size);
+	return m_values[i];
+}
+#endif
+
+template < typename type_t >
+cc0::slice<type_t> cc0::slice<type_t>::operator()(uint64_t start, uint64_t end)
+{
+	CC0_ARR_ASSERT(start <= end && end <= m_size);
+	return cc0::slice<type_t>(m_values + start, (end - start));
+}
+
+template < typename type_t >
+cc0::slice<const type_t> cc0::slice<type_t>::operator()(uint64_t start, uint64_t end) const
+{
+	CC0_ARR_ASSERT(start <= end && end <= m_size);
+	return cc0::slice<const type_t>(m_values + start, (end - start));
+}
+
+template < typename type_t >
+uint64_t cc0::slice<type_t>::size( void ) const
+{
+	return m_size;
+}
+
+template < typename type_t >
+template < typename type2_t >
+cc0::slice<type_t>::operator cc0::slice<const type2_t>( void ) const {
+	return cc0::slice<const type2_t>(m_values, m_size);
+}
+
+template < typename type_t, uint64_t size_u, uint64_t align_u >
+template < typename type2_t >
+void cc0::array<type_t,size_u,align_u>::copy(const type2_t *values)
+{
+	cc0::internal::copy_assign(m_values, values, size_u);
+}
+
+template < typename type_t, uint64_t size_u, uint64_t align_u >
+template < typename type2_t, uint64_t... i_u >
+constexpr cc0::array<type_t,size_u,align_u>::array(const type2_t *values, cc0::internal::index_list<i_u...>) : m_values{ cc0::internal::implicit_convert<type_t>(values[i_u])... }
+{}
+
+template < typename type_t, uint64_t size_u, uint64_t align_u >
+template < typename type2_t >
+cc0::array<type_t,size_u,align_u>::array(const type2_t *values, cc0::internal::loop_tag)
+{
+	copy(values);
+}
+
+template < typename type_t, uint64_t size_u, uint64_t align_u >
+template < typename type2_t, uint64_t align2_u >
+constexpr cc0::array<type_t,size_u,align_u>::array(const cc0::array<type2_t,size_u,align2_u> &arr) : array(arr.m_values, typename cc0::internal::unroll_indices<size_u>::type())
+{}
+
+template < typename type_t, uint64_t size_u, uint64_t align_u >
+template < typename type2_t >
+constexpr cc0::array<type_t,size_u,align_u>::array(const type2_t (&values)[size_u]) : array(values, typename cc0::internal::unroll_indices<size_u>::type())
+{}
+
+template < typename type_t, uint64_t size_u, uint64_t align_u >
+template < typename type2_t >
+constexpr cc0::array<type_t,size_u,align_u>::array(const cc0::values<type2_t,size_u> &vals) : array(vals.v, typename cc0::internal::unroll_indices<size_u>::type())
+{}
+
+template < typename type_t, uint64_t size_u, uint64_t align_u >
+template < typename type2_t, uint64_t align2_u >
+cc0::array<type_t,size_u,align_u> &cc0::array<type_t,size_u,align_u>::operator=(const cc0::array<type2_t,size_u,align2_u> &arr)
+{
+	copy<type2_t>(arr);
+	return *this;
+}
+
+template < typename type_t, uint64_t size_u, uint64_t align_u >
+template < typename type2_t >
+cc0::array<type_t,size_u,align_u> &cc0::array<type_t,size_u,align_u>::operator=(const cc0::values<type2_t,size_u> &vals)
+{
+	copy(vals.v);
+	return *this;
+}
+
+template < typename type_t, uint64_t size_u, uint64_t align_u >
+template < typename type2_t >
+cc0::array<type_t,size_u,align_u> &cc0::array<type_t,size_u,align_u>::operator=(const type2_t (&values)[size_u])
+{
+	copy(values);
+	return *this;
+}
+
+template < typename type_t, uint64_t size_u, uint64_t align_u >
+cc0::array<type_t,size_u,align_u>::operator type_t*( void )
+{
+	return m_values;
+}
+
+template < typename type_t, uint64_t size_u, uint64_t align_u >
+constexpr cc0::array<type_t,size_u,align_u>::operator const type_t*( void ) const
+{
+	return m_values;
+}
+
+#if defined(CC0_ARR_CHECKED)
+template < typename type_t, uint64_t size_u, uint64_t align_u >
+template < typename index_t >
+type_t &cc0::array<type_t,size_u,align_u>::operator[](index_t i)
+{
+	CC0_ARR_ASSERT(static_cast<uint64_t>(i) < size_u);
+	return m_values[i];
+}
+
+template < typename type_t, uint64_t size_u, uint64_t align_u >
+template < typename index_t >
+constexpr const type_t &cc0::array<type_t,size_u,align_u>::operator[](index_t i) const
+{
+	return CC0_ARR_ASSERT(static_cast<uint64_t>(i) < size_u), m_values[i];
+}
+#endif
+
+template < typename type_t, uint64_t size_u, uint64_t align_u >
+template < typename type2_t >
+cc0::array<type_t,size_u,align_u>::operator cc0::slice<type2_t>( void )
+{
+	return cc0::slice<type2_t>(m_values);
+}
+
+template < typename type_t, uint64_t size_u, uint64_t align_u >
+cc0::array<type_t,size_u,align_u>::operator cc0::slice<type_t>( void )
+{
+	return cc0::slice<type_t>(m_values);
+}
+
+template < typename type_t, uint64_t size_u, uint64_t align_u >
+template < typename type2_t >
+cc0::array<type_t,size_u,align_u>::operator const cc0::slice<const type2_t>( void ) const
+{
+	return cc0::slice<const type2_t>(m_values);
+}
+
+template < typename type_t, uint64_t size_u, uint64_t align_u >
+cc0::array<type_t,size_u,align_u>::operator const cc0::slice<const type_t>( void ) const
+{
+	return cc0::slice<const type_t>(m_values);
+}
+
+template < typename type_t, uint64_t size_u, uint64_t align_u >
+cc0::slice<type_t> cc0::array<type_t,size_u,align_u>::operator()(uint64_t start, uint64_t end)
+{
+	CC0_ARR_ASSERT(start <= end && end <= size_u);
+	return cc0::slice<type_t>(m_values + start, (end - start));
+}
+
+template < typename type_t, uint64_t size_u, uint64_t align_u >
+cc0::slice<const type_t> cc0::array<type_t,size_u,align_u>::operator()(uint64_t start, uint64_t end) const
+{
+	CC0_ARR_ASSERT(start <= end && end <= size_u);
+	return cc0::slice<const type_t>(m_values + start, (end - start));
+}
+
+template < typename type_t, uint64_t size_u, uint64_t align_u >
+constexpr uint64_t cc0::array<type_t,size_u,align_u>::size( void ) const
+{
+	return size_u;
+}
+
+template < typename type_t, typename type2_t, uint64_t size_u, uint64_t align_u, uint64_t align2_u >
+constexpr typename cc0::internal::if_fixed<bool,size_u>::type cc0::operator==(const cc0::array<type_t,size_u,align_u> &a, const cc0::array<type2_t,size_u,align2_u> &b)
+{
+	return cc0::internal::fixed_equal(static_cast<const type_t*>(a), static_cast<const type2_t*>(b), size_u, typename cc0::internal::unroll_indices<size_u>::type());
+}
+
+template < typename type_t, typename type2_t, uint64_t size_u, uint64_t align_u, uint64_t align2_u >
+constexpr typename cc0::internal::if_fixed<bool,size_u>::type cc0::operator!=(const cc0::array<type_t,size_u,align_u> &a, const cc0::array<type2_t,size_u,align2_u> &b)
+{
+	return !(a == b);
+}
+
+template < typename type_t, typename type2_t, uint64_t size_u >
+constexpr bool cc0::operator==(const cc0::values<type_t,size_u> &a, const cc0::values<type2_t,size_u> &b)
+{
+	return cc0::internal::fixed_equal(a.v, b.v, size_u, typename cc0::internal::unroll_indices<size_u>::type());
+}
+
+template < typename type_t, typename type2_t, uint64_t size_u >
+constexpr bool cc0::operator!=(const cc0::values<type_t,size_u> &a, const cc0::values<type2_t,size_u> &b)
+{
+	return !(a == b);
+}
+
+template < typename type_t, uint64_t size_u, uint64_t align_u >
+constexpr typename cc0::internal::if_fixed<cc0::array<type_t,size_u,align_u>,size_u>::type cc0::operator+(const cc0::array<type_t,size_u,align_u> &a, const cc0::array<type_t,size_u,align_u> &b)
+{
+	return cc0::internal::fixed_map<cc0::internal::add_op>(a, b, typename cc0::internal::unroll_indices<size_u>::type());
+}
+
+template < typename type_t, uint64_t size_u, uint64_t align_u >
+constexpr typename cc0::internal::if_fixed<cc0::array<type_t,size_u,align_u>,size_u>::type cc0::operator-(const cc0::array<type_t,size_u,align_u> &a, const cc0::array<type_t,size_u,align_u> &b)
+{
+	return cc0::internal::fixed_map<cc0::internal::sub_op>(a, b, typename cc0::internal::unroll_indices<size_u>::type());
+}
+
+template < typename type_t, uint64_t size_u, uint64_t align_u >
+constexpr typename cc0::internal::if_fixed<cc0::array<type_t,size_u,align_u>,size_u>::type cc0::operator*(const cc0::array<type_t,size_u,align_u> &a, const cc0::array<type_t,size_u,align_u> &b)
+{
+	return cc0::internal::fixed_map<cc0::internal::mul_op>(a, b, typename cc0::internal::unroll_indices<size_u>::type());
+}
+
+template < typename type_t, uint64_t size_u, uint64_t align_u >
+constexpr typename cc0::internal::if_fixed<cc0::array<type_t,size_u,align_u>,size_u>::type cc0::operator/(const cc0::array<type_t,size_u,align_u> &a, const cc0::array<type_t,size_u,align_u> &b)
+{
+	return cc0::internal::fixed_map<cc0::internal::div_op>(a, b, typename cc0::internal::unroll_indices<size_u>::type());
+}
+
+template < typename type_t, uint64_t size_u, uint64_t align_u >
+constexpr typename cc0::internal::if_fixed<cc0::array<type_t,size_u,align_u>,size_u>::type cc0::operator*(const cc0::array<type_t,size_u,align_u> &a, const typename std::remove_cv<type_t>::type &s)
+{
+	return cc0::internal::fixed_map<cc0::internal::mul_op>(a, s, typename cc0::internal::unroll_indices<size_u>::type());
+}
+
+template < typename type_t, uint64_t size_u, uint64_t align_u >
+constexpr typename cc0::internal::if_fixed<cc0::array<type_t,size_u,align_u>,size_u>::type cc0::operator*(const typename std::remove_cv<type_t>::type &s, const cc0::array<type_t,size_u,align_u> &a)
+{
+	return cc0::internal::fixed_map<cc0::internal::mul_op>(a, s, typename cc0::internal::unroll_indices<size_u>::type());
+}
+
+template < typename type_t, uint64_t size_u, uint64_t align_u >
+constexpr typename cc0::internal::if_fixed<cc0::array<type_t,size_u,align_u>,size_u>::type cc0::operator/(const cc0::array<type_t,size_u,align_u> &a, const typename std::remove_cv<type_t>::type &s)
+{
+	return cc0::internal::fixed_map<cc0::internal::div_op>(a, s, typename cc0::internal::unroll_indices<size_u>::type());
+}
+
+template < typename type_t, uint64_t size_u, uint64_t align_u >
+constexpr typename cc0::internal::if_fixed<cc0::array<type_t,size_u,align_u>,size_u>::type cc0::operator-(const cc0::array<type_t,size_u,align_u> &a)
+{
+	return cc0::internal::fixed_map<cc0::internal::neg_op>(a, a, typename cc0::internal::unroll_indices<size_u>::type());
+}
+
+template < typename type_t, uint64_t size_u, uint64_t align_u >
+typename cc0::internal::if_fixed<cc0::array<type_t,size_u,align_u>,size_u>::type &cc0::operator+=(cc0::array<type_t,size_u,align_u> &a, const cc0::array<type_t,size_u,align_u> &b)
+{
+	return a = a + b;
+}
+
+template < typename type_t, uint64_t size_u, uint64_t align_u >
+typename cc0::internal::if_fixed<cc0::array<type_t,size_u,align_u>,size_u>::type &cc0::operator-=(cc0::array<type_t,size_u,align_u> &a, const cc0::array<type_t,size_u,align_u> &b)
+{
+	return a = a - b;
+}
+
+template < typename type_t, uint64_t size_u, uint64_t align_u >
+typename cc0::internal::if_fixed<cc0::array<type_t,size_u,align_u>,size_u>::type &cc0::operator*=(cc0::array<type_t,size_u,align_u> &a, const cc0::array<type_t,size_u,align_u> &b)
+{
+	return a = a * b;
+}
+
+template < typename type_t, uint64_t size_u, uint64_t align_u >
+typename cc0::internal::if_fixed<cc0::array<type_t,size_u,align_u>,size_u>::type &cc0::operator/=(cc0::array<type_t,size_u,align_u> &a, const cc0::array<type_t,size_u,align_u> &b)
+{
+	return a = a / b;
+}
+
+template < typename type_t, uint64_t size_u, uint64_t align_u >
+typename cc0::internal::if_fixed<cc0::array<type_t,size_u,align_u>,size_u>::type &cc0::operator*=(cc0::array<type_t,size_u,align_u> &a, const typename std::remove_cv<type_t>::type &s)
+{
+	return a = a * s;
+}
+
+template < typename type_t, uint64_t size_u, uint64_t align_u >
+typename cc0::internal::if_fixed<cc0::array<type_t,size_u,align_u>,size_u>::type &cc0::operator/=(cc0::array<type_t,size_u,align_u> &a, const typename std::remove_cv<type_t>::type &s)
+{
+	return a = a / s;
+}
+
+template < typename type_t, uint64_t size_u, uint64_t align_u, uint64_t align2_u >
+constexpr typename cc0::internal::if_fixed<typename std::remove_cv<type_t>::type,size_u>::type cc0::dot(const cc0::array<type_t,size_u,align_u> &a, const cc0::array<type_t,size_u,align2_u> &b)
+{
+	return cc0::internal::fixed_dot<typename std::remove_cv<type_t>::type>(a, b, size_u, typename cc0::internal::unroll_indices<size_u>::type());
+}
+
+template < typename type_t, uint64_t align_u >
+void cc0::array<type_t,0,align_u>::set_size(uint64_t size)
+{
+	if (m_size > size) {
+		cc0::internal::destruct(m_values + size, m_size - size);
+	} else {
+		cc0::internal::construct(m_values + m_size, size - m_size);
+	}
+	m_size = size;
+}
+
+template < typename type_t, uint64_t align_u >
+type_t *cc0::array<type_t,0,align_u>::allocate(uint64_t capacity)
+{
+	return capacity > 0 ? static_cast<type_t*>(cc0::internal::allocate(m_allocator, cc0::internal::array_bytes<type_t>(capacity), align_u)) : nullptr;
+}
+
+template < typename type_t, uint64_t align_u >
+void cc0::array<type_t,0,align_u>::reallocate(type_t *mem, uint64_t capacity)
+{
+	cc0::internal::allocation_guard guard = { m_allocator, mem, capacity * sizeof(type_t), align_u };
+	cc0::internal::move_construct(mem, m_values, m_size);
+	guard.release();
+	replace(mem, capacity);
+}
+
+template < typename type_t, uint64_t align_u >
+void cc0::array<type_t,0,align_u>::replace(type_t *mem, uint64_t capacity)
+{
+	cc0::internal::destruct(m_values, m_size);
+	if (m_values != nullptr) {
+		cc0::internal::deallocate(m_allocator, m_values, m_capacity * sizeof(type_t), align_u);
+	}
+	m_values = mem;
+	m_capacity = capacity;
+}
+
+template < typename type_t, uint64_t align_u >
+uint64_t cc0::array<type_t,0,align_u>::grow(uint64_t size) const
+{
+	const uint64_t capacity = m_capacity > ~uint64_t(0) / 2 ? ~uint64_t(0) : m_capacity * 2;
+	return capacity > size ? capacity : size;
+}
+
+template < typename type_t, uint64_t align_u >
+template < typename type2_t >
+void cc0::array<type_t,0,align_u>::copy(const type2_t *values, uint64_t size, bool use_pool)
+{
+	if ((size < m_capacity && !use_pool) || size > m_capacity) {
+		// Construct the copy in new memory before freeing the old, in case the values are located in the old memory.
+		type_t *mem = allocate(size);
+		cc0::internal::allocation_guard guard = { m_allocator, mem, size * sizeof(type_t), align_u };
+		cc0::internal::copy_construct(mem, values, size);
+		guard.release();
+		destroy(false);
+		m_values = mem;
+		m_size = m_capacity = size;
+	} else {
+		if (m_capacity > 0) {
+			CC0_ARR_INSTRUMENT_EVENT(instrument_pool_reuse, m_values, size * sizeof(type_t));
+		}
+		const uint64_t live = m_size < size ? m_size : size;
+		cc0::internal::copy_assign(m_values, values, live);
+		cc0::internal::copy_construct(m_values + live, values + live, size - live);
+		if (m_size > size) {
+			cc0::internal::destruct(m_values + size, m_size - size);
+		}
+		m_size = size;
+	}
+	CC0_ARR_INSTRUMENT_EVENT(instrument_deep_copy, m_values, size * sizeof(type_t));
+}
+
+template < typename type_t, uint64_t align_u >
+template < typename type2_t >
+void cc0::array<type_t,0,align_u>::move(type2_t *values, uint64_t size, bool use_pool)
+{
+	if ((size < m_capacity && !use_pool) || size > m_capacity) {
+		type_t *mem = allocate(size);
+		cc0::internal::allocation_guard guard = { m_allocator, mem, size * sizeof(type_t), align_u };
+		cc0::internal::move_construct(mem, values, size);
+		guard.release();
+		destroy(false);
+		m_values = mem;
+		m_size = m_capacity = size;
+	} else {
+		if (m_capacity > 0) {
+			CC0_ARR_INSTRUMENT_EVENT(instrument_pool_reuse, m_values, size * sizeof(type_t));
+		}
+		const uint64_t live = m_size < size ? m_size : size;
+		cc0::internal::move_assign(m_values, values, live);
+		cc0::internal::move_construct(m_values + live, values + live, size - live);
+		if (m_size > size) {
+			cc0::internal::destruct(m_values + size, m_size - size);
+		}
+		m_size = size;
+	}
+}
+
+template < typename type_t, uint64_t align_u >
+template < typename type2_t, uint64_t align2_u >
+void cc0::array<type_t,0,align_u>::take(cc0::array<type2_t,0,align2_u> &arr, std::true_type)
+{
+	if (m_values != arr.m_values) {
+		destroy(false);
+	}
+	m_values       = arr.m_values;
+	m_size         = arr.m_size;
+	m_capacity     = arr.m_capacity;
+	m_allocator    = arr.m_allocator;
+	arr.m_values   = nullptr;
+	arr.m_size     = 0;
+	arr.m_capacity = 0;
+}
+
+template < typename type_t, uint64_t align_u >
+template < typename type2_t, uint64_t align2_u >
+void cc0::array<type_t,0,align_u>::take(cc0::array<type2_t,0,align2_u> &arr, std::false_type)
+{
+	move<type2_t>(arr.m_values, arr.m_size, true);
+	arr.destroy(false);
+}
+
+template < typename type_t, uint64_t align_u >
+cc0::array<type_t,0,align_u>::array( void ) : m_values(nullptr), m_size(0), m_capacity(0), m_allocator(cc0::default_allocator())
+{}
+
+template < typename type_t, uint64_t align_u >
+cc0::array<type_t,0,align_u>::array(cc0::allocator *allocator) : m_values(nullptr), m_size(0), m_capacity(0), m_allocator(allocator != nullptr ? allocator : cc0::default_allocator())
+{}
+
+template < typename type_t, uint64_t align_u >
+template < typename type2_t, uint64_t size_u >
+cc0::array<type_t,0,align_u>::array(const type2_t (&values)[size_u]) : array()
+{
+	copy<type2_t>(values, size_u, false);
+}
+
+template < typename type_t, uint64_t align_u >
+template < typename type2_t, uint64_t align2_u >
+cc0::array<type_t,0,align_u>::array(cc0::array<type2_t,0,align2_u> &&arr) : array(arr.m_allocator)
+{
+	take(arr, cc0::internal::is_adoptable<type_t,type2_t,align_u,align2_u>());
+}
+
+template < typename type_t, uint64_t align_u >
+cc0::array<type_t,0,align_u>::array(cc0::array<type_t,0,align_u> &&arr) : m_values(arr), m_size(arr.m_size), m_capacity(arr.m_capacity), m_allocator(arr.m_allocator)
+{
+	arr.m_values = nullptr;
+	arr.m_size = 0;
+	arr.m_capacity = 0;
+}
+
+template < typename type_t, uint64_t align_u >
+cc0::array<type_t,0,align_u>::array(uint64_t size) : array()
+{
+	create(size, false);
+}
+
+template < typename type_t, uint64_t align_u >
+cc0::array<type_t,0,align_u>::array(uint64_t size, cc0::allocator *allocator) : array(allocator)
+{
+	create(size, false);
+}
+
+template < typename type_t, uint64_t align_u >
+template < typename type2_t, uint64_t align2_u >
+cc0::array<type_t,0,align_u>::array(const cc0::array<type2_t,0,align2_u> &arr) : array()
+{
+	copy<type2_t>(arr, arr.size(), true);
+}
+
+template < typename type_t, uint64_t align_u >
+cc0::array<type_t,0,align_u>::array(const cc0::array<type_t,0,align_u> &arr) : array()
+{
+	copy<type_t>(arr, arr.size(), true);
+}
+
+template < typename type_t, uint64_t align_u >
+template < typename type2_t, uint64_t size_u, uint64_t align2_u >
+cc0::array<type_t,0,align_u>::array(const cc0::array<type2_t,size_u,align2_u> &arr) : array()
+{
+	copy<type2_t>(arr, size_u, true);
+}
+
+template < typename type_t, uint64_t align_u >
+template < typename type2_t, uint64_t size_u, uint64_t align2_u >
+cc0::array<type_t,0,align_u>::array(cc0::array<type2_t,size_u,align2_u> &&arr) : array()
+{
+	move<type2_t>(arr, size_u, true);
+}
+
+template < typename type_t, uint64_t align_u >
 template < typename type2_t >
-cc0::slice<type_t>::operator cc0::slice<const type2_t>( void ) const {
+cc0::array<type_t,0,align_u>::array(const cc0::slice<type2_t> &arr) : array()
+{
+	copy<type2_t>(arr, arr.size(), true);
+}
+
+template < typename type_t, uint64_t align_u >
+template < typename type2_t >
+cc0::array<type_t,0,align_u>::array(const cc0::slice<const type2_t> &arr) : array()
+{
+	copy<type2_t>(arr, arr.size(), true);
+}
+
+template < typename type_t, uint64_t align_u >
+template < typename type2_t >
+cc0::array<type_t,0,align_u>::array(const type2_t *values, uint64_t size) : array()
+{
+	copy<type2_t>(values, size, true);
+}
+
+template < typename type_t, uint64_t align_u >
+template < typename type2_t, uint64_t size_u >
+cc0::array<type_t,0,align_u>::array(const cc0::values<type2_t,size_u> &vals) : array()
+{
+	copy<type2_t>(vals.v, size_u, true);
+}
+
+template < typename type_t, uint64_t align_u >
+template < typename type2_t, uint64_t size_u >
+cc0::array<type_t,0,align_u>::array(cc0::values<type2_t,size_u> &&vals) : array()
+{
+	move<type2_t>(vals.v, size_u, true);
+}
+
+template < typename type_t, uint64_t align_u >
+cc0::array<type_t,0,align_u>::~array( void )
+{
+	destroy(false);
+}
+
+template < typename type_t, uint64_t align_u >
+template < typename type2_t, uint64_t align2_u >
+cc0::array<type_t,0,align_u> &cc0::array<type_t,0,align_u>::operator=(const cc0::array<type2_t,0,align2_u> &arr)
+{
+	copy<type2_t>(arr, arr.size(), true);
+	return *this;
+}
+
+template < typename type_t, uint64_t align_u >
+cc0::array<type_t,0,align_u> &cc0::array<type_t,0,align_u>::operator=(const cc0::array<type_t,0,align_u> &arr)
+{
+	copy<type_t>(arr, arr.size(), true);
+	return *this;
+}
+
+template < typename type_t, uint64_t align_u >
+template < typename type2_t, uint64_t align2_u >
+cc0::array<type_t,0,align_u> &cc0::array<type_t,0,align_u>::operator=(cc0::array<type2_t,0,align2_u> &&arr)
+{
+	take(arr, cc0::internal::is_adoptable<type_t,type2_t,align_u,align2_u>());
+	return *this;
+}
+
+template < typename type_t, uint64_t align_u >
+cc0::array<type_t,0,align_u> &cc0::array<type_t,0,align_u>::operator=(cc0::array<type_t,0,align_u> &&arr)
+{
+	if (m_values != arr.m_values) {
+		destroy(false);
+	}
+	m_values       = arr.m_values;
+	m_size         = arr.m_size;
+	m_capacity     = arr.m_capacity;
+	m_allocator    = arr.m_allocator;
+	arr.m_values   = nullptr;
+	arr.m_size     = 0;
+	arr.m_capacity = 0;
+	return *this;
+}
+
+template < typename type_t, uint64_t align_u >
+template < typename type2_t, uint64_t size_u, uint64_t align2_u >
+cc0::array<type_t,0,align_u> &cc0::array<type_t,0,align_u>::operator=(const cc0::array<type2_t,size_u,align2_u> &arr)
+{
+	copy<type2_t>(arr, size_u, true);
+	return *this;
+}
+
+template < typename type_t, uint64_t align_u >
+template < typename type2_t, uint64_t size_u, uint64_t align2_u >
+cc0::array<type_t,0,align_u> &cc0::array<type_t,0,align_u>::operator=(cc0::array<type2_t,size_u,align2_u> &&arr)
+{
+	move<type2_t>(arr, size_u, true);
+	return *this;
+}
+
+template < typename type_t, uint64_t align_u >
+template < typename type2_t >
+cc0::array<type_t,0,align_u> &cc0::array<type_t,0,align_u>::operator=(const cc0::slice<const type2_t> &arr)
+{
+	copy<type2_t>(arr, arr.size(), true);
+	return *this;
+}
+
+template < typename type_t, uint64_t align_u >
+template < typename type2_t, uint64_t size_u >
+cc0::array<type_t,0,align_u> &cc0::array<type_t,0,align_u>::operator=(const type2_t (&values)[size_u])
+{
+	copy<type2_t>(values, size_u, true);
+	return *this;
+}
+
+template < typename type_t, uint64_t align_u >
+template < typename type2_t, uint64_t size_u >
+cc0::array<type_t,0,align_u> &cc0::array<type_t,0,align_u>::operator=(const cc0::values<type2_t,size_u> &vals)
+{
+	copy(vals.v, size_u, true);
+	return *this;
+}
+
+template < typename type_t, uint64_t align_u >
+template < typename type2_t, uint64_t size_u >
+cc0::array<type_t,0,align_u> &cc0::array<type_t,0,align_u>::operator=(cc0::values<type2_t,size_u> &&vals)
+{
+	move<type2_t>(vals.v, size_u, true);
+	return *this;
+}
+
+template < typename type_t, uint64_t align_u >
+void cc0::array<type_t,0,align_u>::create(uint64_t size, bool use_pool)
+{
+	if ((size < m_capacity && !use_pool) || size > m_capacity) {
+		destroy(false);
+		m_values = allocate(size);
+		m_capacity = size;
+	} else if (m_capacity > 0) {
+		CC0_ARR_INSTRUMENT_EVENT(instrument_pool_reuse, m_values, size * sizeof(type_t));
+	}
+	set_size(size);
+}
+
+template < typename type_t, uint64_t align_u >
+void cc0::array<type_t,0,align_u>::destroy(bool use_pool)
+{
+	cc0::internal::destruct(m_values, m_size);
+	m_size = 0;
+	if (!use_pool && m_values != nullptr) {
+		cc0::internal::deallocate(m_allocator, m_values, m_capacity * sizeof(type_t), align_u);
+		m_values = nullptr;
+		m_capacity = 0;
+	}
+}
+
+template < typename type_t, uint64_t align_u >
+void cc0::array<type_t,0,align_u>::reserve(uint64_t capacity)
+{
+	if (capacity > m_capacity) {
+		reallocate(allocate(capacity), capacity);
+	}
+}
+
+template < typename type_t, uint64_t align_u >
+void cc0::array<type_t,0,align_u>::resize(uint64_t size)
+{
+	if (size > m_capacity) {
+		reserve(grow(size));
+	}
+	set_size(size);
+}
+
+template < typename type_t, uint64_t align_u >
+void cc0::array<type_t,0,align_u>::push_back(const type_t &value)
+{
+	emplace_back(value);
+}
+
+template < typename type_t, uint64_t align_u >
+void cc0::array<type_t,0,align_u>::push_back(type_t &&value)
+{
+	emplace_back(std::move(value));
+}
+
+template < typename type_t, uint64_t align_u >
+template < typename... args_t >
+type_t &cc0::array<type_t,0,align_u>::emplace_back(args_t&&... args)
+{
+	if (m_size < m_capacity) {
+		new (m_values + m_size) type_t(std::forward<args_t>(args)...);
+	} else {
+		// Construct the new element before moving the old ones, in case the arguments reference the old memory.
+		const uint64_t capacity = grow(m_size + 1);
+		type_t *mem = allocate(capacity);
+		cc0::internal::allocation_guard guard = { m_allocator, mem, capacity * sizeof(type_t), align_u };
+		new (mem + m_size) type_t(std::forward<args_t>(args)...);
+		cc0::internal::construct_guard<type_t> element = { mem + m_size, 1 };
+		cc0::internal::move_construct(mem, m_values, m_size);
+		element.count = 0;
+		guard.release();
+		replace(mem, capacity);
+	}
+	return m_values[m_size++];
+}
+
+template < typename type_t, uint64_t align_u >
+void cc0::array<type_t,0,align_u>::shrink_to_fit( void )
+{
+	if (m_size < m_capacity) {
+		reallocate(allocate(m_size), m_size);
+	}
+}
+
+template < typename type_t, uint64_t align_u >
+void cc0::array<type_t,0,align_u>::adopt(type_t *values, uint64_t size, uint64_t capacity)
+{
+	CC0_ARR_ASSERT(size <= capacity);
+	if (values != m_values) {
+		destroy(false);
+	}
+	m_values = values;
+	m_size = size;
+	m_capacity = capacity;
+}
+
+template < typename type_t, uint64_t align_u >
+type_t *cc0::array<type_t,0,align_u>::release( void )
+{
+	type_t *values = m_values;
+	m_values = nullptr;
+	m_size = 0;
+	m_capacity = 0;
+	return values;
+}
+
+template < typename type_t, uint64_t align_u >
+cc0::allocator *cc0::array<type_t,0,align_u>::get_allocator( void ) const
+{
+	return m_allocator;
+}
+
+template < typename type_t, uint64_t align_u >
+void cc0::array<type_t,0,align_u>::set_allocator(cc0::allocator *allocator)
+{
+	destroy(false);
+	m_allocator = allocator != nullptr ? allocator : cc0::default_allocator();
+}
+
+template < typename type_t, uint64_t align_u >
+cc0::array<type_t,0,align_u>::operator type_t*( void )
+{
+	return m_values;
+}
+
+template < typename type_t, uint64_t align_u >
+cc0::array<type_t,0,align_u>::operator const type_t*( void ) const
+{
+	return m_values;
+}
+
+#if defined(CC0_ARR_CHECKED)
+template < typename type_t, uint64_t align_u >
+template < typename index_t >
+type_t &cc0::array<type_t,0,align_u>::operator[](index_t i)
+{
+	CC0_ARR_ASSERT(static_cast<uint64_t>(i) < m_size);
+	return m_values[i];
+}
+
+template < typename type_t, uint64_t align_u >
+template < typename index_t >
+const type_t &cc0::array<type_t,0,align_u>::operator[](index_t i) const
+{
+	CC0_ARR_ASSERT(static_cast<uint64_t>(i) < m_size);
+	return m_values[i];
+}
+#endif
+
+template < typename type_t, uint64_t align_u >
+template < typename type2_t >
+cc0::array<type_t,0,align_u>::operator cc0::slice<type2_t>( void )
+{
+	return cc0::slice<type2_t>(m_values, m_size);
+}
+
+template < typename type_t, uint64_t align_u >
+cc0::array<type_t,0,align_u>::operator cc0::slice<type_t>( void )
+{
+	return cc0::slice<type_t>(m_values, m_size);
+}
+
+template < typename type_t, uint64_t align_u >
+template < typename type2_t >
+cc0::array<type_t,0,align_u>::operator const cc0::slice<const type2_t>( void ) const
+{
 	return cc0::slice<const type2_t>(m_values, m_size);
 }
 
+template < typename type_t, uint64_t align_u >
+cc0::array<type_t,0,align_u>::operator const cc0::slice<const type_t>( void ) const
+{
+	return cc0::slice<const type_t>(m_values, m_size);
+}
+
+template < typename type_t, uint64_t align_u >
+cc0::slice<type_t> cc0::array<type_t,0,align_u>::operator()(uint64_t start, uint64_t end)
+{
+	CC0_ARR_ASSERT(start <= end && end <= m_size);
+	return cc0::slice<type_t>(m_values + start, (end - start));
+}
+
+template < typename type_t, uint64_t align_u >
+cc0::slice<const type_t> cc0::array<type_t,0,align_u>::operator()(uint64_t start, uint64_t end) const
+{
+	CC0_ARR_ASSERT(start <= end && end <= m_size);
+	return cc0::slice<const type_t>(m_values + start, (end - start));
+}
+
+template < typename type_t, uint64_t align_u >
+uint64_t cc0::array<type_t,0,align_u>::size( void ) const
+{
+	return m_size;
+}
+
+template < typename type_t, uint64_t align_u >
+uint64_t cc0::array<type_t,0,align_u>::capacity( void ) const
+{
+	return m_capacity;
+}
+
+template < typename type_t, uint64_t size_u >
+type_t *cc0::small_array<type_t,size_u>::storage( void )
+{
+	return reinterpret_cast<type_t*>(m_storage);
+}
+
+template < typename type_t, uint64_t size_u >
+void cc0::small_array<type_t,size_u>::reallocate(type_t *mem, uint64_t capacity)
+{
+	// The inline storage is never freed.
+	cc0::internal::allocation_guard guard = { m_allocator, mem != storage() ? mem : nullptr, capacity * sizeof(type_t), alignof(type_t) };
+	cc0::internal::move_construct(mem, m_values, m_size);
+	guard.release();
+	replace(mem, capacity);
+}
+
+template < typename type_t, uint64_t size_u >
+void cc0::small_array<type_t,size_u>::replace(type_t *mem, uint64_t capacity)
+{
+	cc0::internal::destruct(m_values, m_size);
+	if (!is_small()) {
+		cc0::internal::deallocate(m_allocator, m_values, m_capacity * sizeof(type_t), alignof(type_t));
+	}
+	m_values = mem;
+	m_capacity = capacity;
+}
+
+template < typename type_t, uint64_t size_u >
+template < typename type2_t >
+void cc0::small_array<type_t,size_u>::copy(const type2_t *values, uint64_t size)
+{
+	if (size > m_capacity) {
+		// Construct the copy in new memory before freeing the old, in case the values are located in the old memory.
+		type_t *mem = static_cast<type_t*>(cc0::internal::allocate(m_allocator, cc0::internal::array_bytes<type_t>(size), alignof(type_t)));
+		cc0::internal::allocation_guard guard = { m_allocator, mem, size * sizeof(type_t), alignof(type_t) };
+		cc0::internal::copy_construct(mem, values, size);
+		guard.release();
+		destroy(false);
+		m_values = mem;
+		m_size = m_capacity = size;
+	} else {
+		if (!is_small()) {
+			CC0_ARR_INSTRUMENT_EVENT(instrument_pool_reuse, m_values, size * sizeof(type_t));
+		}
+		const uint64_t live = m_size < size ? m_size : size;
+		cc0::internal::copy_assign(m_values, values, live);
+		cc0::internal::copy_construct(m_values + live, values + live, size - live);
+		if (m_size > size) {
+			cc0::internal::destruct(m_values + size, m_size - size);
+		}
+		m_size = size;
+	}
+	CC0_ARR_INSTRUMENT_EVENT(instrument_deep_copy, m_values, size * sizeof(type_t));
+}
+
+template < typename type_t, uint64_t size_u >
+void cc0::small_array<type_t,size_u>::steal(small_array &arr)
+{
+	if (arr.is_small()) {
+		// The inline storage of the other array always fits in the memory of this array.
+		destroy(true);
+		cc0::internal::move_construct(m_values, arr.m_values, arr.m_size);
+		m_size = arr.m_size;
+		arr.destroy(true);
+	} else {
+		destroy(false);
+		m_values         = arr.m_values;
+		m_size           = arr.m_size;
+		m_capacity       = arr.m_capacity;
+		m_allocator      = arr.m_allocator;
+		arr.m_values     = arr.storage();
+		arr.m_size       = 0;
+		arr.m_capacity   = size_u;
+	}
+}
+
+template < typename type_t, uint64_t size_u >
+cc0::small_array<type_t,size_u>::small_array( void ) : m_values(storage()), m_size(0), m_capacity(size_u), m_allocator(cc0::default_allocator())
+{}
+
+template < typename type_t, uint64_t size_u >
+cc0::small_array<type_t,size_u>::small_array(cc0::allocator *allocator) : m_values(storage()), m_size(0), m_capacity(size_u), m_allocator(allocator != nullptr ? allocator : cc0::default_allocator())
+{}
+
+template < typename type_t, uint64_t size_u >
+cc0::small_array<type_t,size_u>::small_array(uint64_t size) : small_array()
+{
+	create(size, false);
+}
+
+template < typename type_t, uint64_t size_u >
+cc0::small_array<type_t,size_u>::small_array(const cc0::small_array<type_t,size_u> &arr) : small_array(arr.m_allocator)
+{
+	copy<type_t>(arr, arr.size());
+}
+
+template < typename type_t, uint64_t size_u >
+cc0::small_array<type_t,size_u>::small_array(cc0::small_array<type_t,size_u> &&arr) : small_array(arr.m_allocator)
+{
+	steal(arr);
+}
+
 template < typename type_t, uint64_t size_u >
 template < typename type2_t >
-void cc0::array<type_t,size_u>::copy(const type2_t *values)
+cc0::small_array<type_t,size_u>::small_array(const cc0::slice<type2_t> &arr) : small_array()
+{
+	copy<type2_t>(arr, arr.size());
+}
+
+template < typename type_t, uint64_t size_u >
+template < typename type2_t, uint64_t size2_u >
+cc0::small_array<type_t,size_u>::small_array(const type2_t (&values)[size2_u]) : small_array()
+{
+	copy<type2_t>(values, size2_u);
+}
+
+template < typename type_t, uint64_t size_u >
+cc0::small_array<type_t,size_u>::~small_array( void )
+{
+	destroy(false);
+}
+
+template < typename type_t, uint64_t size_u >
+cc0::small_array<type_t,size_u> &cc0::small_array<type_t,size_u>::operator=(const cc0::small_array<type_t,size_u> &arr)
+{
+	copy<type_t>(arr, arr.size());
+	return *this;
+}
+
+template < typename type_t, uint64_t size_u >
+cc0::small_array<type_t,size_u> &cc0::small_array<type_t,size_u>::operator=(cc0::small_array<type_t,size_u> &&arr)
 {
-	for (uint64_t i = 0; i < size_u; ++i) {
-		m_values[i] = values[i];
+	if (this != &arr) {
+		steal(arr);
 	}
+	return *this;
 }
 
 template < typename type_t, uint64_t size_u >
 template < typename type2_t >
-cc0::array<type_t,size_u>::array(const cc0::array<type2_t,size_u> &arr)
+cc0::small_array<type_t,size_u> &cc0::small_array<type_t,size_u>::operator=(const cc0::slice<type2_t> &arr)
 {
-	copy<type2_t>(arr);
+	copy<type2_t>(arr, arr.size());
+	return *this;
 }
 
 template < typename type_t, uint64_t size_u >
-template < typename type2_t >
-cc0::array<type_t,size_u>::array(const type2_t (&values)[size_u])
+void cc0::small_array<type_t,size_u>::create(uint64_t size, bool use_pool)
 {
-	copy(values);
+	if (size > m_capacity || (!use_pool && !is_small() && size < m_capacity)) {
+		destroy(false);
+		if (size > size_u) {
+			m_values = static_cast<type_t*>(cc0::internal::allocate(m_allocator, cc0::internal::array_bytes<type_t>(size), alignof(type_t)));
+			m_capacity = size;
+		}
+	} else if (!is_small()) {
+		CC0_ARR_INSTRUMENT_EVENT(instrument_pool_reuse, m_values, size * sizeof(type_t));
+	}
+	if (m_size > size) {
+		cc0::internal::destruct(m_values + size, m_size - size);
+	} else {
+		cc0::internal::construct(m_values + m_size, size - m_size);
+	}
+	m_size = size;
+}
+
+template < typename type_t, uint64_t size_u >
+void cc0::small_array<type_t,size_u>::destroy(bool use_pool)
+{
+	cc0::internal::destruct(m_values, m_size);
+	m_size = 0;
+	if (!use_pool && !is_small()) {
+		cc0::internal::deallocate(m_allocator, m_values, m_capacity * sizeof(type_t), alignof(type_t));
+		m_values = storage();
+		m_capacity = size_u;
+	}
+}
+
+template < typename type_t, uint64_t size_u >
+void cc0::small_array<type_t,size_u>::reserve(uint64_t capacity)
+{
+	if (capacity > m_capacity) {
+		reallocate(static_cast<type_t*>(cc0::internal::allocate(m_allocator, cc0::internal::array_bytes<type_t>(capacity), alignof(type_t))), capacity);
+	}
+}
+
+template < typename type_t, uint64_t size_u >
+void cc0::small_array<type_t,size_u>::resize(uint64_t size)
+{
+	if (size > m_capacity) {
+		reserve(m_capacity * 2 > size ? m_capacity * 2 : size);
+	}
+	if (m_size > size) {
+		cc0::internal::destruct(m_values + size, m_size - size);
+	} else {
+		cc0::internal::construct(m_values + m_size, size - m_size);
+	}
+	m_size = size;
+}
+
+template < typename type_t, uint64_t size_u >
+void cc0::small_array<type_t,size_u>::push_back(const type_t &value)
+{
+	emplace_back(value);
+}
+
+template < typename type_t, uint64_t size_u >
+void cc0::small_array<type_t,size_u>::push_back(type_t &&value)
+{
+	emplace_back(std::move(value));
+}
+
+template < typename type_t, uint64_t size_u >
+template < typename... args_t >
+type_t &cc0::small_array<type_t,size_u>::emplace_back(args_t&&... args)
+{
+	if (m_size < m_capacity) {
+		new (m_values + m_size) type_t(std::forward<args_t>(args)...);
+	} else {
+		// Construct the new element before moving the old ones, in case the arguments reference the old memory.
+		const uint64_t capacity = m_capacity > ~uint64_t(0) / 2 ? ~uint64_t(0) : m_capacity * 2;
+		type_t *mem = static_cast<type_t*>(cc0::internal::allocate(m_allocator, cc0::internal::array_bytes<type_t>(capacity), alignof(type_t)));
+		cc0::internal::allocation_guard guard = { m_allocator, mem, capacity * sizeof(type_t), alignof(type_t) };
+		new (mem + m_size) type_t(std::forward<args_t>(args)...);
+		cc0::internal::construct_guard<type_t> element = { mem + m_size, 1 };
+		cc0::internal::move_construct(mem, m_values, m_size);
+		element.count = 0;
+		guard.release();
+		replace(mem, capacity);
+	}
+	return m_values[m_size++];
+}
+
+template < typename type_t, uint64_t size_u >
+void cc0::small_array<type_t,size_u>::shrink_to_fit( void )
+{
+	if (!is_small() && m_size < m_capacity) {
+		if (m_size <= size_u) {
+			reallocate(storage(), size_u);
+		} else {
+			reallocate(static_cast<type_t*>(cc0::internal::allocate(m_allocator, cc0::internal::array_bytes<type_t>(m_size), alignof(type_t))), m_size);
+		}
+	}
+}
+
+template < typename type_t, uint64_t size_u >
+cc0::small_array<type_t,size_u>::operator type_t*( void )
+{
+	return m_values;
+}
+
+template < typename type_t, uint64_t size_u >
+cc0::small_array<type_t,size_u>::operator const type_t*( void ) const
+{
+	return m_values;
+}
+
+#if defined(CC0_ARR_CHECKED)
+template < typename type_t, uint64_t size_u >
+template < typename index_t >
+type_t &cc0::small_array<type_t,size_u>::operator[](index_t i)
+{
+	CC0_ARR_ASSERT(static_cast<uint64_t>(i) < m_size);
+	return m_values[i];
+}
+
+template < typename type_t, uint64_t size_u >
+template < typename index_t >
+const type_t &cc0::small_array<type_t,size_u>::operator[](index_t i) const
+{
+	CC0_ARR_ASSERT(static_cast<uint64_t>(i) < m_size);
+	return m_values[i];
 }
+#endif
 
 template < typename type_t, uint64_t size_u >
 template < typename type2_t >
-cc0::array<type_t,size_u>::array(const cc0::values<type2_t,size_u> &vals)
+cc0::small_array<type_t,size_u>::operator cc0::slice<type2_t>( void )
 {
-	copy(vals.v);
+	return cc0::slice<type2_t>(m_values, m_size);
+}
+
+template < typename type_t, uint64_t size_u >
+cc0::small_array<type_t,size_u>::operator cc0::slice<type_t>( void )
+{
+	return cc0::slice<type_t>(m_values, m_size);
 }
 
 template < typename type_t, uint64_t size_u >
 template < typename type2_t >
-cc0::array<type_t,size_u> &cc0::array<type_t,size_u>::operator=(const cc0::array<type2_t,size_u> &arr)
+cc0::small_array<type_t,size_u>::operator const cc0::slice<const type2_t>( void ) const
 {
-	copy<type2_t>(arr);
-	return *this;
+	return cc0::slice<const type2_t>(m_values, m_size);
+}
+
+template < typename type_t, uint64_t size_u >
+cc0::small_array<type_t,size_u>::operator const cc0::slice<const type_t>( void ) const
+{
+	return cc0::slice<const type_t>(m_values, m_size);
+}
+
+template < typename type_t, uint64_t size_u >
+cc0::slice<type_t> cc0::small_array<type_t,size_u>::operator()(uint64_t start, uint64_t end)
+{
+	CC0_ARR_ASSERT(start <= end && end <= m_size);
+	return cc0::slice<type_t>(m_values + start, (end - start));
 }
 
 template < typename type_t, uint64_t size_u >
+cc0::slice<const type_t> cc0::small_array<type_t,size_u>::operator()(uint64_t start, uint64_t end) const
+{
+	CC0_ARR_ASSERT(start <= end && end <= m_size);
+	return cc0::slice<const type_t>(m_values + start, (end - start));
+}
+
+template < typename type_t, uint64_t size_u >
+uint64_t cc0::small_array<type_t,size_u>::size( void ) const
+{
+	return m_size;
+}
+
+template < typename type_t, uint64_t size_u >
+uint64_t cc0::small_array<type_t,size_u>::capacity( void ) const
+{
+	return m_capacity;
+}
+
+template < typename type_t, uint64_t size_u >
+bool cc0::small_array<type_t,size_u>::is_small( void ) const
+{
+	return m_values == reinterpret_cast<const type_t*>(m_storage);
+}
+
+template < typename type_t >
+cc0::strided_slice<type_t>::strided_slice( void ) : m_values(nullptr), m_size(0), m_stride(1)
+{}
+
+template < typename type_t >
+cc0::strided_slice<type_t>::strided_slice(cc0::slice<type_t> arr) : m_values(arr), m_size(arr.size()), m_stride(1)
+{}
+
+template < typename type_t >
+cc0::strided_slice<type_t>::strided_slice(type_t *values, uint64_t size, uint64_t stride) : m_values(values), m_size(size), m_stride(stride)
+{}
+
+template < typename type_t >
 template < typename type2_t >
-cc0::array<type_t,size_u> &cc0::array<type_t,size_u>::operator=(const cc0::values<type2_t,size_u> &vals)
+cc0::strided_slice<type_t>::operator cc0::strided_slice<const type2_t>( void ) const
 {
-	copy(vals.v);
-	return *this;
+	return cc0::strided_slice<const type2_t>(m_values, m_size, m_stride);
+}
+
+template < typename type_t >
+type_t &cc0::strided_slice<type_t>::operator[](uint64_t i)
+{
+	CC0_ARR_ASSERT(i < m_size);
+	return m_values[i * m_stride];
+}
+
+template < typename type_t >
+const type_t &cc0::strided_slice<type_t>::operator[](uint64_t i) const
+{
+	CC0_ARR_ASSERT(i < m_size);
+	return m_values[i * m_stride];
+}
+
+template < typename type_t >
+cc0::strided_slice<type_t> cc0::strided_slice<type_t>::operator()(uint64_t start, uint64_t end)
+{
+	CC0_ARR_ASSERT(start <= end && end <= m_size);
+	return cc0::strided_slice<type_t>(m_values + start * m_stride, end - start, m_stride);
+}
+
+template < typename type_t >
+cc0::strided_slice<const type_t> cc0::strided_slice<type_t>::operator()(uint64_t start, uint64_t end) const
+{
+	CC0_ARR_ASSERT(start <= end && end <= m_size);
+	return cc0::strided_slice<const type_t>(m_values + start * m_stride, end - start, m_stride);
+}
+
+template < typename type_t >
+cc0::strided_slice<type_t> cc0::strided_slice<type_t>::operator()(uint64_t start, uint64_t end, uint64_t step)
+{
+	CC0_ARR_ASSERT(start <= end && end <= m_size && step > 0);
+	return cc0::strided_slice<type_t>(m_values + start * m_stride, (end - start + step - 1) / step, m_stride * step);
+}
+
+template < typename type_t >
+cc0::strided_slice<const type_t> cc0::strided_slice<type_t>::operator()(uint64_t start, uint64_t end, uint64_t step) const
+{
+	CC0_ARR_ASSERT(start <= end && end <= m_size && step > 0);
+	return cc0::strided_slice<const type_t>(m_values + start * m_stride, (end - start + step - 1) / step, m_stride * step);
+}
+
+template < typename type_t >
+bool cc0::strided_slice<type_t>::is_contiguous( void ) const
+{
+	return m_stride == 1 || m_size < 2;
+}
+
+template < typename type_t >
+cc0::slice<type_t> cc0::strided_slice<type_t>::contiguous( void )
+{
+	return cc0::slice<type_t>(m_values, m_size);
+}
+
+template < typename type_t >
+cc0::slice<const type_t> cc0::strided_slice<type_t>::contiguous( void ) const
+{
+	return cc0::slice<const type_t>(m_values, m_size);
+}
+
+template < typename type_t >
+uint64_t cc0::strided_slice<type_t>::size( void ) const
+{
+	return m_size;
+}
+
+template < typename type_t >
+uint64_t cc0::strided_slice<type_t>::stride( void ) const
+{
+	return m_stride;
+}
+
+template < typename type_t, uint64_t dims_u >
+uint64_t cc0::ndview<type_t,dims_u>::offset(const uint64_t (&index)[dims_u]) const
+{
+	uint64_t o = 0;
+	for (uint64_t d = 0; d < dims_u; ++d) {
+		o += index[d] * m_strides[d];
+	}
+	return o;
+}
+
+template < typename type_t, uint64_t dims_u >
+cc0::ndview<type_t,dims_u>::ndview( void ) : m_values(nullptr)
+{
+	for (uint64_t d = 0; d < dims_u; ++d) {
+		m_shape[d] = 0;
+		m_strides[d] = 0;
+	}
+}
+
+template < typename type_t, uint64_t dims_u >
+cc0::ndview<type_t,dims_u>::ndview(cc0::slice<type_t> arr, const uint64_t (&shape)[dims_u]) : m_values(arr)
+{
+	uint64_t stride = 1;
+	for (uint64_t d = dims_u; d > 0; --d) {
+		m_shape[d - 1] = shape[d - 1];
+		m_strides[d - 1] = stride;
+		stride *= shape[d - 1];
+	}
+}
+
+template < typename type_t, uint64_t dims_u >
+cc0::ndview<type_t,dims_u>::ndview(type_t *values, const uint64_t (&shape)[dims_u], const uint64_t (&strides)[dims_u]) : m_values(values)
+{
+	for (uint64_t d = 0; d < dims_u; ++d) {
+		m_shape[d] = shape[d];
+		m_strides[d] = strides[d];
+	}
+}
+
+template < typename type_t, uint64_t dims_u >
+template < typename type2_t >
+cc0::ndview<type_t,dims_u>::operator cc0::ndview<const type2_t,dims_u>( void ) const
+{
+	return cc0::ndview<const type2_t,dims_u>(m_values, m_shape, m_strides);
+}
+
+template < typename type_t, uint64_t dims_u >
+template < typename... index_t >
+type_t &cc0::ndview<type_t,dims_u>::at(index_t... index)
+{
+	static_assert(sizeof...(index_t) == dims_u, "The number of indices must match the number of dimensions.");
+	const uint64_t i[dims_u] = { uint64_t(index)... };
+#if defined(CC0_ARR_CHECKED)
+	for (uint64_t d = 0; d < dims_u; ++d) {
+		CC0_ARR_ASSERT(i[d] < m_shape[d]);
+	}
+#endif
+	return m_values[offset(i)];
+}
+
+template < typename type_t, uint64_t dims_u >
+template < typename... index_t >
+const type_t &cc0::ndview<type_t,dims_u>::at(index_t... index) const
+{
+	static_assert(sizeof...(index_t) == dims_u, "The number of indices must match the number of dimensions.");
+	const uint64_t i[dims_u] = { uint64_t(index)... };
+#if defined(CC0_ARR_CHECKED)
+	for (uint64_t d = 0; d < dims_u; ++d) {
+		CC0_ARR_ASSERT(i[d] < m_shape[d]);
+	}
+#endif
+	return m_values[offset(i)];
+}
+
+template < typename type_t, uint64_t dims_u >
+cc0::ndview<type_t,dims_u> cc0::ndview<type_t,dims_u>::operator()(const uint64_t (&start)[dims_u], const uint64_t (&end)[dims_u])
+{
+#if defined(CC0_ARR_CHECKED)
+	for (uint64_t d = 0; d < dims_u; ++d) {
+		CC0_ARR_ASSERT(start[d] <= end[d] && end[d] <= m_shape[d]);
+	}
+#endif
+	uint64_t shape[dims_u];
+	for (uint64_t d = 0; d < dims_u; ++d) {
+		shape[d] = end[d] - start[d];
+	}
+	return cc0::ndview<type_t,dims_u>(m_values + offset(start), shape, m_strides);
+}
+
+template < typename type_t, uint64_t dims_u >
+cc0::ndview<const type_t,dims_u> cc0::ndview<type_t,dims_u>::operator()(const uint64_t (&start)[dims_u], const uint64_t (&end)[dims_u]) const
+{
+#if defined(CC0_ARR_CHECKED)
+	for (uint64_t d = 0; d < dims_u; ++d) {
+		CC0_ARR_ASSERT(start[d] <= end[d] && end[d] <= m_shape[d]);
+	}
+#endif
+	uint64_t shape[dims_u];
+	for (uint64_t d = 0; d < dims_u; ++d) {
+		shape[d] = end[d] - start[d];
+	}
+	return cc0::ndview<const type_t,dims_u>(m_values + offset(start), shape, m_strides);
+}
+
+template < typename type_t, uint64_t dims_u >
+cc0::strided_slice<type_t> cc0::ndview<type_t,dims_u>::line(uint64_t dim, const uint64_t (&index)[dims_u])
+{
+	CC0_ARR_ASSERT(dim < dims_u);
+#if defined(CC0_ARR_CHECKED)
+	for (uint64_t d = 0; d < dims_u; ++d) {
+		CC0_ARR_ASSERT(index[d] < m_shape[d] || d == dim);
+	}
+#endif
+	uint64_t i[dims_u];
+	for (uint64_t d = 0; d < dims_u; ++d) {
+		i[d] = d != dim ? index[d] : 0;
+	}
+	return cc0::strided_slice<type_t>(m_values + offset(i), m_shape[dim], m_strides[dim]);
+}
+
+template < typename type_t, uint64_t dims_u >
+cc0::strided_slice<const type_t> cc0::ndview<type_t,dims_u>::line(uint64_t dim, const uint64_t (&index)[dims_u]) const
+{
+	CC0_ARR_ASSERT(dim < dims_u);
+#if defined(CC0_ARR_CHECKED)
+	for (uint64_t d = 0; d < dims_u; ++d) {
+		CC0_ARR_ASSERT(index[d] < m_shape[d] || d == dim);
+	}
+#endif
+	uint64_t i[dims_u];
+	for (uint64_t d = 0; d < dims_u; ++d) {
+		i[d] = d != dim ? index[d] : 0;
+	}
+	return cc0::strided_slice<const type_t>(m_values + offset(i), m_shape[dim], m_strides[dim]);
+}
+
+template < typename type_t, uint64_t dims_u >
+bool cc0::ndview<type_t,dims_u>::is_contiguous( void ) const
+{
+	uint64_t stride = 1;
+	for (uint64_t d = dims_u; d > 0; --d) {
+		if (m_shape[d - 1] == 0) {
+			return true;
+		}
+		if (m_shape[d - 1] > 1 && m_strides[d - 1] != stride) {
+			return false;
+		}
+		stride *= m_shape[d - 1];
+	}
+	return true;
+}
+
+template < typename type_t, uint64_t dims_u >
+uint64_t cc0::ndview<type_t,dims_u>::shape(uint64_t dim) const
+{
+	return m_shape[dim];
+}
+
+template < typename type_t, uint64_t dims_u >
+uint64_t cc0::ndview<type_t,dims_u>::stride(uint64_t dim) const
+{
+	return m_strides[dim];
+}
+
+template < typename type_t, uint64_t dims_u >
+uint64_t cc0::ndview<type_t,dims_u>::size( void ) const
+{
+	uint64_t n = 1;
+	for (uint64_t d = 0; d < dims_u; ++d) {
+		n *= m_shape[d];
+	}
+	return n;
 }
 
-template < typename type_t, uint64_t size_u >
-template < typename type2_t >
-cc0::array<type_t,size_u> &cc0::array<type_t,size_u>::operator=(const type2_t (&values)[size_u])
+template < typename type_t, uint64_t align_u >
+cc0::aligned_slice<type_t,align_u>::aligned_slice( void ) : cc0::slice<type_t>()
+{}
+
+template < typename type_t, uint64_t align_u >
+template < typename type2_t, uint64_t align2_u >
+cc0::aligned_slice<type_t,align_u>::aligned_slice(const cc0::aligned_slice<type2_t,align2_u> &arr) : cc0::slice<type_t>(arr)
 {
-	copy(values);
-	return *this;
+	static_assert(align2_u >= align_u, "the alignment of the slice is weaker than the alignment of the aligned slice");
 }
 
-template < typename type_t, uint64_t size_u >
-cc0::array<type_t,size_u>::operator type_t*( void )
+template < typename type_t, uint64_t align_u >
+template < typename type2_t, uint64_t size_u, uint64_t align2_u >
+cc0::aligned_slice<type_t,align_u>::aligned_slice(cc0::array<type2_t,size_u,align2_u> &arr) : cc0::slice<type_t>(static_cast<type2_t*>(arr), arr.size())
 {
-	return m_values;
+	static_assert(align2_u >= align_u, "the alignment of the array is weaker than the alignment of the aligned slice");
 }
 
-template < typename type_t, uint64_t size_u >
-cc0::array<type_t,size_u>::operator const type_t*( void ) const
+template < typename type_t, uint64_t align_u >
+template < typename type2_t, uint64_t size_u, uint64_t align2_u >
+cc0::aligned_slice<type_t,align_u>::aligned_slice(const cc0::array<type2_t,size_u,align2_u> &arr) : cc0::slice<type_t>(static_cast<const type2_t*>(arr), arr.size())
 {
-	return m_values;
+	static_assert(align2_u >= align_u, "the alignment of the array is weaker than the alignment of the aligned slice");
 }
 
-template < typename type_t, uint64_t size_u >
+template < typename type_t, uint64_t align_u >
 template < typename type2_t >
-cc0::array<type_t,size_u>::operator cc0::slice<type2_t>( void )
+cc0::aligned_slice<type_t,align_u>::aligned_slice(type2_t *values, uint64_t size) : cc0::slice<type_t>(values, size)
+{}
+
+template < typename type_t, uint64_t align_u >
+cc0::aligned_slice<type_t,align_u>::operator type_t*( void )
 {
-	return cc0::slice<type2_t>(m_values);
+#if defined(__GNUC__) || defined(__clang__)
+	return static_cast<type_t*>(__builtin_assume_aligned(this->m_values, align_u));
+#else
+	return this->m_values;
+#endif
 }
 
-template < typename type_t, uint64_t size_u >
-cc0::array<type_t,size_u>::operator cc0::slice<type_t>( void )
+template < typename type_t, uint64_t align_u >
+cc0::aligned_slice<type_t,align_u>::operator const type_t*( void ) const
 {
-	return cc0::slice<type_t>(m_values);
+#if defined(__GNUC__) || defined(__clang__)
+	return static_cast<const type_t*>(__builtin_assume_aligned(this->m_values, align_u));
+#else
+	return this->m_values;
+#endif
 }
 
-template < typename type_t, uint64_t size_u >
-template < typename type2_t >
-cc0::array<type_t,size_u>::operator const cc0::slice<const type2_t>( void ) const
+template < typename type_t, typename type2_t >
+cc0::slice<type_t> cc0::view(type2_t *values, uint64_t start, uint64_t end)
 {
-	return cc0::slice<const type2_t>(m_values);
+	CC0_ARR_ASSERT(start <= end);
+	return cc0::slice<type_t>(values + start, (end - start));
 }
 
-template < typename type_t, uint64_t size_u >
-cc0::array<type_t,size_u>::operator const cc0::slice<const type_t>( void ) const
+template < typename type_t, typename type2_t >
+cc0::slice<const type_t> cc0::view(const type2_t *values, uint64_t start, uint64_t end)
 {
-	return cc0::slice<const type_t>(m_values);
+	CC0_ARR_ASSERT(start <= end);
+	return cc0::slice<const type_t>(values + start, (end - start));
 }
 
-template < typename type_t, uint64_t size_u >
-cc0::slice<type_t> cc0::array<type_t,size_u>::operator()(uint64_t start, uint64_t end)
+template < typename type_t, typename type2_t >
+cc0::slice<type_t> cc0::view(type2_t *values, uint64_t count)
 {
-	return cc0::slice<type_t>(m_values + start, (end - start));
+	return cc0::slice<type_t>(values, count);
 }
 
-template < typename type_t, uint64_t size_u >
-cc0::slice<const type_t> cc0::array<type_t,size_u>::operator()(uint64_t start, uint64_t end) const
+template < typename type_t, typename type2_t >
+cc0::slice<const type_t> cc0::view(const type2_t *values, uint64_t count)
 {
-	return cc0::slice<const type_t>(m_values + start, (end - start));
+	return cc0::slice<const type_t>(values, count);
 }
 
-template < typename type_t, uint64_t size_u >
-uint64_t cc0::array<type_t,size_u>::size( void ) const
+namespace cc0
 {
-	return size_u;
+	namespace internal
+	{
+		template < typename type_t >
+		struct is_byte : std::integral_constant<bool, sizeof(type_t) == 1 && std::is_integral<type_t>::value> {};
+
+		template < typename type_t, typename type2_t >
+		struct is_bitwise_comparable : std::integral_constant<bool, std::is_same<typename std::remove_cv<type_t>::type, typename std::remove_cv<type2_t>::type>::value && (std::is_integral<type_t>::value || std::is_enum<type_t>::value || std::is_pointer<type_t>::value)> {};
+
+		// The SIMD kernels behind bulk operations. Each is implemented once per instruction set variant, and is either dispatched at runtime or bound to the compiled-for variant.
+#if defined(CC0_ARR_DISPATCH) || defined(__SSE2__)
+		void fill_blocks(void *dst, uint64_t blocks, const void *pattern);
+		float min_float(const float *src, uint64_t count);
+		float max_float(const float *src, uint64_t count);
+		float sum_float(const float *src, uint64_t count);
+#endif
+#if defined(CC0_ARR_DISPATCH) || (defined(__SSE2__) && (defined(__GNUC__) || defined(__clang__)))
+		uint64_t count_bytes(const uint8_t *src, uint64_t count, uint8_t value);
+		uint64_t find_int32(const int32_t *src, uint64_t count, int32_t value);
+#endif
+#if defined(CC0_ARR_DISPATCH)
+		double sum_double(const double *src, uint64_t count);
+#endif
+
+		template < typename type_t >
+		void fill(type_t *dst, uint64_t count, const type_t &value, std::false_type)
+		{
+			for (uint64_t i = 0; i < count; ++i) {
+				dst[i] = value;
+			}
+		}
+
+		template < typename type_t >
+		void fill(type_t *dst, uint64_t count, const type_t &value, std::true_type)
+		{
+			unsigned char bytes[sizeof(type_t)];
+			memcpy(bytes, &value, sizeof(type_t));
+			bool uniform = true;
+			for (uint64_t i = 1; i < sizeof(type_t) && uniform; ++i) {
+				uniform = bytes[i] == bytes[0];
+			}
+			if (uniform) {
+				if (count > 0) {
+					memset(dst, bytes[0], count * sizeof(type_t));
+				}
+				return;
+			}
+			uint64_t i = 0;
+#if defined(CC0_ARR_DISPATCH) || defined(__SSE2__)
+			if (16 % sizeof(type_t) == 0) {
+				unsigned char pattern[16];
+				for (uint64_t j = 0; j < 16; j += sizeof(type_t)) {
+					memcpy(pattern + j, bytes, sizeof(type_t));
+				}
+				const uint64_t lanes = 16 / sizeof(type_t);
+				cc0::internal::fill_blocks(dst, count / lanes, pattern);
+				i = count / lanes * lanes;
+			}
+#endif
+			for (; i < count; ++i) {
+				dst[i] = value;
+			}
+		}
+
+		template < typename type_t, typename type2_t >
+		void move(type_t *dst, type2_t *src, uint64_t count, std::true_type)
+		{
+			if (count > 0) {
+				memmove(dst, src, count * sizeof(type_t));
+			}
+		}
+
+		template < typename type_t, typename type2_t >
+		void move(type_t *dst, type2_t *src, uint64_t count, std::false_type)
+		{
+			for (uint64_t i = 0; i < count; ++i) {
+				dst[i] = std::move(src[i]);
+			}
+		}
+
+		template < typename type_t, typename type2_t >
+		bool equal(const type_t *a, const type2_t *b, uint64_t count, std::true_type)
+		{
+			return count == 0 || memcmp(a, b, count * sizeof(type_t)) == 0;
+		}
+
+		template < typename type_t, typename type2_t >
+		bool equal(const type_t *a, const type2_t *b, uint64_t count, std::false_type)
+		{
+			for (uint64_t i = 0; i < count; ++i) {
+				if (!(a[i] == b[i])) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+		template < typename type_t >
+		uint64_t find(const type_t *src, uint64_t count, const type_t &value, std::true_type)
+		{
+			const void *p = count > 0 ? memchr(src, static_cast<unsigned char>(value), count) : nullptr;
+			return p != nullptr ? uint64_t(static_cast<const type_t*>(p) - src) : count;
+		}
+
+		template < typename type_t >
+		uint64_t find(const type_t *src, uint64_t count, const type_t &value, std::false_type)
+		{
+			for (uint64_t i = 0; i < count; ++i) {
+				if (src[i] == value) {
+					return i;
+				}
+			}
+			return count;
+		}
+
+#if defined(CC0_ARR_DISPATCH) || (defined(__SSE2__) && (defined(__GNUC__) || defined(__clang__)))
+		inline uint64_t find(const int32_t *src, uint64_t count, const int32_t &value, std::false_type)
+		{
+			return cc0::internal::find_int32(src, count, value);
+		}
+
+		inline uint64_t find(const uint32_t *src, uint64_t count, const uint32_t &value, std::false_type)
+		{
+			const int32_t word = static_cast<int32_t>(value);
+			return cc0::internal::find(reinterpret_cast<const int32_t*>(src), count, word, std::false_type());
+		}
+#endif
+
+		template < typename type_t >
+		uint64_t count(const type_t *src, uint64_t count, const type_t &value, std::true_type)
+		{
+#if defined(CC0_ARR_DISPATCH) || (defined(__SSE2__) && (defined(__GNUC__) || defined(__clang__)))
+			return cc0::internal::count_bytes(reinterpret_cast<const uint8_t*>(src), count, static_cast<uint8_t>(value));
+#else
+			uint64_t n = 0;
+			for (uint64_t i = 0; i < count; ++i) {
+				n += src[i] == value ? 1 : 0;
+			}
+			return n;
+#endif
+		}
+
+		template < typename type_t >
+		uint64_t count(const type_t *src, uint64_t count, const type_t &value, std::false_type)
+		{
+			uint64_t n = 0;
+			for (uint64_t i = 0; i < count; ++i) {
+				n += src[i] == value ? 1 : 0;
+			}
+			return n;
+		}
+
+		template < typename type_t >
+		type_t min(const type_t *src, uint64_t count)
+		{
+			type_t m = src[0];
+			for (uint64_t i = 1; i < count; ++i) {
+				if (src[i] < m) {
+					m = src[i];
+				}
+			}
+			return m;
+		}
+
+		template < typename type_t >
+		type_t max(const type_t *src, uint64_t count)
+		{
+			type_t m = src[0];
+			for (uint64_t i = 1; i < count; ++i) {
+				if (m < src[i]) {
+					m = src[i];
+				}
+			}
+			return m;
+		}
+
+		template < typename type_t >
+		type_t sum(const type_t *src, uint64_t count)
+		{
+			// Independent accumulators break the dependency chain between additions.
+			type_t s[4] = { type_t(), type_t(), type_t(), type_t() };
+			uint64_t i = 0;
+			for (; i + 4 <= count; i += 4) {
+				s[0] = s[0] + src[i];
+				s[1] = s[1] + src[i + 1];
+				s[2] = s[2] + src[i + 2];
+				s[3] = s[3] + src[i + 3];
+			}
+			for (; i < count; ++i) {
+				s[0] = s[0] + src[i];
+			}
+			return (s[0] + s[1]) + (s[2] + s[3]);
+		}
+
+#if defined(__SSE2__)
+		namespace sse2
+		{
+			inline void fill_blocks(void *dst, uint64_t blocks, const void *pattern)
+			{
+				const __m128i v = _mm_loadu_si128(static_cast<const __m128i*>(pattern));
+				unsigned char *out = static_cast<unsigned char*>(dst);
+				uint64_t i = 0;
+				for (; i + 2 <= blocks; i += 2) {
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 16), v);
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 16 + 16), v);
+				}
+				if (i < blocks) {
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 16), v);
+				}
+			}
+
+			inline float min_float(const float *src, uint64_t count)
+			{
+				uint64_t i = 0;
+				float m = src[0];
+				if (count >= 4) {
+					__m128 v = _mm_loadu_ps(src);
+					for (i = 4; i + 4 <= count; i += 4) {
+						v = _mm_min_ps(v, _mm_loadu_ps(src + i));
+					}
+					v = _mm_min_ps(v, _mm_movehl_ps(v, v));
+					v = _mm_min_ss(v, _mm_shuffle_ps(v, v, 1));
+					m = _mm_cvtss_f32(v);
+				}
+				for (; i < count; ++i) {
+					m = src[i] < m ? src[i] : m;
+				}
+				return m;
+			}
+
+			inline float max_float(const float *src, uint64_t count)
+			{
+				uint64_t i = 0;
+				float m = src[0];
+				if (count >= 4) {
+					__m128 v = _mm_loadu_ps(src);
+					for (i = 4; i + 4 <= count; i += 4) {
+						v = _mm_max_ps(v, _mm_loadu_ps(src + i));
+					}
+					v = _mm_max_ps(v, _mm_movehl_ps(v, v));
+					v = _mm_max_ss(v, _mm_shuffle_ps(v, v, 1));
+					m = _mm_cvtss_f32(v);
+				}
+				for (; i < count; ++i) {
+					m = m < src[i] ? src[i] : m;
+				}
+				return m;
+			}
+
+			inline float sum_float(const float *src, uint64_t count)
+			{
+				__m128 s0 = _mm_setzero_ps();
+				__m128 s1 = _mm_setzero_ps();
+				uint64_t i = 0;
+				for (; i + 8 <= count; i += 8) {
+					s0 = _mm_add_ps(s0, _mm_loadu_ps(src + i));
+					s1 = _mm_add_ps(s1, _mm_loadu_ps(src + i + 4));
+				}
+				s0 = _mm_add_ps(s0, s1);
+				s0 = _mm_add_ps(s0, _mm_movehl_ps(s0, s0));
+				s0 = _mm_add_ss(s0, _mm_shuffle_ps(s0, s0, 1));
+				float s = _mm_cvtss_f32(s0);
+				for (; i < count; ++i) {
+					s += src[i];
+				}
+				return s;
+			}
+
+			inline double sum_double(const double *src, uint64_t count)
+			{
+				__m128d s0 = _mm_setzero_pd();
+				__m128d s1 = _mm_setzero_pd();
+				uint64_t i = 0;
+				for (; i + 4 <= count; i += 4) {
+					s0 = _mm_add_pd(s0, _mm_loadu_pd(src + i));
+					s1 = _mm_add_pd(s1, _mm_loadu_pd(src + i + 2));
+				}
+				s0 = _mm_add_pd(s0, s1);
+				s0 = _mm_add_sd(s0, _mm_unpackhi_pd(s0, s0));
+				double s = _mm_cvtsd_f64(s0);
+				for (; i < count; ++i) {
+					s += src[i];
+				}
+				return s;
+			}
+
+	#if defined(__GNUC__) || defined(__clang__)
+			inline uint64_t count_bytes(const uint8_t *src, uint64_t count, uint8_t value)
+			{
+				const __m128i v = _mm_set1_epi8(static_cast<char>(value));
+				uint64_t n = 0;
+				uint64_t i = 0;
+				for (; i + 16 <= count; i += 16) {
+					n += uint64_t(__builtin_popcount(static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)), v)))));
+				}
+				for (; i < count; ++i) {
+					n += src[i] == value ? 1 : 0;
+				}
+				return n;
+			}
+
+			inline uint64_t find_int32(const int32_t *src, uint64_t count, int32_t value)
+			{
+				const __m128i v = _mm_set1_epi32(value);
+				uint64_t i = 0;
+				for (; i + 4 <= count; i += 4) {
+					const int mask = _mm_movemask_epi8(_mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)), v));
+					if (mask != 0) {
+						return i + uint64_t(__builtin_ctz(static_cast<unsigned int>(mask))) / 4;
+					}
+				}
+				for (; i < count; ++i) {
+					if (src[i] == value) {
+						return i;
+					}
+				}
+				return count;
+			}
+	#endif
+		}
+#endif
+
+#if defined(CC0_ARR_DISPATCH)
+		namespace scalar
+		{
+			inline void fill_blocks(void *dst, uint64_t blocks, const void *pattern)
+			{
+				unsigned char *out = static_cast<unsigned char*>(dst);
+				for (uint64_t i = 0; i < blocks; ++i) {
+					memcpy(out + i * 16, pattern, 16);
+				}
+			}
+
+			inline float min_float(const float *src, uint64_t count)
+			{
+				return cc0::internal::min<float>(src, count);
+			}
+
+			inline float max_float(const float *src, uint64_t count)
+			{
+				return cc0::internal::max<float>(src, count);
+			}
+
+			inline float sum_float(const float *src, uint64_t count)
+			{
+				return cc0::internal::sum<float>(src, count);
+			}
+
+			inline double sum_double(const double *src, uint64_t count)
+			{
+				return cc0::internal::sum<double>(src, count);
+			}
+
+			inline uint64_t count_bytes(const uint8_t *src, uint64_t count, uint8_t value)
+			{
+				return cc0::internal::count<uint8_t>(src, count, value, std::false_type());
+			}
+
+			inline uint64_t find_int32(const int32_t *src, uint64_t count, int32_t value)
+			{
+				return cc0::internal::find<int32_t>(src, count, value, std::false_type());
+			}
+		}
+
+	#if defined(CC0_ARR_DISPATCH_X86)
+		// The wider variants are compiled for their instruction sets regardless of the compiler flags, and are only called if the CPU supports them.
+		namespace avx2
+		{
+			__attribute__((target("avx2"))) inline void fill_blocks(void *dst, uint64_t blocks, const void *pattern)
+			{
+				const __m256i v = _mm256_broadcastsi128_si256(_mm_loadu_si128(static_cast<const __m128i*>(pattern)));
+				unsigned char *out = static_cast<unsigned char*>(dst);
+				uint64_t i = 0;
+				for (; i + 4 <= blocks; i += 4) {
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i * 16), v);
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i * 16 + 32), v);
+				}
+				for (; i < blocks; ++i) {
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 16), _mm256_castsi256_si128(v));
+				}
+			}
+
+			__attribute__((target("avx2"))) inline float min_float(const float *src, uint64_t count)
+			{
+				__m256 v = _mm256_set1_ps(src[0]);
+				uint64_t i = 0;
+				for (; i + 8 <= count; i += 8) {
+					v = _mm256_min_ps(v, _mm256_loadu_ps(src + i));
+				}
+				__m128 h = _mm_min_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+				h = _mm_min_ps(h, _mm_movehl_ps(h, h));
+				h = _mm_min_ss(h, _mm_shuffle_ps(h, h, 1));
+				float m = _mm_cvtss_f32(h);
+				for (; i < count; ++i) {
+					m = src[i] < m ? src[i] : m;
+				}
+				return m;
+			}
+
+			__attribute__((target("avx2"))) inline float max_float(const float *src, uint64_t count)
+			{
+				__m256 v = _mm256_set1_ps(src[0]);
+				uint64_t i = 0;
+				for (; i + 8 <= count; i += 8) {
+					v = _mm256_max_ps(v, _mm256_loadu_ps(src + i));
+				}
+				__m128 h = _mm_max_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+				h = _mm_max_ps(h, _mm_movehl_ps(h, h));
+				h = _mm_max_ss(h, _mm_shuffle_ps(h, h, 1));
+				float m = _mm_cvtss_f32(h);
+				for (; i < count; ++i) {
+					m = m < src[i] ? src[i] : m;
+				}
+				return m;
+			}
+
+			__attribute__((target("avx2"))) inline float sum_float(const float *src, uint64_t count)
+			{
+				__m256 s0 = _mm256_setzero_ps();
+				__m256 s1 = _mm256_setzero_ps();
+				uint64_t i = 0;
+				for (; i + 16 <= count; i += 16) {
+					s0 = _mm256_add_ps(s0, _mm256_loadu_ps(src + i));
+					s1 = _mm256_add_ps(s1, _mm256_loadu_ps(src + i + 8));
+				}
+				s0 = _mm256_add_ps(s0, s1);
+				__m128 h = _mm_add_ps(_mm256_castps256_ps128(s0), _mm256_extractf128_ps(s0, 1));
+				h = _mm_add_ps(h, _mm_movehl_ps(h, h));
+				h = _mm_add_ss(h, _mm_shuffle_ps(h, h, 1));
+				float s = _mm_cvtss_f32(h);
+				for (; i < count; ++i) {
+					s += src[i];
+				}
+				return s;
+			}
+
+			__attribute__((target("avx2"))) inline double sum_double(const double *src, uint64_t count)
+			{
+				__m256d s0 = _mm256_setzero_pd();
+				__m256d s1 = _mm256_setzero_pd();
+				uint64_t i = 0;
+				for (; i + 8 <= count; i += 8) {
+					s0 = _mm256_add_pd(s0, _mm256_loadu_pd(src + i));
+					s1 = _mm256_add_pd(s1, _mm256_loadu_pd(src + i + 4));
+				}
+				s0 = _mm256_add_pd(s0, s1);
+				__m128d h = _mm_add_pd(_mm256_castpd256_pd128(s0), _mm256_extractf128_pd(s0, 1));
+				h = _mm_add_sd(h, _mm_unpackhi_pd(h, h));
+				double s = _mm_cvtsd_f64(h);
+				for (; i < count; ++i) {
+					s += src[i];
+				}
+				return s;
+			}
+
+			__attribute__((target("avx2,popcnt"))) inline uint64_t count_bytes(const uint8_t *src, uint64_t count, uint8_t value)
+			{
+				const __m256i v = _mm256_set1_epi8(static_cast<char>(value));
+				uint64_t n = 0;
+				uint64_t i = 0;
+				for (; i + 32 <= count; i += 32) {
+					n += uint64_t(__builtin_popcount(static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i)), v)))));
+				}
+				for (; i < count; ++i) {
+					n += src[i] == value ? 1 : 0;
+				}
+				return n;
+			}
+
+			__attribute__((target("avx2"))) inline uint64_t find_int32(const int32_t *src, uint64_t count, int32_t value)
+			{
+				const __m256i v = _mm256_set1_epi32(value);
+				uint64_t i = 0;
+				for (; i + 8 <= count; i += 8) {
+					const int mask = _mm256_movemask_epi8(_mm256_cmpeq_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i)), v));
+					if (mask != 0) {
+						return i + uint64_t(__builtin_ctz(static_cast<unsigned int>(mask))) / 4;
+					}
+				}
+				for (; i < count; ++i) {
+					if (src[i] == value) {
+						return i;
+					}
+				}
+				return count;
+			}
+		}
+
+		// Some versions of GCC warn about the deliberately undefined vectors used within their own AVX-512 intrinsics.
+		#if defined(__GNUC__) && !defined(__clang__)
+			#pragma GCC diagnostic push
+			#pragma GCC diagnostic ignored "-Wuninitialized"
+			#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+		#endif
+		namespace avx512
+		{
+			// Tails are handled with masked loads, which never touch memory in masked-out lanes.
+			__attribute__((target("avx512f,avx512bw"))) inline void fill_blocks(void *dst, uint64_t blocks, const void *pattern)
+			{
+				const __m512i v = _mm512_broadcast_i32x4(_mm_loadu_si128(static_cast<const __m128i*>(pattern)));
+				unsigned char *out = static_cast<unsigned char*>(dst);
+				uint64_t i = 0;
+				for (; i + 4 <= blocks; i += 4) {
+					_mm512_storeu_si512(out + i * 16, v);
+				}
+				if (i < blocks) {
+					_mm512_mask_storeu_epi64(out + i * 16, static_cast<__mmask8>((1u << ((blocks - i) * 2)) - 1), v);
+				}
+			}
+
+			__attribute__((target("avx512f,avx512bw"))) inline float min_float(const float *src, uint64_t count)
+			{
+				__m512 v = _mm512_set1_ps(src[0]);
+				uint64_t i = 0;
+				for (; i + 16 <= count; i += 16) {
+					v = _mm512_min_ps(v, _mm512_loadu_ps(src + i));
+				}
+				if (i < count) {
+					v = _mm512_min_ps(v, _mm512_mask_loadu_ps(v, static_cast<__mmask16>((1u << (count - i)) - 1), src + i));
+				}
+				return _mm512_reduce_min_ps(v);
+			}
+
+			__attribute__((target("avx512f,avx512bw"))) inline float max_float(const float *src, uint64_t count)
+			{
+				__m512 v = _mm512_set1_ps(src[0]);
+				uint64_t i = 0;
+				for (; i + 16 <= count; i += 16) {
+					v = _mm512_max_ps(v, _mm512_loadu_ps(src + i));
+				}
+				if (i < count) {
+					v = _mm512_max_ps(v, _mm512_mask_loadu_ps(v, static_cast<__mmask16>((1u << (count - i)) - 1), src + i));
+				}
+				return _mm512_reduce_max_ps(v);
+			}
+
+			__attribute__((target("avx512f,avx512bw"))) inline float sum_float(const float *src, uint64_t count)
+			{
+				__m512 s0 = _mm512_setzero_ps();
+				__m512 s1 = _mm512_setzero_ps();
+				uint64_t i = 0;
+				for (; i + 32 <= count; i += 32) {
+					s0 = _mm512_add_ps(s0, _mm512_loadu_ps(src + i));
+					s1 = _mm512_add_ps(s1, _mm512_loadu_ps(src + i + 16));
+				}
+				for (; i < count; i += 16) {
+					const uint64_t left = count - i;
+					s0 = _mm512_add_ps(s0, _mm512_maskz_loadu_ps(static_cast<__mmask16>(left >= 16 ? 0xFFFF : (1u << left) - 1), src + i));
+				}
+				return _mm512_reduce_add_ps(_mm512_add_ps(s0, s1));
+			}
+
+			__attribute__((target("avx512f,avx512bw"))) inline double sum_double(const double *src, uint64_t count)
+			{
+				__m512d s0 = _mm512_setzero_pd();
+				__m512d s1 = _mm512_setzero_pd();
+				uint64_t i = 0;
+				for (; i + 16 <= count; i += 16) {
+					s0 = _mm512_add_pd(s0, _mm512_loadu_pd(src + i));
+					s1 = _mm512_add_pd(s1, _mm512_loadu_pd(src + i + 8));
+				}
+				for (; i < count; i += 8) {
+					const uint64_t left = count - i;
+					s0 = _mm512_add_pd(s0, _mm512_maskz_loadu_pd(static_cast<__mmask8>(left >= 8 ? 0xFF : (1u << left) - 1), src + i));
+				}
+				return _mm512_reduce_add_pd(_mm512_add_pd(s0, s1));
+			}
+
+			__attribute__((target("avx512f,avx512bw,popcnt"))) inline uint64_t count_bytes(const uint8_t *src, uint64_t count, uint8_t value)
+			{
+				const __m512i v = _mm512_set1_epi8(static_cast<char>(value));
+				uint64_t n = 0;
+				uint64_t i = 0;
+				for (; i + 64 <= count; i += 64) {
+					n += uint64_t(__builtin_popcountll(_mm512_cmpeq_epi8_mask(_mm512_loadu_si512(src + i), v)));
+				}
+				if (i < count) {
+					const __mmask64 lanes = (uint64_t(1) << (count - i)) - 1;
+					n += uint64_t(__builtin_popcountll(_mm512_mask_cmpeq_epi8_mask(lanes, _mm512_maskz_loadu_epi8(lanes, src + i), v)));
+				}
+				return n;
+			}
+
+			__attribute__((target("avx512f,avx512bw"))) inline uint64_t find_int32(const int32_t *src, uint64_t count, int32_t value)
+			{
+				const __m512i v = _mm512_set1_epi32(value);
+				uint64_t i = 0;
+				for (; i + 16 <= count; i += 16) {
+					const __mmask16 mask = _mm512_cmpeq_epi32_mask(_mm512_loadu_si512(src + i), v);
+					if (mask != 0) {
+						return i + uint64_t(__builtin_ctz(static_cast<unsigned int>(mask)));
+					}
+				}
+				if (i < count) {
+					const __mmask16 lanes = static_cast<__mmask16>((1u << (count - i)) - 1);
+					const __mmask16 mask = _mm512_mask_cmpeq_epi32_mask(lanes, _mm512_maskz_loadu_epi32(lanes, src + i), v);
+					if (mask != 0) {
+						return i + uint64_t(__builtin_ctz(static_cast<unsigned int>(mask)));
+					}
+				}
+				return count;
+			}
+		}
+		#if defined(__GNUC__) && !defined(__clang__)
+			#pragma GCC diagnostic pop
+		#endif
+	#endif
+
+		/// @brief The kernels of an instruction set variant.
+		struct kernel_table
+		{
+			cc0::isa   isa;
+			void     (*fill_blocks)(void*, uint64_t, const void*);
+			float    (*min_float)(const float*, uint64_t);
+			float    (*max_float)(const float*, uint64_t);
+			float    (*sum_float)(const float*, uint64_t);
+			double   (*sum_double)(const double*, uint64_t);
+			uint64_t (*count_bytes)(const uint8_t*, uint64_t, uint8_t);
+			uint64_t (*find_int32)(const int32_t*, uint64_t, int32_t);
+		};
+
+		/// @brief Gets the kernels of an instruction set variant.
+		/// @param isa The variant.
+		/// @return The kernels, or null if the variant is not compiled in.
+		const cc0::internal::kernel_table *kernel_table_for(cc0::isa isa);
+
+		/// @brief Checks if the CPU supports an instruction set variant.
+		/// @param isa The variant.
+		/// @return True if the CPU, and the operating system, support the variant.
+		bool cpu_supports(cc0::isa isa);
+
+		/// @brief Selects the variant to dispatch to until changed by set_isa.
+		/// @return The variant named by the CC0_ARR_ISA environment variable if supported, and otherwise the detected variant.
+		cc0::isa initial_isa( void );
+
+		/// @brief Returns the storage of the active kernels, which are selected the first time this is called.
+		/// @return A reference to the active kernels.
+		std::atomic<const cc0::internal::kernel_table*> &active_kernels( void );
+#endif
+
+#if defined(CC0_ARR_DISPATCH) || defined(__SSE2__)
+		inline float min(const float *src, uint64_t count)
+		{
+			return cc0::internal::min_float(src, count);
+		}
+
+		inline float max(const float *src, uint64_t count)
+		{
+			return cc0::internal::max_float(src, count);
+		}
+
+		inline float sum(const float *src, uint64_t count)
+		{
+			return cc0::internal::sum_float(src, count);
+		}
+#endif
+#if defined(CC0_ARR_DISPATCH)
+		inline double sum(const double *src, uint64_t count)
+		{
+			return cc0::internal::sum_double(src, count);
+		}
+#endif
+	}
 }
 
-template < typename type_t >
-template < typename type2_t >
-void cc0::array<type_t>::copy(const type2_t *values, uint64_t size, bool use_pool)
+#if defined(CC0_ARR_DISPATCH)
+inline const cc0::internal::kernel_table *cc0::internal::kernel_table_for(cc0::isa isa)
 {
-	create(size, use_pool);
-	for (uint64_t i = 0; i < m_size; ++i) {
-		m_values[i] = values[i];
+	namespace ci = cc0::internal;
+	switch (isa) {
+	case cc0::isa_scalar: {
+		static const ci::kernel_table table = { cc0::isa_scalar, ci::scalar::fill_blocks, ci::scalar::min_float, ci::scalar::max_float, ci::scalar::sum_float, ci::scalar::sum_double, ci::scalar::count_bytes, ci::scalar::find_int32 };
+		return &table;
+	}
+	#if defined(__SSE2__) && (defined(__GNUC__) || defined(__clang__))
+	case cc0::isa_sse2: {
+		static const ci::kernel_table table = { cc0::isa_sse2, ci::sse2::fill_blocks, ci::sse2::min_float, ci::sse2::max_float, ci::sse2::sum_float, ci::sse2::sum_double, ci::sse2::count_bytes, ci::sse2::find_int32 };
+		return &table;
+	}
+	#endif
+	#if defined(CC0_ARR_DISPATCH_X86)
+	case cc0::isa_avx2: {
+		static const ci::kernel_table table = { cc0::isa_avx2, ci::avx2::fill_blocks, ci::avx2::min_float, ci::avx2::max_float, ci::avx2::sum_float, ci::avx2::sum_double, ci::avx2::count_bytes, ci::avx2::find_int32 };
+		return &table;
+	}
+	case cc0::isa_avx512: {
+		static const ci::kernel_table table = { cc0::isa_avx512, ci::avx512::fill_blocks, ci::avx512::min_float, ci::avx512::max_float, ci::avx512::sum_float, ci::avx512::sum_double, ci::avx512::count_bytes, ci::avx512::find_int32 };
+		return &table;
+	}
+	#endif
+	default:
+		return nullptr;
 	}
 }
 
-template < typename type_t >
-cc0::array<type_t>::array( void ) : m_values(nullptr), m_size(0), m_capacity(0)
-{}
-
-template < typename type_t >
-template < typename type2_t, uint64_t size_u >
-cc0::array<type_t>::array(const type2_t (&values)[size_u]) : array()
+inline bool cc0::internal::cpu_supports(cc0::isa isa)
 {
-	copy<type2_t>(values, size_u, false);
+	#if defined(CC0_ARR_DISPATCH_X86)
+	// Also checks that the operating system saves the wider registers on context switches.
+	__builtin_cpu_init();
+	switch (isa) {
+	case cc0::isa_sse2:   return __builtin_cpu_supports("sse2");
+	case cc0::isa_avx2:   return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt");
+	case cc0::isa_avx512: return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("popcnt");
+	default:              break;
+	}
+	#endif
+	return isa == cc0::isa_scalar;
 }
 
-template < typename type_t >
-template < typename type2_t >
-cc0::array<type_t>::array(cc0::array<type2_t> &&arr) : m_values(arr), m_size(arr.m_size), m_capacity(arr.m_capacity)
+inline cc0::isa cc0::internal::initial_isa( void )
 {
-	arr.m_values = nullptr;
-	arr.m_size = 0;
-	arr.m_capacity = 0;
+	const char *name = std::getenv("CC0_ARR_ISA");
+	if (name != nullptr) {
+		for (uint64_t i = 0; i < cc0::isa_count; ++i) {
+			if (strcmp(name, cc0::isa_name(cc0::isa(i))) == 0 && cc0::isa_supported(cc0::isa(i))) {
+				return cc0::isa(i);
+			}
+		}
+	}
+	return cc0::detected_isa();
 }
 
-template < typename type_t >
-cc0::array<type_t>::array(cc0::array<type_t> &&arr) : m_values(arr), m_size(arr.m_size), m_capacity(arr.m_capacity)
+inline std::atomic<const cc0::internal::kernel_table*> &cc0::internal::active_kernels( void )
 {
-	arr.m_values = nullptr;
-	arr.m_size = 0;
-	arr.m_capacity = 0;
+	static std::atomic<const cc0::internal::kernel_table*> active(cc0::internal::kernel_table_for(cc0::internal::initial_isa()));
+	return active;
 }
 
-template < typename type_t >
-cc0::array<type_t>::array(uint64_t size) : array()
+inline void cc0::internal::fill_blocks(void *dst, uint64_t blocks, const void *pattern)
 {
-	create(size, false);
+	cc0::internal::active_kernels().load(std::memory_order_relaxed)->fill_blocks(dst, blocks, pattern);
 }
 
-template < typename type_t >
-template < typename type2_t >
-cc0::array<type_t>::array(const cc0::array<type2_t> &arr) : array()
+inline float cc0::internal::min_float(const float *src, uint64_t count)
 {
-	copy<type2_t>(arr, arr.size(), true);
+	return cc0::internal::active_kernels().load(std::memory_order_relaxed)->min_float(src, count);
 }
 
-template < typename type_t >
-cc0::array<type_t>::array(const cc0::array<type_t> &arr) : array()
+inline float cc0::internal::max_float(const float *src, uint64_t count)
 {
-	copy<type_t>(arr, arr.size(), true);
+	return cc0::internal::active_kernels().load(std::memory_order_relaxed)->max_float(src, count);
 }
 
-template < typename type_t >
-template < typename type2_t, uint64_t size_u >
-cc0::array<type_t>::array(const cc0::array<type2_t,size_u> &arr) : array()
+inline float cc0::internal::sum_float(const float *src, uint64_t count)
 {
-	copy<type2_t>(arr, size_u, true);
+	return cc0::internal::active_kernels().load(std::memory_order_relaxed)->sum_float(src, count);
 }
 
-template < typename type_t >
-template < typename type2_t >
-cc0::array<type_t>::array(const cc0::slice<type2_t> &arr) : array()
+inline double cc0::internal::sum_double(const double *src, uint64_t count)
 {
-	copy<type2_t>(arr, arr.size(), true);
+	return cc0::internal::active_kernels().load(std::memory_order_relaxed)->sum_double(src, count);
 }
 
-template < typename type_t >
-template < typename type2_t >
-cc0::array<type_t>::array(const cc0::slice<const type2_t> &arr) : array()
+inline uint64_t cc0::internal::count_bytes(const uint8_t *src, uint64_t count, uint8_t value)
 {
-	copy<type2_t>(arr, arr.size(), true);
+	return cc0::internal::active_kernels().load(std::memory_order_relaxed)->count_bytes(src, count, value);
 }
 
-template < typename type_t >
-template < typename type2_t >
-cc0::array<type_t>::array(const type2_t *values, uint64_t size) : array()
+inline uint64_t cc0::internal::find_int32(const int32_t *src, uint64_t count, int32_t value)
 {
-	copy<type2_t>(values, size, true);
+	return cc0::internal::active_kernels().load(std::memory_order_relaxed)->find_int32(src, count, value);
 }
 
-template < typename type_t >
-template < typename type2_t, uint64_t size_u >
-cc0::array<type_t>::array(const cc0::values<type2_t,size_u> &vals) : array()
+inline cc0::isa cc0::detected_isa( void )
 {
-	copy<type2_t>(vals.v, size_u, true);
+	for (uint64_t i = cc0::isa_count; i > 0; --i) {
+		if (cc0::isa_supported(cc0::isa(i - 1))) {
+			return cc0::isa(i - 1);
+		}
+	}
+	return cc0::isa_scalar;
 }
 
-template < typename type_t >
-cc0::array<type_t>::~array( void )
+inline cc0::isa cc0::active_isa( void )
 {
-	delete [] m_values;
+	return cc0::internal::active_kernels().load(std::memory_order_relaxed)->isa;
 }
 
-template < typename type_t >
-template < typename type2_t >
-cc0::array<type_t> &cc0::array<type_t>::operator=(const cc0::array<type2_t> &arr)
+inline bool cc0::set_isa(cc0::isa isa)
 {
-	copy<type2_t>(arr, arr.size(), true);
-	return *this;
+	if (!cc0::isa_supported(isa)) {
+		return false;
+	}
+	cc0::internal::active_kernels().store(cc0::internal::kernel_table_for(isa), std::memory_order_relaxed);
+	return true;
 }
 
-template < typename type_t >
-cc0::array<type_t> &cc0::array<type_t>::operator=(const cc0::array<type_t> &arr)
+inline bool cc0::isa_supported(cc0::isa isa)
 {
-	copy<type_t>(arr, arr.size(), true);
-	return *this;
+	return cc0::internal::kernel_table_for(isa) != nullptr && cc0::internal::cpu_supports(isa);
 }
 
-template < typename type_t >
-template < typename type2_t >
-cc0::array<type_t> &cc0::array<type_t>::operator=(cc0::array<type2_t> &&arr)
+inline const char *cc0::isa_name(cc0::isa isa)
 {
-	if (m_values != arr.m_values) {
-		destroy(false);
-	}
-	m_values       = arr.m_values;
-	m_size         = arr.m_size;
-	m_capacity     = arr.m_capacity;
-	arr.m_values   = nullptr;
-	arr.m_size     = 0;
-	arr.m_capacity = 0;
-	return *this;
+	static const char *names[cc0::isa_count] = { "scalar", "sse2", "avx2", "avx512" };
+	return isa < cc0::isa_count ? names[isa] : "unknown";
 }
-
-template < typename type_t >
-cc0::array<type_t> &cc0::array<type_t>::operator=(cc0::array<type_t> &&arr)
+#elif defined(__SSE2__)
+inline void cc0::internal::fill_blocks(void *dst, uint64_t blocks, const void *pattern)
 {
-	if (m_values != arr.m_values) {
-		destroy(false);
-	}
-	m_values       = arr.m_values;
-	m_size         = arr.m_size;
-	m_capacity     = arr.m_capacity;
-	arr.m_values   = nullptr;
-	arr.m_size     = 0;
-	arr.m_capacity = 0;
-	return *this;
+	cc0::internal::sse2::fill_blocks(dst, blocks, pattern);
 }
 
-template < typename type_t >
-template < typename type2_t, uint64_t size_u >
-cc0::array<type_t> &cc0::array<type_t>::operator=(const cc0::array<type2_t,size_u> &arr)
+inline float cc0::internal::min_float(const float *src, uint64_t count)
 {
-	copy<type2_t>(arr, size_u, true);
-	return *this;
+	return cc0::internal::sse2::min_float(src, count);
 }
 
-template < typename type_t >
-template < typename type2_t >
-cc0::array<type_t> &cc0::array<type_t>::operator=(const cc0::slice<const type2_t> &arr)
+inline float cc0::internal::max_float(const float *src, uint64_t count)
 {
-	copy<type2_t>(arr, arr.size(), true);
-	return *this;
+	return cc0::internal::sse2::max_float(src, count);
 }
 
-template < typename type_t >
-template < typename type2_t, uint64_t size_u >
-cc0::array<type_t> &cc0::array<type_t>::operator=(const type2_t (&values)[size_u])
+inline float cc0::internal::sum_float(const float *src, uint64_t count)
 {
-	copy<type2_t>(values, size_u, true);
-	return *this;
+	return cc0::internal::sse2::sum_float(src, count);
 }
 
-template < typename type_t >
-template < typename type2_t, uint64_t size_u >
-cc0::array<type_t> &cc0::array<type_t>::operator=(const cc0::values<type2_t,size_u> &vals)
+	#if defined(__GNUC__) || defined(__clang__)
+inline uint64_t cc0::internal::count_bytes(const uint8_t *src, uint64_t count, uint8_t value)
 {
-	copy(vals.v, size_u, true);
-	return *this;
+	return cc0::internal::sse2::count_bytes(src, count, value);
 }
 
-template < typename type_t >
-void cc0::array<type_t>::create(uint64_t size, bool use_pool)
+inline uint64_t cc0::internal::find_int32(const int32_t *src, uint64_t count, int32_t value)
 {
-	if ((size < m_capacity && !use_pool) || size > m_capacity) {
-		destroy(false);
-		if (size > 0) {
-			m_values = new type_t[size];
-			m_size = m_capacity = size;
-		}
-	}
+	return cc0::internal::sse2::find_int32(src, count, value);
 }
+	#endif
+#endif
 
 template < typename type_t >
-void cc0::array<type_t>::destroy(bool use_pool)
+void cc0::fill(cc0::slice<type_t> dst, const type_t &value)
 {
-	if (!use_pool) {
-		delete [] m_values;
-		m_values = nullptr;
-		m_capacity = 0;
-	}
-	m_size = 0;
+	cc0::internal::fill(static_cast<type_t*>(dst), dst.size(), value, std::is_trivially_copyable<type_t>());
 }
 
-template < typename type_t >
-cc0::array<type_t>::operator type_t*( void )
+template < typename type_t, typename type2_t >
+uint64_t cc0::copy(cc0::slice<type_t> dst, cc0::slice<type2_t> src)
 {
-	return m_values;
+	const uint64_t count = dst.size() < src.size() ? dst.size() : src.size();
+	cc0::internal::copy_assign(static_cast<type_t*>(dst), static_cast<const type2_t*>(src), count);
+	return count;
 }
 
-template < typename type_t >
-cc0::array<type_t>::operator const type_t*( void ) const
+template < typename type_t, typename type2_t >
+uint64_t cc0::move(cc0::slice<type_t> dst, cc0::slice<type2_t> src)
 {
-	return m_values;
+	const uint64_t count = dst.size() < src.size() ? dst.size() : src.size();
+	cc0::internal::move(static_cast<type_t*>(dst), static_cast<type2_t*>(src), count, cc0::internal::is_bitwise_copyable<type_t,type2_t>());
+	return count;
 }
 
-template < typename type_t >
-template < typename type2_t >
-cc0::array<type_t>::operator cc0::slice<type2_t>( void )
+template < typename type_t, typename type2_t >
+bool cc0::equal(cc0::slice<type_t> a, cc0::slice<type2_t> b)
 {
-	return cc0::slice<type2_t>(m_values, m_size);
+	return a.size() == b.size() && cc0::internal::equal(static_cast<const type_t*>(a), static_cast<const type2_t*>(b), a.size(), cc0::internal::is_bitwise_comparable<type_t,type2_t>());
 }
 
 template < typename type_t >
-cc0::array<type_t>::operator cc0::slice<type_t>( void )
+uint64_t cc0::find(cc0::slice<type_t> arr, const typename std::remove_cv<type_t>::type &value)
 {
-	return cc0::slice<type_t>(m_values, m_size);
+	typedef typename std::remove_cv<type_t>::type value_t;
+	return cc0::internal::find(static_cast<const value_t*>(static_cast<const type_t*>(arr)), arr.size(), value, cc0::internal::is_byte<value_t>());
 }
 
 template < typename type_t >
-template < typename type2_t >
-cc0::array<type_t>::operator const cc0::slice<const type2_t>( void ) const
+uint64_t cc0::count(cc0::slice<type_t> arr, const typename std::remove_cv<type_t>::type &value)
 {
-	return cc0::slice<const type2_t>(m_values, m_size);
+	typedef typename std::remove_cv<type_t>::type value_t;
+	return cc0::internal::count(static_cast<const value_t*>(static_cast<const type_t*>(arr)), arr.size(), value, cc0::internal::is_byte<value_t>());
 }
 
 template < typename type_t >
-cc0::array<type_t>::operator const cc0::slice<const type_t>( void ) const
+typename std::remove_cv<type_t>::type cc0::min(cc0::slice<type_t> arr)
 {
-	return cc0::slice<const type_t>(m_values, m_size);
+	typedef typename std::remove_cv<type_t>::type value_t;
+	return cc0::internal::min(static_cast<const value_t*>(static_cast<const type_t*>(arr)), arr.size());
 }
 
 template < typename type_t >
-cc0::slice<type_t> cc0::array<type_t>::operator()(uint64_t start, uint64_t end)
+typename std::remove_cv<type_t>::type cc0::max(cc0::slice<type_t> arr)
 {
-	return cc0::slice<type_t>(m_values + start, (end - start));
+	typedef typename std::remove_cv<type_t>::type value_t;
+	return cc0::internal::max(static_cast<const value_t*>(static_cast<const type_t*>(arr)), arr.size());
 }
 
 template < typename type_t >
-cc0::slice<const type_t> cc0::array<type_t>::operator()(uint64_t start, uint64_t end) const
+typename std::remove_cv<type_t>::type cc0::sum(cc0::slice<type_t> arr)
 {
-	return cc0::slice<const type_t>(m_values + start, (end - start));
+	typedef typename std::remove_cv<type_t>::type value_t;
+	return cc0::internal::sum(static_cast<const value_t*>(static_cast<const type_t*>(arr)), arr.size());
 }
 
+
 template < typename type_t >
-uint64_t cc0::array<type_t>::size( void ) const
+cc0::strided_slice<type_t> cc0::stride(cc0::slice<type_t> arr, uint64_t step)
 {
-	return m_size;
+	return cc0::strided_slice<type_t>(arr, (arr.size() + step - 1) / step, step);
 }
 
-template < typename type_t, typename type2_t >
-cc0::slice<type_t> cc0::view(type2_t *values, uint64_t start, uint64_t end)
+template < typename type_t >
+void cc0::fill(cc0::strided_slice<type_t> dst, const type_t &value)
 {
-	return cc0::slice<type_t>(values + start, (end - start));
+	if (dst.is_contiguous()) {
+		cc0::fill(dst.contiguous(), value);
+		return;
+	}
+	for (uint64_t i = 0; i < dst.size(); ++i) {
+		dst[i] = value;
+	}
 }
 
 template < typename type_t, typename type2_t >
-cc0::slice<const type_t> cc0::view(const type2_t *values, uint64_t start, uint64_t end)
+uint64_t cc0::copy(cc0::strided_slice<type_t> dst, cc0::strided_slice<type2_t> src)
 {
-	return cc0::slice<const type_t>(values + start, (end - start));
+	if (dst.is_contiguous() && src.is_contiguous()) {
+		return cc0::copy(dst.contiguous(), src.contiguous());
+	}
+	const uint64_t count = dst.size() < src.size() ? dst.size() : src.size();
+	for (uint64_t i = 0; i < count; ++i) {
+		dst[i] = src[i];
+	}
+	return count;
 }
 
-template < typename type_t, typename type2_t >
-cc0::slice<type_t> cc0::view(type2_t *values, uint64_t count)
+namespace cc0
 {
-	return cc0::slice<type_t>(values, count);
+	namespace internal
+	{
+		/// @brief Advances an index to the start of the next line along the last dimension of a multi-dimensional view.
+		/// @param index The index to advance. The index along the last dimension is left untouched.
+		/// @param shape The number of elements along each dimension.
+		/// @return False if there are no more lines.
+		template < uint64_t dims_u >
+		bool next_line(uint64_t (&index)[dims_u], const uint64_t (&shape)[dims_u])
+		{
+			for (uint64_t d = dims_u - 1; d > 0; --d) {
+				if (++index[d - 1] < shape[d - 1]) {
+					return true;
+				}
+				index[d - 1] = 0;
+			}
+			return false;
+		}
+	}
 }
 
-template < typename type_t, typename type2_t >
-cc0::slice<const type_t> cc0::view(const type2_t *values, uint64_t count)
+template < typename type_t, uint64_t dims_u >
+void cc0::fill(cc0::ndview<type_t,dims_u> dst, const type_t &value)
 {
-	return cc0::slice<const type_t>(values, count);
+	uint64_t shape[dims_u];
+	uint64_t index[dims_u];
+	for (uint64_t d = 0; d < dims_u; ++d) {
+		shape[d] = dst.shape(d);
+		index[d] = 0;
+	}
+	if (dst.size() == 0) {
+		return;
+	}
+	do {
+		cc0::fill(dst.line(dims_u - 1, index), value);
+	} while (cc0::internal::next_line(index, shape));
 }
 
-template < typename type_t >
-void cc0::fill(cc0::slice<type_t> dst, const type_t &value)
+template < typename type_t, typename type2_t, uint64_t dims_u >
+uint64_t cc0::copy(cc0::ndview<type_t,dims_u> dst, cc0::ndview<type2_t,dims_u> src)
 {
-	for (uint64_t i = 0; i < dst.size(); ++i) {
-		dst[i] = value;
+	uint64_t shape[dims_u];
+	uint64_t index[dims_u];
+	uint64_t count = 1;
+	for (uint64_t d = 0; d < dims_u; ++d) {
+		shape[d] = dst.shape(d) < src.shape(d) ? dst.shape(d) : src.shape(d);
+		index[d] = 0;
+		count *= shape[d];
+	}
+	if (count == 0) {
+		return 0;
 	}
+	const uint64_t n = shape[dims_u - 1];
+	do {
+		cc0::copy(dst.line(dims_u - 1, index)(0, n), src.line(dims_u - 1, index)(0, n));
+	} while (cc0::internal::next_line(index, shape));
+	return count;
 }
 
 #endif
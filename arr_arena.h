@@ -0,0 +1,205 @@
+/// @file
+/// @author github.com/SirJonthe
+/// @date 2023
+/// @copyright Public domain.
+/// @license CC0 1.0
+
+#ifndef CC0_ARR_ARENA_H_INCLUDED__
+#define CC0_ARR_ARENA_H_INCLUDED__
+
+#include "arr.h"
+
+namespace cc0
+{
+	/// @brief A region allocator that hands out memory by bumping a pointer through large blocks, and frees all of it at once. Returning memory to the arena does nothing, which makes it suitable for many short-lived arrays that all die at the same time, e.g. per-request scratch memory.
+	/// @warning Memory handed out by the arena, including the memory of arrays using the arena, is invalidated by reset and release. Arrays using the arena must not be accessed afterwards, except to be destroyed, and arrays of elements that are not trivially destructible must be destroyed before.
+	/// @note Not thread safe.
+	class arena : public cc0::allocator
+	{
+	public:
+		/// @brief The default number of bytes in a block.
+		static constexpr uint64_t default_block_size = 64 * 1024;
+
+	private:
+		/// @brief The header of a block of memory, followed by the memory of the block.
+		struct block
+		{
+			block    *next;
+			uint64_t  bytes; // The number of bytes allocated for the block, including the header.
+		};
+
+	private:
+		cc0::allocator *m_upstream;
+		uint64_t        m_block_size;
+		block          *m_blocks;
+		block          *m_free;
+		char           *m_top;
+		char           *m_end;
+		uint64_t        m_used;
+
+	private:
+		/// @brief Gets the number of bytes reserved for the header of a block.
+		/// @return The number of bytes.
+		static uint64_t header_size( void );
+
+		/// @brief Allocates a new block from the upstream allocator.
+		/// @param bytes The number of bytes of the block, including the header.
+		/// @return The block.
+		block *new_block(uint64_t bytes);
+
+	public:
+		/// @brief Creates an empty arena. No memory is allocated until the arena is first used.
+		/// @param block_size The number of bytes in each block. Allocations that do not fit in a block get a block of their own.
+		/// @param upstream The allocator to allocate blocks from. Null selects the default allocator.
+		explicit arena(uint64_t block_size = default_block_size, cc0::allocator *upstream = nullptr);
+
+		arena(const arena&) = delete;
+		arena &operator=(const arena&) = delete;
+
+		/// @brief Frees all blocks.
+		~arena( void );
+
+		/// @brief Allocates raw, uninitialized memory from the current block, starting a new block if the current block is exhausted.
+		/// @param size The number of bytes to allocate.
+		/// @param align The required alignment, in bytes, of the allocated memory.
+		/// @return The allocated memory.
+		void *allocate(uint64_t size, uint64_t align);
+
+		/// @brief Does nothing. Memory is only freed by reset and release.
+		void deallocate(void*, uint64_t, uint64_t);
+
+		/// @brief Allocates memory for a slice of elements. The elements are default-initialized, and are never destroyed.
+		/// @tparam type_t The type of the elements. Must be trivially destructible.
+		/// @param size The number of elements.
+		/// @return The slice.
+		template < typename type_t >
+		cc0::slice<type_t> make_slice(uint64_t size);
+
+		/// @brief Creates an array that allocates its memory from the arena.
+		/// @tparam type_t The type of the array.
+		/// @tparam align_u The alignment of the array.
+		/// @param size The number of elements in the array.
+		/// @return The array.
+		template < typename type_t, uint64_t align_u = alignof(type_t) >
+		cc0::array<type_t,0,align_u> make_array(uint64_t size = 0);
+
+		/// @brief Frees all memory handed out by the arena in one go. Blocks of the regular block size are kept for reuse, while larger blocks are returned to the upstream allocator.
+		void reset( void );
+
+		/// @brief Frees all memory handed out by the arena, and returns all blocks to the upstream allocator.
+		void release( void );
+
+		/// @brief Gets the number of bytes handed out since the arena was last reset, excluding padding.
+		/// @return The number of bytes.
+		uint64_t used( void ) const;
+	};
+}
+
+inline uint64_t cc0::arena::header_size( void )
+{
+	return (sizeof(block) + alignof(std::max_align_t) - 1) & ~uint64_t(alignof(std::max_align_t) - 1);
+}
+
+inline cc0::arena::block *cc0::arena::new_block(uint64_t bytes)
+{
+	block *b = static_cast<block*>(m_upstream->allocate(bytes, alignof(std::max_align_t)));
+	b->bytes = bytes;
+	return b;
+}
+
+inline cc0::arena::arena(uint64_t block_size, cc0::allocator *upstream) : m_upstream(upstream != nullptr ? upstream : cc0::default_allocator()), m_block_size(block_size), m_blocks(nullptr), m_free(nullptr), m_top(nullptr), m_end(nullptr), m_used(0)
+{}
+
+inline cc0::arena::~arena( void )
+{
+	release();
+}
+
+inline void *cc0::arena::allocate(uint64_t size, uint64_t align)
+{
+	uintptr_t addr = (reinterpret_cast<uintptr_t>(m_top) + align - 1) & ~uintptr_t(align - 1);
+	if (m_top == nullptr || addr + size > reinterpret_cast<uintptr_t>(m_end)) {
+		const uint64_t bytes = header_size() + size + (align > alignof(std::max_align_t) ? align : 0);
+		block *b = nullptr;
+		if (bytes > m_block_size) {
+			// Oversized allocations get a block of their own, which is linked behind the current block so that the current block stays in use.
+			b = new_block(bytes);
+			if (m_blocks != nullptr) {
+				b->next = m_blocks->next;
+				m_blocks->next = b;
+			} else {
+				b->next = nullptr;
+				m_blocks = b;
+			}
+			addr = (reinterpret_cast<uintptr_t>(b) + header_size() + align - 1) & ~uintptr_t(align - 1);
+			m_used += size;
+			return reinterpret_cast<void*>(addr);
+		}
+		if (m_free != nullptr) {
+			b = m_free;
+			m_free = b->next;
+		} else {
+			b = new_block(m_block_size);
+		}
+		b->next = m_blocks;
+		m_blocks = b;
+		m_top = reinterpret_cast<char*>(b) + header_size();
+		m_end = reinterpret_cast<char*>(b) + b->bytes;
+		addr = (reinterpret_cast<uintptr_t>(m_top) + align - 1) & ~uintptr_t(align - 1);
+	}
+	m_top = reinterpret_cast<char*>(addr + size);
+	m_used += size;
+	return reinterpret_cast<void*>(addr);
+}
+
+inline void cc0::arena::deallocate(void*, uint64_t, uint64_t)
+{}
+
+template < typename type_t >
+cc0::slice<type_t> cc0::arena::make_slice(uint64_t size)
+{
+	static_assert(std::is_trivially_destructible<type_t>::value, "Elements of arena slices are never destroyed");
+	type_t *values = static_cast<type_t*>(allocate(size * sizeof(type_t), alignof(type_t)));
+	cc0::internal::construct(values, size);
+	return cc0::slice<type_t>(values, size);
+}
+
+template < typename type_t, uint64_t align_u >
+cc0::array<type_t,0,align_u> cc0::arena::make_array(uint64_t size)
+{
+	return cc0::array<type_t,0,align_u>(size, this);
+}
+
+inline void cc0::arena::reset( void )
+{
+	while (m_blocks != nullptr) {
+		block *b = m_blocks;
+		m_blocks = b->next;
+		if (b->bytes == m_block_size) {
+			b->next = m_free;
+			m_free = b;
+		} else {
+			m_upstream->deallocate(b, b->bytes, alignof(std::max_align_t));
+		}
+	}
+	m_top = nullptr;
+	m_end = nullptr;
+	m_used = 0;
+}
+
+inline void cc0::arena::release( void )
+{
+	reset();
+	while (m_free != nullptr) {
+		block *b = m_free;
+		m_free = b->next;
+		m_upstream->deallocate(b, b->bytes, alignof(std::max_align_t));
+	}
+}
+
+inline uint64_t cc0::arena::used( void ) const
+{
+	return m_used;
+}
+
+#endif
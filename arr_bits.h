@@ -0,0 +1,610 @@
+/// @file
+/// @author github.com/SirJonthe
+/// @date 2023
+/// @copyright Public domain.
+/// @license CC0 1.0
+
+#ifndef CC0_ARR_BITS_H_INCLUDED__
+#define CC0_ARR_BITS_H_INCLUDED__
+
+#include "arr.h"
+
+namespace cc0
+{
+	namespace internal
+	{
+		/// @brief Counts the set bits of a word.
+		/// @param w The word.
+		/// @return The number of set bits.
+		uint64_t popcount64(uint64_t w);
+
+		/// @brief Counts the trailing zero bits of a word.
+		/// @param w The word. Must not be 0.
+		/// @return The index of the lowest set bit.
+		uint64_t ctz64(uint64_t w);
+
+		/// @brief Creates a mask of a range of bits within a word.
+		/// @param lo The first bit (inclusive).
+		/// @param hi The last bit (non-inclusive). Must be greater than lo, and no greater than 64.
+		/// @return The mask.
+		uint64_t bit_mask(uint64_t lo, uint64_t hi);
+
+		/// @brief Properties of packed elements of a given number of bits.
+		/// @tparam bits_u The number of bits per element.
+		template < uint64_t bits_u >
+		struct packed_traits
+		{
+			static_assert(bits_u > 0 && bits_u <= 64 && 64 % bits_u == 0, "bits_u must be 1, 2, 4, 8, 16, 32 or 64");
+
+			static constexpr uint64_t per_word = 64 / bits_u;                                     // The number of elements in a word.
+			static constexpr uint64_t field    = bits_u == 64 ? ~uint64_t(0) : (uint64_t(1) << bits_u) - 1; // The mask of the lowest element of a word.
+			static constexpr uint64_t low      = ~uint64_t(0) / field;                             // The mask of the lowest bit of every element of a word.
+
+			/// @brief Computes a word with the lowest bit of every element set if the element is non-zero.
+			/// @param w The word.
+			/// @return The mask of non-zero elements.
+			static uint64_t nonzero(uint64_t w)
+			{
+				for (uint64_t shift = 1; shift < bits_u; shift *= 2) {
+					w |= w >> shift;
+				}
+				return w & low;
+			}
+
+			/// @brief Computes a word with every element set to a value.
+			/// @param value The value.
+			/// @return The word.
+			static uint64_t pattern(uint64_t value)
+			{
+				return (value & field) * low;
+			}
+		};
+	}
+
+	/// @brief A reference to a single element of a packed array, which reads or writes the bits of the element within its word.
+	/// @tparam bits_u The number of bits per element.
+	/// @tparam word_t The type of the words; const for read-only references.
+	template < uint64_t bits_u, typename word_t = uint64_t >
+	class packed_reference
+	{
+	private:
+		word_t   *m_word;
+		uint64_t  m_shift;
+
+	public:
+		/// @brief Creates a reference to an element.
+		/// @param word The word holding the element.
+		/// @param shift The bit offset of the element within the word.
+		packed_reference(word_t *word, uint64_t shift);
+
+		/// @brief Reads the element.
+		/// @return The value of the element.
+		operator uint64_t( void ) const;
+
+		/// @brief Writes the element. Bits of the value beyond the element size are discarded.
+		/// @param value The value.
+		/// @return A reference to the element.
+		const packed_reference &operator=(uint64_t value) const;
+
+		/// @brief Writes the value of another element to the element.
+		/// @param r The other element.
+		/// @return A reference to the element.
+		const packed_reference &operator=(const packed_reference &r) const;
+	};
+
+	/// @brief A view into part of a packed array. Like slices, packed slices do not own the elements they view.
+	/// @tparam bits_u The number of bits per element. Must be 1, 2, 4, 8, 16, 32 or 64, so that elements never straddle words.
+	/// @tparam word_t The type of the words; const for read-only views.
+	template < uint64_t bits_u, typename word_t = uint64_t >
+	class packed_slice
+	{
+		template < uint64_t, typename > friend class packed_slice;
+
+	private:
+		typedef cc0::internal::packed_traits<bits_u> traits;
+
+		word_t   *m_words;
+		uint64_t  m_start;
+		uint64_t  m_size;
+
+	public:
+		/// @brief Default constructor. Sets data reference to null and size to zero.
+		packed_slice( void );
+
+		/// @brief Creates a view of packed elements.
+		/// @param words The words holding the elements.
+		/// @param start The index of the first element within the words.
+		/// @param size The number of elements.
+		packed_slice(word_t *words, uint64_t start, uint64_t size);
+
+		/// @brief Converts a view into a read-only view.
+		/// @tparam word2_t The type of the words of the other view.
+		/// @param s The other view.
+		template < typename word2_t >
+		packed_slice(const packed_slice<bits_u,word2_t> &s);
+
+		/// @brief Accesses an element.
+		/// @param i The index of the element.
+		/// @return A reference to the element.
+		cc0::packed_reference<bits_u,word_t> operator[](uint64_t i) const;
+
+		/// @brief Provides a view of the elements with the given index bounds.
+		/// @param start The start index of the view (inclusive).
+		/// @param end The end index of the view (non-inclusive).
+		/// @return The view.
+		packed_slice operator()(uint64_t start, uint64_t end) const;
+
+		/// @brief Counts the non-zero elements, a word at a time. For bit arrays, this is the number of set bits.
+		/// @return The number of non-zero elements.
+		uint64_t count( void ) const;
+
+		/// @brief Finds the first non-zero element, a word at a time. For bit arrays, this is the first set bit.
+		/// @param from The index to start searching at.
+		/// @return The index of the element, or the size of the view if there is none.
+		uint64_t find_first(uint64_t from = 0) const;
+
+		/// @brief Writes a value to every element, a word at a time.
+		/// @param value The value.
+		void fill(uint64_t value) const;
+
+		/// @brief Gets the size of the view.
+		/// @return The number of elements in the view.
+		uint64_t size( void ) const;
+	};
+
+	/// @brief A variable-size array of unsigned integers of a given number of bits, packed into 64-bit words. Elements are accessed through proxy references, and counting, searching, filling and bitwise operations process a whole word of elements at a time.
+	/// @tparam bits_u The number of bits per element. Must be 1, 2, 4, 8, 16, 32 or 64, so that elements never straddle words.
+	template < uint64_t bits_u >
+	class packed_array
+	{
+	private:
+		typedef cc0::internal::packed_traits<bits_u> traits;
+
+		cc0::array<uint64_t> m_words;
+		uint64_t             m_size;
+
+	private:
+		/// @brief Computes the number of words needed to hold a number of elements.
+		/// @param size The number of elements.
+		/// @return The number of words.
+		static uint64_t word_count(uint64_t size);
+
+		/// @brief Clears the bits of the last word beyond the last element, which are kept zero so that words can be combined and counted as a whole.
+		void clear_padding( void );
+
+	public:
+		/// @brief Creates an empty array.
+		/// @param allocator The allocator to allocate the words with. Null selects the default allocator.
+		explicit packed_array(cc0::allocator *allocator = nullptr);
+
+		/// @brief Creates an array of a given size with all elements set to zero.
+		/// @param size The number of elements.
+		/// @param allocator The allocator to allocate the words with. Null selects the default allocator.
+		explicit packed_array(uint64_t size, cc0::allocator *allocator = nullptr);
+
+		/// @brief Allocates memory for a given number of elements, and sets all elements to zero.
+		/// @param size The number of elements.
+		/// @param use_pool Determine if the array should pool memory if the size is less than the capacity of the array.
+		void create(uint64_t size, bool use_pool = true);
+
+		/// @brief Frees allocated memory and sets the array size to 0.
+		/// @param use_pool Only sets the size of the array to zero without actually freeing the underlying memory.
+		void destroy(bool use_pool = true);
+
+		/// @brief Changes the number of elements in the array. Elements are preserved up to the new size, and new elements are zero.
+		/// @param size The new number of elements.
+		void resize(uint64_t size);
+
+		/// @brief Accesses an element.
+		/// @param i The index of the element.
+		/// @return A reference to the element.
+		cc0::packed_reference<bits_u> operator[](uint64_t i);
+
+		/// @brief Reads an element.
+		/// @param i The index of the element.
+		/// @return The value of the element.
+		uint64_t operator[](uint64_t i) const;
+
+		/// @brief Converts the array into a view covering all of the array.
+		/// @return The view.
+		operator cc0::packed_slice<bits_u>( void );
+
+		/// @brief Converts the array into a read-only view covering all of the array.
+		/// @return The view.
+		operator cc0::packed_slice<bits_u,const uint64_t>( void ) const;
+
+		/// @brief Provides a view of the array with the given index bounds.
+		/// @param start The start index of the view (inclusive).
+		/// @param end The end index of the view (non-inclusive).
+		/// @return The view.
+		cc0::packed_slice<bits_u> operator()(uint64_t start, uint64_t end);
+
+		/// @brief Provides a read-only view of the array with the given index bounds.
+		/// @param start The start index of the view (inclusive).
+		/// @param end The end index of the view (non-inclusive).
+		/// @return The view.
+		cc0::packed_slice<bits_u,const uint64_t> operator()(uint64_t start, uint64_t end) const;
+
+		/// @brief Combines the elements of two arrays with a bitwise and, a word at a time. Elements beyond the size of the other array are treated as zero.
+		/// @param arr The other array.
+		/// @return A reference to the array.
+		packed_array &operator&=(const packed_array &arr);
+
+		/// @brief Combines the elements of two arrays with a bitwise or, a word at a time. Elements beyond the size of the other array are treated as zero.
+		/// @param arr The other array.
+		/// @return A reference to the array.
+		packed_array &operator|=(const packed_array &arr);
+
+		/// @brief Combines the elements of two arrays with a bitwise exclusive or, a word at a time. Elements beyond the size of the other array are treated as zero.
+		/// @param arr The other array.
+		/// @return A reference to the array.
+		packed_array &operator^=(const packed_array &arr);
+
+		/// @brief Inverts every bit of every element, a word at a time.
+		void flip( void );
+
+		/// @brief Counts the non-zero elements using population counts of whole words. For bit arrays, this is the number of set bits.
+		/// @return The number of non-zero elements.
+		uint64_t count( void ) const;
+
+		/// @brief Finds the first non-zero element, a word at a time. For bit arrays, this is the first set bit.
+		/// @param from The index to start searching at.
+		/// @return The index of the element, or the size of the array if there is none.
+		uint64_t find_first(uint64_t from = 0) const;
+
+		/// @brief Writes a value to every element, a word at a time.
+		/// @param value The value.
+		void fill(uint64_t value);
+
+		/// @brief Allows direct access to the words holding the elements. Bits beyond the last element are zero, and must be kept zero.
+		/// @return The words.
+		cc0::slice<uint64_t> words( void );
+
+		/// @brief Allows direct read-only access to the words holding the elements. Bits beyond the last element are zero.
+		/// @return The words.
+		cc0::slice<const uint64_t> words( void ) const;
+
+		/// @brief Gets the size of the array.
+		/// @return The number of elements in the array.
+		uint64_t size( void ) const;
+
+		/// @brief Gets the allocator used to allocate and free the words.
+		/// @return The allocator.
+		cc0::allocator *get_allocator( void ) const;
+	};
+
+	/// @brief An array of bits, packed 64 to a word.
+	typedef cc0::packed_array<1> bit_array;
+
+	/// @brief A view into part of an array of bits.
+	typedef cc0::packed_slice<1> bit_slice;
+}
+
+inline uint64_t cc0::internal::popcount64(uint64_t w)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return uint64_t(__builtin_popcountll(w));
+#else
+	w = w - ((w >> 1) & 0x5555555555555555ULL);
+	w = (w & 0x3333333333333333ULL) + ((w >> 2) & 0x3333333333333333ULL);
+	w = (w + (w >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+	return (w * 0x0101010101010101ULL) >> 56;
+#endif
+}
+
+inline uint64_t cc0::internal::ctz64(uint64_t w)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return uint64_t(__builtin_ctzll(w));
+#else
+	return cc0::internal::popcount64((w & (~w + 1)) - 1);
+#endif
+}
+
+inline uint64_t cc0::internal::bit_mask(uint64_t lo, uint64_t hi)
+{
+	return (hi < 64 ? (uint64_t(1) << hi) - 1 : ~uint64_t(0)) & (~uint64_t(0) << lo);
+}
+
+template < uint64_t bits_u, typename word_t >
+cc0::packed_reference<bits_u,word_t>::packed_reference(word_t *word, uint64_t shift) : m_word(word), m_shift(shift)
+{}
+
+template < uint64_t bits_u, typename word_t >
+cc0::packed_reference<bits_u,word_t>::operator uint64_t( void ) const
+{
+	return (*m_word >> m_shift) & cc0::internal::packed_traits<bits_u>::field;
+}
+
+template < uint64_t bits_u, typename word_t >
+const cc0::packed_reference<bits_u,word_t> &cc0::packed_reference<bits_u,word_t>::operator=(uint64_t value) const
+{
+	const uint64_t field = cc0::internal::packed_traits<bits_u>::field;
+	*m_word = (*m_word & ~(field << m_shift)) | ((value & field) << m_shift);
+	return *this;
+}
+
+template < uint64_t bits_u, typename word_t >
+const cc0::packed_reference<bits_u,word_t> &cc0::packed_reference<bits_u,word_t>::operator=(const cc0::packed_reference<bits_u,word_t> &r) const
+{
+	return *this = uint64_t(r);
+}
+
+template < uint64_t bits_u, typename word_t >
+cc0::packed_slice<bits_u,word_t>::packed_slice( void ) : m_words(nullptr), m_start(0), m_size(0)
+{}
+
+template < uint64_t bits_u, typename word_t >
+cc0::packed_slice<bits_u,word_t>::packed_slice(word_t *words, uint64_t start, uint64_t size) : m_words(words), m_start(start), m_size(size)
+{}
+
+template < uint64_t bits_u, typename word_t >
+template < typename word2_t >
+cc0::packed_slice<bits_u,word_t>::packed_slice(const cc0::packed_slice<bits_u,word2_t> &s) : m_words(s.m_words), m_start(s.m_start), m_size(s.m_size)
+{}
+
+template < uint64_t bits_u, typename word_t >
+cc0::packed_reference<bits_u,word_t> cc0::packed_slice<bits_u,word_t>::operator[](uint64_t i) const
+{
+	CC0_ARR_ASSERT(i < m_size);
+	const uint64_t index = m_start + i;
+	return cc0::packed_reference<bits_u,word_t>(m_words + index / traits::per_word, (index % traits::per_word) * bits_u);
+}
+
+template < uint64_t bits_u, typename word_t >
+cc0::packed_slice<bits_u,word_t> cc0::packed_slice<bits_u,word_t>::operator()(uint64_t start, uint64_t end) const
+{
+	CC0_ARR_ASSERT(start <= end && end <= m_size);
+	return cc0::packed_slice<bits_u,word_t>(m_words, m_start + start, end - start);
+}
+
+template < uint64_t bits_u, typename word_t >
+uint64_t cc0::packed_slice<bits_u,word_t>::count( void ) const
+{
+	const uint64_t first = m_start * bits_u;
+	const uint64_t last = (m_start + m_size) * bits_u;
+	uint64_t n = 0;
+	for (uint64_t w = first / 64; w * 64 < last; ++w) {
+		const uint64_t lo = w * 64 < first ? first - w * 64 : 0;
+		const uint64_t hi = last - w * 64 < 64 ? last - w * 64 : 64;
+		if (lo < hi) {
+			n += cc0::internal::popcount64(traits::nonzero(m_words[w]) & cc0::internal::bit_mask(lo, hi));
+		}
+	}
+	return n;
+}
+
+template < uint64_t bits_u, typename word_t >
+uint64_t cc0::packed_slice<bits_u,word_t>::find_first(uint64_t from) const
+{
+	if (from >= m_size) {
+		return m_size;
+	}
+	const uint64_t first = (m_start + from) * bits_u;
+	const uint64_t last = (m_start + m_size) * bits_u;
+	for (uint64_t w = first / 64; w * 64 < last; ++w) {
+		const uint64_t lo = w * 64 < first ? first - w * 64 : 0;
+		const uint64_t hi = last - w * 64 < 64 ? last - w * 64 : 64;
+		const uint64_t found = traits::nonzero(m_words[w]) & cc0::internal::bit_mask(lo, hi);
+		if (found != 0) {
+			return (w * 64 + cc0::internal::ctz64(found)) / bits_u - m_start;
+		}
+	}
+	return m_size;
+}
+
+template < uint64_t bits_u, typename word_t >
+void cc0::packed_slice<bits_u,word_t>::fill(uint64_t value) const
+{
+	const uint64_t pattern = traits::pattern(value);
+	const uint64_t first = m_start * bits_u;
+	const uint64_t last = (m_start + m_size) * bits_u;
+	for (uint64_t w = first / 64; w * 64 < last; ++w) {
+		const uint64_t lo = w * 64 < first ? first - w * 64 : 0;
+		const uint64_t hi = last - w * 64 < 64 ? last - w * 64 : 64;
+		if (lo < hi) {
+			const uint64_t mask = cc0::internal::bit_mask(lo, hi);
+			m_words[w] = (m_words[w] & ~mask) | (pattern & mask);
+		}
+	}
+}
+
+template < uint64_t bits_u, typename word_t >
+uint64_t cc0::packed_slice<bits_u,word_t>::size( void ) const
+{
+	return m_size;
+}
+
+template < uint64_t bits_u >
+uint64_t cc0::packed_array<bits_u>::word_count(uint64_t size)
+{
+	return (size + traits::per_word - 1) / traits::per_word;
+}
+
+template < uint64_t bits_u >
+void cc0::packed_array<bits_u>::clear_padding( void )
+{
+	const uint64_t used = (m_size % traits::per_word) * bits_u;
+	if (used > 0) {
+		m_words[m_words.size() - 1] &= cc0::internal::bit_mask(0, used);
+	}
+}
+
+template < uint64_t bits_u >
+cc0::packed_array<bits_u>::packed_array(cc0::allocator *allocator) : m_words(allocator), m_size(0)
+{}
+
+template < uint64_t bits_u >
+cc0::packed_array<bits_u>::packed_array(uint64_t size, cc0::allocator *allocator) : m_words(allocator), m_size(0)
+{
+	create(size);
+}
+
+template < uint64_t bits_u >
+void cc0::packed_array<bits_u>::create(uint64_t size, bool use_pool)
+{
+	m_words.create(word_count(size), use_pool);
+	cc0::fill<uint64_t>(m_words, 0);
+	m_size = size;
+}
+
+template < uint64_t bits_u >
+void cc0::packed_array<bits_u>::destroy(bool use_pool)
+{
+	m_words.destroy(use_pool);
+	m_size = 0;
+}
+
+template < uint64_t bits_u >
+void cc0::packed_array<bits_u>::resize(uint64_t size)
+{
+	const uint64_t words = m_words.size();
+	m_words.resize(word_count(size));
+	if (m_words.size() > words) {
+		cc0::fill<uint64_t>(m_words(words, m_words.size()), 0);
+	}
+	m_size = size;
+	clear_padding();
+}
+
+template < uint64_t bits_u >
+cc0::packed_reference<bits_u> cc0::packed_array<bits_u>::operator[](uint64_t i)
+{
+	CC0_ARR_ASSERT(i < m_size);
+	return cc0::packed_reference<bits_u>(static_cast<uint64_t*>(m_words) + i / traits::per_word, (i % traits::per_word) * bits_u);
+}
+
+template < uint64_t bits_u >
+uint64_t cc0::packed_array<bits_u>::operator[](uint64_t i) const
+{
+	CC0_ARR_ASSERT(i < m_size);
+	return (static_cast<const uint64_t*>(m_words)[i / traits::per_word] >> ((i % traits::per_word) * bits_u)) & traits::field;
+}
+
+template < uint64_t bits_u >
+cc0::packed_array<bits_u>::operator cc0::packed_slice<bits_u>( void )
+{
+	return cc0::packed_slice<bits_u>(static_cast<uint64_t*>(m_words), 0, m_size);
+}
+
+template < uint64_t bits_u >
+cc0::packed_array<bits_u>::operator cc0::packed_slice<bits_u,const uint64_t>( void ) const
+{
+	return cc0::packed_slice<bits_u,const uint64_t>(static_cast<const uint64_t*>(m_words), 0, m_size);
+}
+
+template < uint64_t bits_u >
+cc0::packed_slice<bits_u> cc0::packed_array<bits_u>::operator()(uint64_t start, uint64_t end)
+{
+	CC0_ARR_ASSERT(start <= end && end <= m_size);
+	return cc0::packed_slice<bits_u>(static_cast<uint64_t*>(m_words), start, end - start);
+}
+
+template < uint64_t bits_u >
+cc0::packed_slice<bits_u,const uint64_t> cc0::packed_array<bits_u>::operator()(uint64_t start, uint64_t end) const
+{
+	CC0_ARR_ASSERT(start <= end && end <= m_size);
+	return cc0::packed_slice<bits_u,const uint64_t>(static_cast<const uint64_t*>(m_words), start, end - start);
+}
+
+template < uint64_t bits_u >
+cc0::packed_array<bits_u> &cc0::packed_array<bits_u>::operator&=(const cc0::packed_array<bits_u> &arr)
+{
+	const uint64_t n = m_words.size() < arr.m_words.size() ? m_words.size() : arr.m_words.size();
+	uint64_t *dst = m_words;
+	const uint64_t *src = arr.m_words;
+	for (uint64_t i = 0; i < n; ++i) {
+		dst[i] &= src[i];
+	}
+	if (n < m_words.size()) {
+		cc0::fill<uint64_t>(m_words(n, m_words.size()), 0);
+	}
+	return *this;
+}
+
+template < uint64_t bits_u >
+cc0::packed_array<bits_u> &cc0::packed_array<bits_u>::operator|=(const cc0::packed_array<bits_u> &arr)
+{
+	const uint64_t n = m_words.size() < arr.m_words.size() ? m_words.size() : arr.m_words.size();
+	uint64_t *dst = m_words;
+	const uint64_t *src = arr.m_words;
+	for (uint64_t i = 0; i < n; ++i) {
+		dst[i] |= src[i];
+	}
+	clear_padding();
+	return *this;
+}
+
+template < uint64_t bits_u >
+cc0::packed_array<bits_u> &cc0::packed_array<bits_u>::operator^=(const cc0::packed_array<bits_u> &arr)
+{
+	const uint64_t n = m_words.size() < arr.m_words.size() ? m_words.size() : arr.m_words.size();
+	uint64_t *dst = m_words;
+	const uint64_t *src = arr.m_words;
+	for (uint64_t i = 0; i < n; ++i) {
+		dst[i] ^= src[i];
+	}
+	clear_padding();
+	return *this;
+}
+
+template < uint64_t bits_u >
+void cc0::packed_array<bits_u>::flip( void )
+{
+	uint64_t *dst = m_words;
+	for (uint64_t i = 0; i < m_words.size(); ++i) {
+		dst[i] = ~dst[i];
+	}
+	clear_padding();
+}
+
+template < uint64_t bits_u >
+uint64_t cc0::packed_array<bits_u>::count( void ) const
+{
+	// Bits beyond the last element are zero, so whole words can be counted without masking.
+	const uint64_t *src = m_words;
+	uint64_t n = 0;
+	for (uint64_t i = 0; i < m_words.size(); ++i) {
+		n += cc0::internal::popcount64(traits::nonzero(src[i]));
+	}
+	return n;
+}
+
+template < uint64_t bits_u >
+uint64_t cc0::packed_array<bits_u>::find_first(uint64_t from) const
+{
+	return cc0::packed_slice<bits_u,const uint64_t>(*this).find_first(from);
+}
+
+template < uint64_t bits_u >
+void cc0::packed_array<bits_u>::fill(uint64_t value)
+{
+	cc0::fill<uint64_t>(m_words, traits::pattern(value));
+	clear_padding();
+}
+
+template < uint64_t bits_u >
+cc0::slice<uint64_t> cc0::packed_array<bits_u>::words( void )
+{
+	return m_words;
+}
+
+template < uint64_t bits_u >
+cc0::slice<const uint64_t> cc0::packed_array<bits_u>::words( void ) const
+{
+	return m_words;
+}
+
+template < uint64_t bits_u >
+uint64_t cc0::packed_array<bits_u>::size( void ) const
+{
+	return m_size;
+}
+
+template < uint64_t bits_u >
+cc0::allocator *cc0::packed_array<bits_u>::get_allocator( void ) const
+{
+	return m_words.get_allocator();
+}
+
+#endif
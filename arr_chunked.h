@@ -0,0 +1,416 @@
+/// @file
+/// @author github.com/SirJonthe
+/// @date 2023
+/// @copyright Public domain.
+/// @license CC0 1.0
+
+#ifndef CC0_ARR_CHUNKED_H_INCLUDED__
+#define CC0_ARR_CHUNKED_H_INCLUDED__
+
+#include "arr.h"
+
+namespace cc0
+{
+	/// @brief A variable-size array stored as a list of fixed-size segments rather than one contiguous block. Growing the array allocates new segments without moving existing elements, so appending never causes large reallocations or copies, peak memory stays close to the size of the elements, and pointers to elements remain valid until the elements are removed. Each segment is contiguous, and can be processed as a slice.
+	/// @tparam type_t The type of the array.
+	/// @tparam segment_size_u The number of elements in a segment. Must be a power of two.
+	/// @tparam align_u The alignment, in bytes, of the first element in each segment. Must be a power of two no less than the natural alignment of the type.
+	template < typename type_t, uint64_t segment_size_u = 4096, uint64_t align_u = alignof(type_t) >
+	class chunked_array
+	{
+		static_assert(segment_size_u > 0 && (segment_size_u & (segment_size_u - 1)) == 0, "segment_size_u must be a power of two");
+		static_assert(cc0::internal::is_valid_alignment<type_t,align_u>::value, "align_u must be a power of two no less than the natural alignment of type_t");
+
+	public:
+		/// @brief The number of elements in a segment.
+		static constexpr uint64_t segment_size = segment_size_u;
+
+	private:
+		cc0::array<type_t*>  m_segments;
+		uint64_t             m_size;
+		cc0::allocator      *m_allocator;
+
+	private:
+		/// @brief Allocates segments until the array can hold a given number of elements.
+		/// @param capacity The number of elements.
+		void add_segments(uint64_t capacity);
+
+		/// @brief Frees segments beyond those needed to hold a given number of elements.
+		/// @param capacity The number of elements.
+		void remove_segments(uint64_t capacity);
+
+		/// @brief Gets the memory of the next element, allocating a new segment if needed.
+		/// @return The uninitialized memory.
+		type_t *next( void );
+
+	public:
+		/// @brief Creates an empty array.
+		/// @param allocator The allocator to allocate segments with. Null selects the default allocator.
+		explicit chunked_array(cc0::allocator *allocator = nullptr);
+
+		/// @brief Copies the elements of another array.
+		/// @param arr The other array.
+		chunked_array(const chunked_array &arr);
+
+		/// @brief Takes over the segments of another array, leaving the other array empty.
+		/// @param arr The other array.
+		chunked_array(chunked_array &&arr);
+
+		/// @brief Destroys the elements, and frees all segments.
+		~chunked_array( void );
+
+		/// @brief Copies the elements of another array, reusing existing segments.
+		/// @param arr The other array.
+		/// @return A reference to the object being assigned.
+		chunked_array &operator=(const chunked_array &arr);
+
+		/// @brief Frees all segments, and takes over the segments of another array, leaving the other array empty.
+		/// @param arr The other array.
+		/// @return A reference to the object being assigned.
+		chunked_array &operator=(chunked_array &&arr);
+
+		/// @brief Destroys the elements, and sets the array size to 0.
+		/// @param use_pool Keeps the segments for reuse rather than freeing them.
+		void destroy(bool use_pool = true);
+
+		/// @brief Ensures that the array can hold a given number of elements without allocating new segments.
+		/// @param capacity The minimum number of elements the array should be able to hold.
+		void reserve(uint64_t capacity);
+
+		/// @brief Changes the number of elements in the array. Elements are preserved up to the new size, and new elements are default-constructed. Segments are kept for reuse when shrinking.
+		/// @param size The new number of elements in the array.
+		void resize(uint64_t size);
+
+		/// @brief Adds a copy of an element to the end of the array, allocating a new segment if needed.
+		/// @param value The value to add.
+		void push_back(const type_t &value);
+
+		/// @brief Moves an element to the end of the array, allocating a new segment if needed.
+		/// @param value The value to add.
+		void push_back(type_t &&value);
+
+		/// @brief Constructs an element in place at the end of the array, allocating a new segment if needed.
+		/// @tparam args_t The types of the constructor arguments.
+		/// @param args The constructor arguments.
+		/// @return A reference to the new element.
+		template < typename... args_t >
+		type_t &emplace_back(args_t&&... args);
+
+		/// @brief Adds copies of elements to the end of the array, one segment at a time.
+		/// @param values The values to add. Must not be elements of this array.
+		void append(cc0::slice<const type_t> values);
+
+		/// @brief Destroys the last element of the array. The array must not be empty.
+		void pop_back( void );
+
+		/// @brief Frees segments not occupied by elements.
+		void shrink_to_fit( void );
+
+		/// @brief Gets the allocator used to allocate and free segments.
+		/// @return The allocator.
+		cc0::allocator *get_allocator( void ) const;
+
+		/// @brief Frees all segments and sets the allocator used to allocate and free segments.
+		/// @param allocator The allocator to use. A null allocator resets the array to the default allocator.
+		void set_allocator(cc0::allocator *allocator);
+
+		/// @brief Accesses an element.
+		/// @param i The index of the element.
+		/// @return A reference to the element.
+		type_t &operator[](uint64_t i);
+
+		/// @brief Accesses an element.
+		/// @param i The index of the element.
+		/// @return A reference to the element.
+		const type_t &operator[](uint64_t i) const;
+
+		/// @brief Provides a view of the elements in a segment.
+		/// @param i The index of the segment.
+		/// @return The elements in the segment. Only the last occupied segment may hold fewer than segment_size elements.
+		cc0::slice<type_t> segment(uint64_t i);
+
+		/// @brief Provides a view of the elements in a segment.
+		/// @param i The index of the segment.
+		/// @return The elements in the segment. Only the last occupied segment may hold fewer than segment_size elements.
+		cc0::slice<const type_t> segment(uint64_t i) const;
+
+		/// @brief Calls a function with each occupied segment in order, allowing bulk operations on contiguous memory.
+		/// @tparam fn_t The type of the function, called as fn(cc0::slice<type_t>).
+		/// @param fn The function.
+		template < typename fn_t >
+		void for_each_segment(fn_t fn);
+
+		/// @brief Calls a function with each occupied segment in order, allowing bulk operations on contiguous memory.
+		/// @tparam fn_t The type of the function, called as fn(cc0::slice<const type_t>).
+		/// @param fn The function.
+		template < typename fn_t >
+		void for_each_segment(fn_t fn) const;
+
+		/// @brief Gets the number of segments holding elements.
+		/// @return The number of occupied segments.
+		uint64_t segment_count( void ) const;
+
+		/// @brief Gets the size of the array.
+		/// @return The number of elements in the array.
+		uint64_t size( void ) const;
+
+		/// @brief Gets the capacity of the array.
+		/// @return The number of elements the array can hold without allocating new segments.
+		uint64_t capacity( void ) const;
+	};
+}
+
+template < typename type_t, uint64_t segment_size_u, uint64_t align_u >
+void cc0::chunked_array<type_t,segment_size_u,align_u>::add_segments(uint64_t capacity)
+{
+	const uint64_t count = (capacity + segment_size_u - 1) / segment_size_u;
+	if (count <= m_segments.size()) {
+		return;
+	}
+	// Make room for the segment pointers first, so that appending them cannot throw and leak a segment.
+	if (count > m_segments.capacity()) {
+		m_segments.reserve(count > m_segments.capacity() * 2 ? count : m_segments.capacity() * 2);
+	}
+	while (m_segments.size() < count) {
+		m_segments.push_back(static_cast<type_t*>(cc0::internal::allocate(m_allocator, segment_size_u * sizeof(type_t), align_u)));
+	}
+}
+
+template < typename type_t, uint64_t segment_size_u, uint64_t align_u >
+void cc0::chunked_array<type_t,segment_size_u,align_u>::remove_segments(uint64_t capacity)
+{
+	const uint64_t count = (capacity + segment_size_u - 1) / segment_size_u;
+	for (uint64_t i = count; i < m_segments.size(); ++i) {
+		cc0::internal::deallocate(m_allocator, m_segments[i], segment_size_u * sizeof(type_t), align_u);
+	}
+	if (count < m_segments.size()) {
+		m_segments.resize(count);
+	}
+}
+
+template < typename type_t, uint64_t segment_size_u, uint64_t align_u >
+type_t *cc0::chunked_array<type_t,segment_size_u,align_u>::next( void )
+{
+	add_segments(m_size + 1);
+	return m_segments[m_size / segment_size_u] + m_size % segment_size_u;
+}
+
+template < typename type_t, uint64_t segment_size_u, uint64_t align_u >
+cc0::chunked_array<type_t,segment_size_u,align_u>::chunked_array(cc0::allocator *allocator) : m_segments(), m_size(0), m_allocator(allocator != nullptr ? allocator : cc0::default_allocator())
+{}
+
+template < typename type_t, uint64_t segment_size_u, uint64_t align_u >
+cc0::chunked_array<type_t,segment_size_u,align_u>::chunked_array(const cc0::chunked_array<type_t,segment_size_u,align_u> &arr) : chunked_array(arr.m_allocator)
+{
+	*this = arr;
+}
+
+template < typename type_t, uint64_t segment_size_u, uint64_t align_u >
+cc0::chunked_array<type_t,segment_size_u,align_u>::chunked_array(cc0::chunked_array<type_t,segment_size_u,align_u> &&arr) : m_segments(std::move(arr.m_segments)), m_size(arr.m_size), m_allocator(arr.m_allocator)
+{
+	arr.m_size = 0;
+}
+
+template < typename type_t, uint64_t segment_size_u, uint64_t align_u >
+cc0::chunked_array<type_t,segment_size_u,align_u>::~chunked_array( void )
+{
+	destroy(false);
+}
+
+template < typename type_t, uint64_t segment_size_u, uint64_t align_u >
+cc0::chunked_array<type_t,segment_size_u,align_u> &cc0::chunked_array<type_t,segment_size_u,align_u>::operator=(const cc0::chunked_array<type_t,segment_size_u,align_u> &arr)
+{
+	if (this != &arr) {
+		destroy(true);
+		reserve(arr.m_size);
+		for (uint64_t i = 0; i < arr.segment_count(); ++i) {
+			const cc0::slice<const type_t> src = arr.segment(i);
+			cc0::internal::copy_construct(m_segments[i], static_cast<const type_t*>(src), src.size());
+			m_size += src.size();
+		}
+	}
+	return *this;
+}
+
+template < typename type_t, uint64_t segment_size_u, uint64_t align_u >
+cc0::chunked_array<type_t,segment_size_u,align_u> &cc0::chunked_array<type_t,segment_size_u,align_u>::operator=(cc0::chunked_array<type_t,segment_size_u,align_u> &&arr)
+{
+	if (this != &arr) {
+		destroy(false);
+		m_segments = std::move(arr.m_segments);
+		m_size = arr.m_size;
+		m_allocator = arr.m_allocator;
+		arr.m_size = 0;
+	}
+	return *this;
+}
+
+template < typename type_t, uint64_t segment_size_u, uint64_t align_u >
+void cc0::chunked_array<type_t,segment_size_u,align_u>::destroy(bool use_pool)
+{
+	for (uint64_t i = 0; i < segment_count(); ++i) {
+		cc0::internal::destruct(m_segments[i], segment(i).size());
+	}
+	m_size = 0;
+	if (!use_pool) {
+		remove_segments(0);
+		m_segments.destroy(false);
+	}
+}
+
+template < typename type_t, uint64_t segment_size_u, uint64_t align_u >
+void cc0::chunked_array<type_t,segment_size_u,align_u>::reserve(uint64_t capacity)
+{
+	m_segments.reserve((capacity + segment_size_u - 1) / segment_size_u);
+	add_segments(capacity);
+}
+
+template < typename type_t, uint64_t segment_size_u, uint64_t align_u >
+void cc0::chunked_array<type_t,segment_size_u,align_u>::resize(uint64_t size)
+{
+	while (m_size > size) {
+		pop_back();
+	}
+	reserve(size);
+	while (m_size < size) {
+		const uint64_t offset = m_size % segment_size_u;
+		const uint64_t count = size - m_size < segment_size_u - offset ? size - m_size : segment_size_u - offset;
+		cc0::internal::construct(m_segments[m_size / segment_size_u] + offset, count);
+		m_size += count;
+	}
+}
+
+template < typename type_t, uint64_t segment_size_u, uint64_t align_u >
+void cc0::chunked_array<type_t,segment_size_u,align_u>::push_back(const type_t &value)
+{
+	emplace_back(value);
+}
+
+template < typename type_t, uint64_t segment_size_u, uint64_t align_u >
+void cc0::chunked_array<type_t,segment_size_u,align_u>::push_back(type_t &&value)
+{
+	emplace_back(std::move(value));
+}
+
+template < typename type_t, uint64_t segment_size_u, uint64_t align_u >
+template < typename... args_t >
+type_t &cc0::chunked_array<type_t,segment_size_u,align_u>::emplace_back(args_t&&... args)
+{
+	// Existing elements never move, so arguments referencing them remain valid while the new segment is allocated.
+	type_t *mem = next();
+	new (mem) type_t(std::forward<args_t>(args)...);
+	++m_size;
+	return *mem;
+}
+
+template < typename type_t, uint64_t segment_size_u, uint64_t align_u >
+void cc0::chunked_array<type_t,segment_size_u,align_u>::append(cc0::slice<const type_t> values)
+{
+	reserve(m_size + values.size());
+	uint64_t done = 0;
+	while (done < values.size()) {
+		const uint64_t offset = m_size % segment_size_u;
+		const uint64_t count = values.size() - done < segment_size_u - offset ? values.size() - done : segment_size_u - offset;
+		cc0::internal::copy_construct(m_segments[m_size / segment_size_u] + offset, static_cast<const type_t*>(values) + done, count);
+		m_size += count;
+		done += count;
+	}
+}
+
+template < typename type_t, uint64_t segment_size_u, uint64_t align_u >
+void cc0::chunked_array<type_t,segment_size_u,align_u>::pop_back( void )
+{
+	CC0_ARR_ASSERT(m_size > 0);
+	--m_size;
+	cc0::internal::destruct(m_segments[m_size / segment_size_u] + m_size % segment_size_u, 1);
+}
+
+template < typename type_t, uint64_t segment_size_u, uint64_t align_u >
+void cc0::chunked_array<type_t,segment_size_u,align_u>::shrink_to_fit( void )
+{
+	remove_segments(m_size);
+	m_segments.shrink_to_fit();
+}
+
+template < typename type_t, uint64_t segment_size_u, uint64_t align_u >
+cc0::allocator *cc0::chunked_array<type_t,segment_size_u,align_u>::get_allocator( void ) const
+{
+	return m_allocator;
+}
+
+template < typename type_t, uint64_t segment_size_u, uint64_t align_u >
+void cc0::chunked_array<type_t,segment_size_u,align_u>::set_allocator(cc0::allocator *allocator)
+{
+	destroy(false);
+	m_allocator = allocator != nullptr ? allocator : cc0::default_allocator();
+}
+
+template < typename type_t, uint64_t segment_size_u, uint64_t align_u >
+type_t &cc0::chunked_array<type_t,segment_size_u,align_u>::operator[](uint64_t i)
+{
+	CC0_ARR_ASSERT(i < m_size);
+	return m_segments[i / segment_size_u][i % segment_size_u];
+}
+
+template < typename type_t, uint64_t segment_size_u, uint64_t align_u >
+const type_t &cc0::chunked_array<type_t,segment_size_u,align_u>::operator[](uint64_t i) const
+{
+	CC0_ARR_ASSERT(i < m_size);
+	return m_segments[i / segment_size_u][i % segment_size_u];
+}
+
+template < typename type_t, uint64_t segment_size_u, uint64_t align_u >
+cc0::slice<type_t> cc0::chunked_array<type_t,segment_size_u,align_u>::segment(uint64_t i)
+{
+	CC0_ARR_ASSERT(i < segment_count());
+	const uint64_t start = i * segment_size_u;
+	return cc0::slice<type_t>(m_segments[i], m_size - start < segment_size_u ? m_size - start : segment_size_u);
+}
+
+template < typename type_t, uint64_t segment_size_u, uint64_t align_u >
+cc0::slice<const type_t> cc0::chunked_array<type_t,segment_size_u,align_u>::segment(uint64_t i) const
+{
+	CC0_ARR_ASSERT(i < segment_count());
+	const uint64_t start = i * segment_size_u;
+	return cc0::slice<const type_t>(static_cast<const type_t*>(m_segments[i]), m_size - start < segment_size_u ? m_size - start : segment_size_u);
+}
+
+template < typename type_t, uint64_t segment_size_u, uint64_t align_u >
+template < typename fn_t >
+void cc0::chunked_array<type_t,segment_size_u,align_u>::for_each_segment(fn_t fn)
+{
+	const uint64_t count = segment_count();
+	for (uint64_t i = 0; i < count; ++i) {
+		fn(segment(i));
+	}
+}
+
+template < typename type_t, uint64_t segment_size_u, uint64_t align_u >
+template < typename fn_t >
+void cc0::chunked_array<type_t,segment_size_u,align_u>::for_each_segment(fn_t fn) const
+{
+	const uint64_t count = segment_count();
+	for (uint64_t i = 0; i < count; ++i) {
+		fn(segment(i));
+	}
+}
+
+template < typename type_t, uint64_t segment_size_u, uint64_t align_u >
+uint64_t cc0::chunked_array<type_t,segment_size_u,align_u>::segment_count( void ) const
+{
+	return (m_size + segment_size_u - 1) / segment_size_u;
+}
+
+template < typename type_t, uint64_t segment_size_u, uint64_t align_u >
+uint64_t cc0::chunked_array<type_t,segment_size_u,align_u>::size( void ) const
+{
+	return m_size;
+}
+
+template < typename type_t, uint64_t segment_size_u, uint64_t align_u >
+uint64_t cc0::chunked_array<type_t,segment_size_u,align_u>::capacity( void ) const
+{
+	return m_segments.size() * segment_size_u;
+}
+
+#endif
@@ -0,0 +1,472 @@
+/// @file
+/// @author github.com/SirJonthe
+/// @date 2023
+/// @copyright Public domain.
+/// @license CC0 1.0
+
+#ifndef CC0_ARR_CONCURRENT_H_INCLUDED__
+#define CC0_ARR_CONCURRENT_H_INCLUDED__
+
+#include <atomic>
+#include "arr.h"
+
+namespace cc0
+{
+	namespace internal
+	{
+		/// @brief Computes the base two logarithm of a number, rounded down.
+		/// @param n The number. Must not be 0.
+		/// @return The index of the highest set bit.
+		uint64_t floor_log2(uint64_t n);
+	}
+
+	template < typename type_t >
+	class concurrent_snapshot;
+
+	/// @brief An array that any number of threads can append to at the same time. Appending reserves indices with a single atomic addition, and storage grows by adding segments of doubling size, so elements are never moved once written and readers can access them while other threads append. Each element has a ready flag that is set once it is written, and the published size is advanced over the ready flags by whichever appending thread finds them set, so readers always see a contiguous prefix of fully written elements.
+	/// @note Appending is lock-free, as no appending thread waits for another. Publication is not, as an element is only published once all elements before it are written, so a thread stalled while writing an element delays the publication, but not the writing, of later elements. Appending may allocate a new segment unless enough storage has been reserved up front.
+	/// @warning Constructing elements must not throw.
+	/// @tparam type_t The type of the elements.
+	template < typename type_t >
+	class concurrent_array
+	{
+		friend class cc0::concurrent_snapshot<type_t>;
+
+	private:
+		static constexpr uint64_t max_segments = 64;
+
+		std::atomic<type_t*>   m_segments[max_segments];
+		uint64_t               m_base;
+		uint64_t               m_shift;
+		cc0::allocator        *m_allocator;
+		// The reservation and publication indices are written by every appending thread, so they are kept away from the read-mostly members above.
+		char                   m_pad0[cc0::cache_line_align];
+		std::atomic<uint64_t>  m_reserved;
+		char                   m_pad1[cc0::cache_line_align - sizeof(std::atomic<uint64_t>)];
+		std::atomic<uint64_t>  m_committed;
+		char                   m_pad2[cc0::cache_line_align - sizeof(std::atomic<uint64_t>)];
+
+	private:
+		/// @brief Gets the segment holding an element.
+		/// @param i The index of the element.
+		/// @return The index of the segment.
+		uint64_t segment_of(uint64_t i) const;
+
+		/// @brief Gets the index of the first element of a segment.
+		/// @param k The index of the segment.
+		/// @return The index of the element.
+		uint64_t segment_start(uint64_t k) const;
+
+		/// @brief Gets the capacity of a segment.
+		/// @param k The index of the segment.
+		/// @return The number of elements the segment can hold.
+		uint64_t segment_capacity(uint64_t k) const;
+
+		/// @brief Gets the number of bytes allocated for a segment, holding its elements followed by their ready flags.
+		/// @param k The index of the segment.
+		/// @return The number of bytes.
+		uint64_t segment_bytes(uint64_t k) const;
+
+		/// @brief Gets the ready flags of a segment.
+		/// @param k The index of the segment.
+		/// @param segment The segment.
+		/// @return The ready flags.
+		std::atomic<uint8_t> *ready_flags(uint64_t k, type_t *segment) const;
+
+		/// @brief Gets a segment, allocating it if no thread has yet.
+		/// @param k The index of the segment.
+		/// @return The segment.
+		type_t *acquire_segment(uint64_t k);
+
+		/// @brief Reserves a range of indices.
+		/// @param count The number of indices.
+		/// @return The first index.
+		uint64_t reserve_range(uint64_t count);
+
+		/// @brief Gets the memory of a reserved element.
+		/// @param i The index of the element.
+		/// @return The memory.
+		type_t *slot(uint64_t i);
+
+		/// @brief Marks a written range of elements as ready, and publishes it along with any ready elements after it if all elements before it are published.
+		/// @param start The first index of the range.
+		/// @param count The number of elements in the range.
+		void commit(uint64_t start, uint64_t count);
+
+		/// @brief Advances the published size over elements that are ready.
+		void advance( void );
+
+	public:
+		/// @brief Creates an empty array.
+		/// @param capacity The number of elements the array can hold before allocating a second segment, rounded up to a power of two. Each further segment is twice the size of the previous.
+		/// @param allocator The allocator to allocate segments with. Null selects the default allocator.
+		explicit concurrent_array(uint64_t capacity = 1024, cc0::allocator *allocator = nullptr);
+
+		concurrent_array(const concurrent_array&) = delete;
+		concurrent_array &operator=(const concurrent_array&) = delete;
+
+		/// @brief Destroys the elements and frees all segments. All appends must have returned.
+		~concurrent_array( void );
+
+		/// @brief Appends a copy of an element. Safe to call from any number of threads at the same time.
+		/// @param value The element.
+		/// @return The index of the element.
+		uint64_t append(const type_t &value);
+
+		/// @brief Appends an element by moving it. Safe to call from any number of threads at the same time.
+		/// @param value The element.
+		/// @return The index of the element.
+		uint64_t append(type_t &&value);
+
+		/// @brief Appends copies of a range of elements, which are stored at consecutive indices. Safe to call from any number of threads at the same time.
+		/// @param values The elements.
+		/// @return The index of the first element.
+		uint64_t append_range(cc0::slice<const type_t> values);
+
+		/// @brief Allocates the segments needed to hold a given number of elements, so that appending up to that number allocates no memory. Safe to call from any number of threads at the same time.
+		/// @param count The number of elements.
+		void reserve(uint64_t count);
+
+		/// @brief Destroys all elements, keeping the segments for reuse.
+		/// @warning Not thread safe. No other thread may access the array at the same time.
+		void clear( void );
+
+		/// @brief Takes a snapshot of the published elements, which remains valid while other threads append.
+		/// @return The snapshot.
+		cc0::concurrent_snapshot<type_t> snapshot( void ) const;
+
+		/// @brief Accesses a published element.
+		/// @param i The index of the element. Must be less than the size of the array, or of a snapshot of it.
+		/// @return A reference to the element.
+		const type_t &operator[](uint64_t i) const;
+
+		/// @brief Gets the number of published elements. Elements at lower indices are fully written, and can be read.
+		/// @return The number of published elements.
+		uint64_t size( void ) const;
+	};
+
+	/// @brief A read-only view of the elements of a concurrent array that had been published when the snapshot was taken. Elements are stored in segments, each of which can be viewed as a slice.
+	/// @tparam type_t The type of the elements.
+	template < typename type_t >
+	class concurrent_snapshot
+	{
+	private:
+		const cc0::concurrent_array<type_t> *m_array;
+		uint64_t                             m_size;
+
+	public:
+		/// @brief Creates an empty snapshot.
+		concurrent_snapshot( void );
+
+		/// @brief Creates a snapshot of the first elements of an array.
+		/// @param arr The array.
+		/// @param size The number of elements. Must not exceed the number of published elements.
+		concurrent_snapshot(const cc0::concurrent_array<type_t> &arr, uint64_t size);
+
+		/// @brief Accesses an element.
+		/// @param i The index of the element.
+		/// @return A reference to the element.
+		const type_t &operator[](uint64_t i) const;
+
+		/// @brief Provides a view of the elements of the snapshot in a segment.
+		/// @param k The index of the segment.
+		/// @return The elements.
+		cc0::slice<const type_t> segment(uint64_t k) const;
+
+		/// @brief Calls a function with the elements of each segment in order, allowing bulk operations on contiguous memory.
+		/// @tparam fn_t The type of the function, called as fn(cc0::slice<const type_t>).
+		/// @param fn The function.
+		template < typename fn_t >
+		void for_each_segment(fn_t fn) const;
+
+		/// @brief Gets the number of segments holding elements of the snapshot.
+		/// @return The number of segments.
+		uint64_t segment_count( void ) const;
+
+		/// @brief Gets the size of the snapshot.
+		/// @return The number of elements.
+		uint64_t size( void ) const;
+	};
+}
+
+inline uint64_t cc0::internal::floor_log2(uint64_t n)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return 63 - uint64_t(__builtin_clzll(n));
+#else
+	uint64_t log = 0;
+	while (n >>= 1) {
+		++log;
+	}
+	return log;
+#endif
+}
+
+template < typename type_t >
+uint64_t cc0::concurrent_array<type_t>::segment_of(uint64_t i) const
+{
+	// Segment k starts at base * (2^k - 1), so the segment follows from the highest bit of i / base + 1.
+	return cc0::internal::floor_log2((i >> m_shift) + 1);
+}
+
+template < typename type_t >
+uint64_t cc0::concurrent_array<type_t>::segment_start(uint64_t k) const
+{
+	return ((uint64_t(1) << k) - 1) << m_shift;
+}
+
+template < typename type_t >
+uint64_t cc0::concurrent_array<type_t>::segment_capacity(uint64_t k) const
+{
+	return m_base << k;
+}
+
+template < typename type_t >
+uint64_t cc0::concurrent_array<type_t>::segment_bytes(uint64_t k) const
+{
+	return segment_capacity(k) * (sizeof(type_t) + sizeof(std::atomic<uint8_t>));
+}
+
+template < typename type_t >
+std::atomic<uint8_t> *cc0::concurrent_array<type_t>::ready_flags(uint64_t k, type_t *segment) const
+{
+	return reinterpret_cast<std::atomic<uint8_t>*>(reinterpret_cast<char*>(segment + segment_capacity(k)));
+}
+
+template < typename type_t >
+type_t *cc0::concurrent_array<type_t>::acquire_segment(uint64_t k)
+{
+	type_t *segment = m_segments[k].load(std::memory_order_acquire);
+	if (segment == nullptr) {
+		// Threads reaching a new segment at the same time race to install it, and the losers free their allocation.
+		type_t *mem = static_cast<type_t*>(cc0::internal::allocate(m_allocator, segment_bytes(k), alignof(type_t)));
+		std::atomic<uint8_t> *flags = ready_flags(k, mem);
+		for (uint64_t i = 0; i < segment_capacity(k); ++i) {
+			new (flags + i) std::atomic<uint8_t>(0);
+		}
+		if (m_segments[k].compare_exchange_strong(segment, mem, std::memory_order_acq_rel, std::memory_order_acquire)) {
+			segment = mem;
+		} else {
+			cc0::internal::deallocate(m_allocator, mem, segment_bytes(k), alignof(type_t));
+		}
+	}
+	return segment;
+}
+
+template < typename type_t >
+uint64_t cc0::concurrent_array<type_t>::reserve_range(uint64_t count)
+{
+	return m_reserved.fetch_add(count, std::memory_order_relaxed);
+}
+
+template < typename type_t >
+type_t *cc0::concurrent_array<type_t>::slot(uint64_t i)
+{
+	const uint64_t k = segment_of(i);
+	return acquire_segment(k) + (i - segment_start(k));
+}
+
+template < typename type_t >
+void cc0::concurrent_array<type_t>::commit(uint64_t start, uint64_t count)
+{
+	for (uint64_t done = 0; done < count;) {
+		const uint64_t i = start + done;
+		const uint64_t k = segment_of(i);
+		const uint64_t offset = i - segment_start(k);
+		const uint64_t n = count - done < segment_capacity(k) - offset ? count - done : segment_capacity(k) - offset;
+		std::atomic<uint8_t> *flags = ready_flags(k, m_segments[k].load(std::memory_order_acquire)) + offset;
+		for (uint64_t j = 0; j < n; ++j) {
+			flags[j].store(1, std::memory_order_seq_cst);
+		}
+		done += n;
+	}
+	advance();
+}
+
+template < typename type_t >
+void cc0::concurrent_array<type_t>::advance( void )
+{
+	// Flags are set and the published size is read in sequentially consistent order, so of two threads finishing adjacent ranges at the same time at least one sees the flags of the other, and no ready element is left unpublished.
+	uint64_t committed = m_committed.load(std::memory_order_seq_cst);
+	for (;;) {
+		uint64_t end = committed;
+		for (;;) {
+			const uint64_t k = segment_of(end);
+			type_t *segment = m_segments[k].load(std::memory_order_acquire);
+			if (segment == nullptr) {
+				break;
+			}
+			const std::atomic<uint8_t> *flags = ready_flags(k, segment);
+			const uint64_t capacity = segment_capacity(k);
+			uint64_t offset = end - segment_start(k);
+			while (offset < capacity && flags[offset].load(std::memory_order_seq_cst) != 0) {
+				++offset;
+			}
+			end = segment_start(k) + offset;
+			if (offset < capacity) {
+				break;
+			}
+		}
+		if (end == committed) {
+			return;
+		}
+		// On failure another thread has published further, and the scan resumes from where it stopped.
+		if (m_committed.compare_exchange_weak(committed, end, std::memory_order_seq_cst)) {
+			committed = end;
+		}
+	}
+}
+
+template < typename type_t >
+cc0::concurrent_array<type_t>::concurrent_array(uint64_t capacity, cc0::allocator *allocator) : m_base(1), m_shift(0), m_allocator(allocator != nullptr ? allocator : cc0::default_allocator()), m_reserved(0), m_committed(0)
+{
+	while (m_base < capacity) {
+		m_base <<= 1;
+		++m_shift;
+	}
+	for (uint64_t k = 0; k < max_segments; ++k) {
+		m_segments[k].store(nullptr, std::memory_order_relaxed);
+	}
+}
+
+template < typename type_t >
+cc0::concurrent_array<type_t>::~concurrent_array( void )
+{
+	clear();
+	for (uint64_t k = 0; k < max_segments; ++k) {
+		type_t *segment = m_segments[k].load(std::memory_order_relaxed);
+		if (segment != nullptr) {
+			cc0::internal::deallocate(m_allocator, segment, segment_bytes(k), alignof(type_t));
+		}
+	}
+}
+
+template < typename type_t >
+uint64_t cc0::concurrent_array<type_t>::append(const type_t &value)
+{
+	const uint64_t i = reserve_range(1);
+	new (slot(i)) type_t(value);
+	commit(i, 1);
+	return i;
+}
+
+template < typename type_t >
+uint64_t cc0::concurrent_array<type_t>::append(type_t &&value)
+{
+	const uint64_t i = reserve_range(1);
+	new (slot(i)) type_t(std::move(value));
+	commit(i, 1);
+	return i;
+}
+
+template < typename type_t >
+uint64_t cc0::concurrent_array<type_t>::append_range(cc0::slice<const type_t> values)
+{
+	const uint64_t start = reserve_range(values.size());
+	if (values.size() == 0) {
+		return start;
+	}
+	uint64_t done = 0;
+	while (done < values.size()) {
+		const uint64_t i = start + done;
+		const uint64_t k = segment_of(i);
+		const uint64_t offset = i - segment_start(k);
+		const uint64_t count = values.size() - done < segment_capacity(k) - offset ? values.size() - done : segment_capacity(k) - offset;
+		cc0::internal::copy_construct(acquire_segment(k) + offset, static_cast<const type_t*>(values) + done, count);
+		done += count;
+	}
+	commit(start, values.size());
+	return start;
+}
+
+template < typename type_t >
+void cc0::concurrent_array<type_t>::reserve(uint64_t count)
+{
+	for (uint64_t k = 0; k < max_segments && segment_start(k) < count; ++k) {
+		acquire_segment(k);
+	}
+}
+
+template < typename type_t >
+void cc0::concurrent_array<type_t>::clear( void )
+{
+	const uint64_t size = m_committed.load(std::memory_order_relaxed);
+	for (uint64_t k = 0; k < max_segments && segment_start(k) < size; ++k) {
+		type_t *segment = m_segments[k].load(std::memory_order_relaxed);
+		const uint64_t count = size - segment_start(k) < segment_capacity(k) ? size - segment_start(k) : segment_capacity(k);
+		cc0::internal::destruct(segment, count);
+		std::atomic<uint8_t> *flags = ready_flags(k, segment);
+		for (uint64_t i = 0; i < count; ++i) {
+			flags[i].store(0, std::memory_order_relaxed);
+		}
+	}
+	m_reserved.store(0, std::memory_order_relaxed);
+	m_committed.store(0, std::memory_order_relaxed);
+}
+
+template < typename type_t >
+cc0::concurrent_snapshot<type_t> cc0::concurrent_array<type_t>::snapshot( void ) const
+{
+	return cc0::concurrent_snapshot<type_t>(*this, size());
+}
+
+template < typename type_t >
+const type_t &cc0::concurrent_array<type_t>::operator[](uint64_t i) const
+{
+	const uint64_t k = segment_of(i);
+	return m_segments[k].load(std::memory_order_relaxed)[i - segment_start(k)];
+}
+
+template < typename type_t >
+uint64_t cc0::concurrent_array<type_t>::size( void ) const
+{
+	return m_committed.load(std::memory_order_acquire);
+}
+
+template < typename type_t >
+cc0::concurrent_snapshot<type_t>::concurrent_snapshot( void ) : m_array(nullptr), m_size(0)
+{}
+
+template < typename type_t >
+cc0::concurrent_snapshot<type_t>::concurrent_snapshot(const cc0::concurrent_array<type_t> &arr, uint64_t size) : m_array(&arr), m_size(size)
+{}
+
+template < typename type_t >
+const type_t &cc0::concurrent_snapshot<type_t>::operator[](uint64_t i) const
+{
+	CC0_ARR_ASSERT(i < m_size);
+	return (*m_array)[i];
+}
+
+template < typename type_t >
+cc0::slice<const type_t> cc0::concurrent_snapshot<type_t>::segment(uint64_t k) const
+{
+	CC0_ARR_ASSERT(k < segment_count());
+	const uint64_t start = m_array->segment_start(k);
+	const uint64_t capacity = m_array->segment_capacity(k);
+	return cc0::slice<const type_t>(static_cast<const type_t*>(m_array->m_segments[k].load(std::memory_order_relaxed)), m_size - start < capacity ? m_size - start : capacity);
+}
+
+template < typename type_t >
+template < typename fn_t >
+void cc0::concurrent_snapshot<type_t>::for_each_segment(fn_t fn) const
+{
+	const uint64_t count = segment_count();
+	for (uint64_t k = 0; k < count; ++k) {
+		fn(segment(k));
+	}
+}
+
+template < typename type_t >
+uint64_t cc0::concurrent_snapshot<type_t>::segment_count( void ) const
+{
+	return m_size > 0 ? m_array->segment_of(m_size - 1) + 1 : 0;
+}
+
+template < typename type_t >
+uint64_t cc0::concurrent_snapshot<type_t>::size( void ) const
+{
+	return m_size;
+}
+
+#endif
@@ -0,0 +1,395 @@
+/// @file
+/// @author github.com/SirJonthe
+/// @date 2023
+/// @copyright Public domain.
+/// @license CC0 1.0
+
+#ifndef CC0_ARR_EXPR_H_INCLUDED__
+#define CC0_ARR_EXPR_H_INCLUDED__
+
+#include "arr.h"
+
+namespace cc0
+{
+	template < typename node_t >
+	class expression;
+
+	namespace internal
+	{
+		/// @brief An expression node reading the elements of a slice.
+		/// @tparam type_t The type of the elements.
+		template < typename type_t >
+		struct expr_leaf
+		{
+			const type_t *values; // The elements.
+			uint64_t      count;  // The number of elements.
+
+			/// @brief Gets an element.
+			/// @param i The index of the element.
+			/// @return The element.
+			const type_t &operator[](uint64_t i) const { return values[i]; }
+
+			/// @brief Gets the number of elements.
+			/// @return The number of elements.
+			uint64_t size( void ) const { return count; }
+		};
+
+		/// @brief An expression node broadcasting a scalar to every element.
+		/// @tparam type_t The type of the scalar.
+		template < typename type_t >
+		struct expr_scalar
+		{
+			type_t value; // The scalar.
+
+			/// @brief Gets the scalar.
+			/// @return The scalar.
+			const type_t &operator[](uint64_t) const { return value; }
+
+			/// @brief Gets the number of elements, which is unbounded for scalars.
+			/// @return The largest possible size.
+			uint64_t size( void ) const { return ~uint64_t(0); }
+		};
+
+		/// @brief An expression node combining the elements of two nodes.
+		/// @tparam op_t The operation.
+		/// @tparam lhs_t The left-hand node.
+		/// @tparam rhs_t The right-hand node.
+		template < typename op_t, typename lhs_t, typename rhs_t >
+		struct expr_binary
+		{
+			lhs_t lhs; // The left-hand node.
+			rhs_t rhs; // The right-hand node.
+
+			/// @brief Computes an element.
+			/// @param i The index of the element.
+			/// @return The element.
+			auto operator[](uint64_t i) const -> decltype(op_t::apply(lhs[i], rhs[i])) { return op_t::apply(lhs[i], rhs[i]); }
+
+			/// @brief Gets the number of elements, which is the smaller of the sizes of the nodes.
+			/// @return The number of elements.
+			uint64_t size( void ) const { return lhs.size() < rhs.size() ? lhs.size() : rhs.size(); }
+		};
+
+		/// @brief An expression node transforming the elements of a node.
+		/// @tparam op_t The operation.
+		/// @tparam arg_t The node.
+		template < typename op_t, typename arg_t >
+		struct expr_unary
+		{
+			arg_t arg; // The node.
+
+			/// @brief Computes an element.
+			/// @param i The index of the element.
+			/// @return The element.
+			auto operator[](uint64_t i) const -> decltype(op_t::apply(arg[i])) { return op_t::apply(arg[i]); }
+
+			/// @brief Gets the number of elements.
+			/// @return The number of elements.
+			uint64_t size( void ) const { return arg.size(); }
+		};
+
+		/// @brief The element-wise operations of expressions.
+		struct expr_add { template < typename a_t, typename b_t > static auto apply(const a_t &a, const b_t &b) -> decltype(a + b) { return a + b; } };
+		struct expr_sub { template < typename a_t, typename b_t > static auto apply(const a_t &a, const b_t &b) -> decltype(a - b) { return a - b; } };
+		struct expr_mul { template < typename a_t, typename b_t > static auto apply(const a_t &a, const b_t &b) -> decltype(a * b) { return a * b; } };
+		struct expr_div { template < typename a_t, typename b_t > static auto apply(const a_t &a, const b_t &b) -> decltype(a / b) { return a / b; } };
+		struct expr_neg { template < typename a_t > static auto apply(const a_t &a) -> decltype(-a) { return -a; } };
+
+		/// @brief Converts the operands of expression operators to expression nodes. Only expressions, slices, arrays and arithmetic scalars are operands.
+		/// @tparam type_t The type of the operand.
+		template < typename type_t, typename enable_t = void >
+		struct expr_operand
+		{
+			static constexpr bool is_operand = false;
+			static constexpr bool is_lazy = false;
+		};
+
+		template < typename node_t >
+		struct expr_operand< cc0::expression<node_t> >
+		{
+			typedef node_t type;
+			static constexpr bool is_operand = true;
+			static constexpr bool is_lazy = true;
+			static node_t get(const cc0::expression<node_t> &e) { return e.node(); }
+		};
+
+		template < typename type_t >
+		struct expr_operand< cc0::slice<type_t> >
+		{
+			typedef cc0::internal::expr_leaf<typename std::remove_cv<type_t>::type> type;
+			static constexpr bool is_operand = true;
+			static constexpr bool is_lazy = false;
+			static type get(const cc0::slice<type_t> &s) { type n = { static_cast<const type_t*>(s), s.size() }; return n; }
+		};
+
+		template < typename type_t, uint64_t size_u, uint64_t align_u >
+		struct expr_operand< cc0::array<type_t,size_u,align_u> >
+		{
+			typedef cc0::internal::expr_leaf<typename std::remove_cv<type_t>::type> type;
+			static constexpr bool is_operand = true;
+			static constexpr bool is_lazy = false;
+			static type get(const cc0::array<type_t,size_u,align_u> &a) { type n = { static_cast<const type_t*>(a), a.size() }; return n; }
+		};
+
+		template < typename type_t >
+		struct expr_operand< type_t, typename std::enable_if<std::is_arithmetic<type_t>::value>::type >
+		{
+			typedef cc0::internal::expr_scalar<type_t> type;
+			static constexpr bool is_operand = true;
+			static constexpr bool is_lazy = false;
+			static type get(const type_t &s) { type n = { s }; return n; }
+		};
+
+		template < bool enable_b, typename op_t, typename lhs_t, typename rhs_t >
+		struct expr_result_if {};
+
+		template < typename op_t, typename lhs_t, typename rhs_t >
+		struct expr_result_if<true, op_t, lhs_t, rhs_t>
+		{
+			typedef cc0::expression< cc0::internal::expr_binary<op_t, typename cc0::internal::expr_operand<lhs_t>::type, typename cc0::internal::expr_operand<rhs_t>::type> > type;
+		};
+
+		/// @brief Determines the result of an expression operator. Only defined if both operands are valid operands and at least one of them is an expression, so that arithmetic on other types in the namespace, and on arrays and slices outside of expressions, keeps its usual meaning.
+		/// @tparam op_t The operation.
+		/// @tparam lhs_t The type of the left-hand operand.
+		/// @tparam rhs_t The type of the right-hand operand.
+		template < typename op_t, typename lhs_t, typename rhs_t >
+		struct expr_result : cc0::internal::expr_result_if<
+			cc0::internal::expr_operand<lhs_t>::is_operand && cc0::internal::expr_operand<rhs_t>::is_operand &&
+			(cc0::internal::expr_operand<lhs_t>::is_lazy || cc0::internal::expr_operand<rhs_t>::is_lazy),
+			op_t, lhs_t, rhs_t
+		> {};
+	}
+
+	/// @brief A lazily evaluated element-wise expression over slices and arrays. Arithmetic on expressions builds a new expression rather than computing anything, and the whole expression is evaluated in a single loop without temporary arrays when assigned to an array or slice. Expressions are created from slices and arrays with lazy.
+	/// @warning Expressions reference the elements of their operands, and must not outlive them.
+	/// @tparam node_t The root node of the expression.
+	template < typename node_t >
+	class expression
+	{
+	private:
+		node_t m_node;
+
+	public:
+		/// @brief The type of the elements computed by the expression.
+		typedef typename std::remove_cv<typename std::remove_reference<decltype(std::declval<const node_t&>()[0])>::type>::type value_type;
+
+	public:
+		/// @brief Creates an expression from a node.
+		/// @param node The root node.
+		explicit expression(const node_t &node);
+
+		/// @brief Computes an element of the expression.
+		/// @param i The index of the element.
+		/// @return The element.
+		value_type operator[](uint64_t i) const;
+
+		/// @brief Gets the number of elements of the expression, which is the smallest size of its operands.
+		/// @return The number of elements.
+		uint64_t size( void ) const;
+
+		/// @brief Gets the root node of the expression.
+		/// @return The root node.
+		const node_t &node( void ) const;
+
+		/// @brief Evaluates the expression into a new array.
+		/// @tparam type_t The type of the array.
+		/// @tparam align_u The alignment of the array.
+		/// @return The array.
+		template < typename type_t, uint64_t align_u >
+		operator cc0::array<type_t,0,align_u>( void ) const;
+	};
+
+	/// @brief Starts an expression from a slice.
+	/// @tparam type_t The type of the slice.
+	/// @param s The slice.
+	/// @return The expression.
+	template < typename type_t >
+	cc0::expression< cc0::internal::expr_leaf<typename std::remove_cv<type_t>::type> > lazy(cc0::slice<type_t> s);
+
+	/// @brief Starts an expression from an array.
+	/// @tparam type_t The type of the array.
+	/// @tparam size_u The size of the array.
+	/// @tparam align_u The alignment of the array.
+	/// @param a The array.
+	/// @return The expression.
+	template < typename type_t, uint64_t size_u, uint64_t align_u >
+	cc0::expression< cc0::internal::expr_leaf<typename std::remove_cv<type_t>::type> > lazy(const cc0::array<type_t,size_u,align_u> &a);
+
+	/// @brief Adds the elements of two operands lazily. One operand must be an expression, while the other may be an expression, a slice, an array or a scalar.
+	/// @param a The left-hand operand.
+	/// @param b The right-hand operand.
+	/// @return The expression.
+	template < typename lhs_t, typename rhs_t >
+	typename cc0::internal::expr_result<cc0::internal::expr_add,lhs_t,rhs_t>::type operator+(const lhs_t &a, const rhs_t &b);
+
+	/// @brief Subtracts the elements of two operands lazily. One operand must be an expression, while the other may be an expression, a slice, an array or a scalar.
+	/// @param a The left-hand operand.
+	/// @param b The right-hand operand.
+	/// @return The expression.
+	template < typename lhs_t, typename rhs_t >
+	typename cc0::internal::expr_result<cc0::internal::expr_sub,lhs_t,rhs_t>::type operator-(const lhs_t &a, const rhs_t &b);
+
+	/// @brief Multiplies the elements of two operands lazily. One operand must be an expression, while the other may be an expression, a slice, an array or a scalar.
+	/// @param a The left-hand operand.
+	/// @param b The right-hand operand.
+	/// @return The expression.
+	template < typename lhs_t, typename rhs_t >
+	typename cc0::internal::expr_result<cc0::internal::expr_mul,lhs_t,rhs_t>::type operator*(const lhs_t &a, const rhs_t &b);
+
+	/// @brief Divides the elements of two operands lazily. One operand must be an expression, while the other may be an expression, a slice, an array or a scalar.
+	/// @param a The left-hand operand.
+	/// @param b The right-hand operand.
+	/// @return The expression.
+	template < typename lhs_t, typename rhs_t >
+	typename cc0::internal::expr_result<cc0::internal::expr_div,lhs_t,rhs_t>::type operator/(const lhs_t &a, const rhs_t &b);
+
+	/// @brief Negates the elements of an expression lazily.
+	/// @tparam node_t The root node of the expression.
+	/// @param a The expression.
+	/// @return The expression.
+	template < typename node_t >
+	cc0::expression< cc0::internal::expr_unary<cc0::internal::expr_neg,node_t> > operator-(const cc0::expression<node_t> &a);
+
+	/// @brief Evaluates an expression into a slice in a single loop.
+	/// @note The slice may be one of the operands of the expression, as each element is only read before it is written.
+	/// @tparam type_t The type of the slice.
+	/// @tparam node_t The root node of the expression.
+	/// @param dst The slice to write to.
+	/// @param e The expression.
+	/// @return The number of elements written, i.e. the smaller of the sizes of the slice and the expression.
+	template < typename type_t, typename node_t >
+	uint64_t evaluate(cc0::slice<type_t> dst, const cc0::expression<node_t> &e);
+
+	/// @brief Evaluates an expression into a fixed-size array in a single loop.
+	/// @note The array may be one of the operands of the expression, as each element is only read before it is written.
+	/// @tparam type_t The type of the array.
+	/// @tparam size_u The size of the array.
+	/// @tparam align_u The alignment of the array.
+	/// @tparam node_t The root node of the expression.
+	/// @param dst The array to write to.
+	/// @param e The expression.
+	/// @return The number of elements written, i.e. the smaller of the sizes of the array and the expression.
+	template < typename type_t, uint64_t size_u, uint64_t align_u, typename node_t >
+	uint64_t evaluate(cc0::array<type_t,size_u,align_u> &dst, const cc0::expression<node_t> &e);
+
+	/// @brief Evaluates an expression into a variable-size array in a single loop, resizing the array to the size of the expression. Existing memory is reused if it is large enough.
+	/// @note The array may be one of the operands of the expression, as each element is only read before it is written, and the array is never larger than its operands.
+	/// @tparam type_t The type of the array.
+	/// @tparam align_u The alignment of the array.
+	/// @tparam node_t The root node of the expression.
+	/// @param dst The array to write to.
+	/// @param e The expression.
+	/// @return The number of elements written.
+	template < typename type_t, uint64_t align_u, typename node_t >
+	uint64_t evaluate(cc0::array<type_t,0,align_u> &dst, const cc0::expression<node_t> &e);
+}
+
+template < typename node_t >
+cc0::expression<node_t>::expression(const node_t &node) : m_node(node)
+{}
+
+template < typename node_t >
+typename cc0::expression<node_t>::value_type cc0::expression<node_t>::operator[](uint64_t i) const
+{
+	return m_node[i];
+}
+
+template < typename node_t >
+uint64_t cc0::expression<node_t>::size( void ) const
+{
+	return m_node.size();
+}
+
+template < typename node_t >
+const node_t &cc0::expression<node_t>::node( void ) const
+{
+	return m_node;
+}
+
+template < typename node_t >
+template < typename type_t, uint64_t align_u >
+cc0::expression<node_t>::operator cc0::array<type_t,0,align_u>( void ) const
+{
+	cc0::array<type_t,0,align_u> a;
+	cc0::evaluate(a, *this);
+	return a;
+}
+
+template < typename type_t >
+cc0::expression< cc0::internal::expr_leaf<typename std::remove_cv<type_t>::type> > cc0::lazy(cc0::slice<type_t> s)
+{
+	return cc0::expression< cc0::internal::expr_leaf<typename std::remove_cv<type_t>::type> >(cc0::internal::expr_operand< cc0::slice<type_t> >::get(s));
+}
+
+template < typename type_t, uint64_t size_u, uint64_t align_u >
+cc0::expression< cc0::internal::expr_leaf<typename std::remove_cv<type_t>::type> > cc0::lazy(const cc0::array<type_t,size_u,align_u> &a)
+{
+	return cc0::expression< cc0::internal::expr_leaf<typename std::remove_cv<type_t>::type> >(cc0::internal::expr_operand< cc0::array<type_t,size_u,align_u> >::get(a));
+}
+
+template < typename lhs_t, typename rhs_t >
+typename cc0::internal::expr_result<cc0::internal::expr_add,lhs_t,rhs_t>::type cc0::operator+(const lhs_t &a, const rhs_t &b)
+{
+	typedef typename cc0::internal::expr_result<cc0::internal::expr_add,lhs_t,rhs_t>::type result_t;
+	typename std::remove_const<typename std::remove_reference<decltype(std::declval<result_t>().node())>::type>::type n = { cc0::internal::expr_operand<lhs_t>::get(a), cc0::internal::expr_operand<rhs_t>::get(b) };
+	return result_t(n);
+}
+
+template < typename lhs_t, typename rhs_t >
+typename cc0::internal::expr_result<cc0::internal::expr_sub,lhs_t,rhs_t>::type cc0::operator-(const lhs_t &a, const rhs_t &b)
+{
+	typedef typename cc0::internal::expr_result<cc0::internal::expr_sub,lhs_t,rhs_t>::type result_t;
+	typename std::remove_const<typename std::remove_reference<decltype(std::declval<result_t>().node())>::type>::type n = { cc0::internal::expr_operand<lhs_t>::get(a), cc0::internal::expr_operand<rhs_t>::get(b) };
+	return result_t(n);
+}
+
+template < typename lhs_t, typename rhs_t >
+typename cc0::internal::expr_result<cc0::internal::expr_mul,lhs_t,rhs_t>::type cc0::operator*(const lhs_t &a, const rhs_t &b)
+{
+	typedef typename cc0::internal::expr_result<cc0::internal::expr_mul,lhs_t,rhs_t>::type result_t;
+	typename std::remove_const<typename std::remove_reference<decltype(std::declval<result_t>().node())>::type>::type n = { cc0::internal::expr_operand<lhs_t>::get(a), cc0::internal::expr_operand<rhs_t>::get(b) };
+	return result_t(n);
+}
+
+template < typename lhs_t, typename rhs_t >
+typename cc0::internal::expr_result<cc0::internal::expr_div,lhs_t,rhs_t>::type cc0::operator/(const lhs_t &a, const rhs_t &b)
+{
+	typedef typename cc0::internal::expr_result<cc0::internal::expr_div,lhs_t,rhs_t>::type result_t;
+	typename std::remove_const<typename std::remove_reference<decltype(std::declval<result_t>().node())>::type>::type n = { cc0::internal::expr_operand<lhs_t>::get(a), cc0::internal::expr_operand<rhs_t>::get(b) };
+	return result_t(n);
+}
+
+template < typename node_t >
+cc0::expression< cc0::internal::expr_unary<cc0::internal::expr_neg,node_t> > cc0::operator-(const cc0::expression<node_t> &a)
+{
+	cc0::internal::expr_unary<cc0::internal::expr_neg,node_t> n = { a.node() };
+	return cc0::expression< cc0::internal::expr_unary<cc0::internal::expr_neg,node_t> >(n);
+}
+
+template < typename type_t, typename node_t >
+uint64_t cc0::evaluate(cc0::slice<type_t> dst, const cc0::expression<node_t> &e)
+{
+	const uint64_t size = dst.size() < e.size() ? dst.size() : e.size();
+	type_t *out = dst;
+	const node_t &n = e.node();
+	for (uint64_t i = 0; i < size; ++i) {
+		out[i] = n[i];
+	}
+	return size;
+}
+
+template < typename type_t, uint64_t size_u, uint64_t align_u, typename node_t >
+uint64_t cc0::evaluate(cc0::array<type_t,size_u,align_u> &dst, const cc0::expression<node_t> &e)
+{
+	return cc0::evaluate(dst(0, dst.size()), e);
+}
+
+template < typename type_t, uint64_t align_u, typename node_t >
+uint64_t cc0::evaluate(cc0::array<type_t,0,align_u> &dst, const cc0::expression<node_t> &e)
+{
+	dst.create(e.size(), true);
+	return cc0::evaluate(dst(0, dst.size()), e);
+}
+
+#endif
@@ -0,0 +1,783 @@
+/// @file
+/// @author github.com/SirJonthe
+/// @date 2023
+/// @copyright Public domain.
+/// @license CC0 1.0
+
+#ifndef CC0_ARR_MAP_H_INCLUDED__
+#define CC0_ARR_MAP_H_INCLUDED__
+
+#include <functional>
+#include "arr.h"
+
+namespace cc0
+{
+	namespace internal
+	{
+		/// @brief Hints the CPU to load memory into the cache ahead of use.
+		/// @param mem The memory.
+		void prefetch(const void *mem);
+
+		/// @brief Finds the lowest set bit of a group match.
+		/// @param bits The match. Must not be 0.
+		/// @return The index of the lowest set bit.
+		uint64_t lowest_bit(uint32_t bits);
+
+		/// @brief Finds the control bytes of a group equal to a value.
+		/// @param ctrl The first of 16 control bytes.
+		/// @param value The value.
+		/// @return A mask where bit i is set if the i:th control byte is equal to the value.
+		uint32_t match_byte(const int8_t *ctrl, int8_t value);
+
+		/// @brief Finds the control bytes of a group that mark slots as empty or erased.
+		/// @param ctrl The first of 16 control bytes.
+		/// @return A mask where bit i is set if the i:th slot is free.
+		uint32_t match_free(const int8_t *ctrl);
+
+		/// @brief Scrambles the bits of a hash, so that both the bits selecting start slots and the bits stored in control bytes vary with the whole hash, even for weak hashes such as the identity.
+		/// @param hash The hash.
+		/// @return The scrambled hash.
+		uint64_t mix_hash(uint64_t hash);
+
+		/// @brief An open-addressing hash index over a dense column of keys. Slots are tracked by one control byte each, in the style of SwissTable, holding 7 bits of the hash of the key in the slot, or marking the slot as empty or erased, so that a lookup compares a group of 16 slots at a time and rarely touches keys that do not match. Each slot refers to a key by its position in the key column, so keys stay contiguous, and growing the index never moves them.
+		/// @tparam key_t The type of the keys.
+		/// @tparam hash_t The type of the hash function.
+		template < typename key_t, typename hash_t >
+		class flat_table
+		{
+		public:
+			/// @brief The position returned for keys that are not found.
+			static constexpr uint64_t npos = ~uint64_t(0);
+
+			/// @brief The number of slots compared at a time.
+			static constexpr uint64_t group_size = 16;
+
+		private:
+			static constexpr int8_t ctrl_empty  = -128;
+			static constexpr int8_t ctrl_erased = -2;
+
+			cc0::array<int8_t>    m_ctrl;
+			cc0::array<uint64_t>  m_slots;
+			cc0::array<key_t>     m_keys;
+			uint64_t              m_erased;
+			hash_t                m_hash;
+
+		private:
+			/// @brief Sets the control byte of a slot, mirroring the first group after the last slot so that groups can be loaded from any slot without wrapping.
+			/// @param slot The slot.
+			/// @param value The control byte.
+			void set_ctrl(uint64_t slot, int8_t value);
+
+			/// @brief Finds the first free slot on the probe sequence of a hash.
+			/// @param hash The mixed hash.
+			/// @return The slot.
+			uint64_t find_free(uint64_t hash) const;
+
+			/// @brief Finds the slot referring to a key.
+			/// @param key The key.
+			/// @param hash The mixed hash of the key.
+			/// @return The slot, or npos if the key is not found.
+			uint64_t find_slot(const key_t &key, uint64_t hash) const;
+
+			/// @brief Rebuilds the index with a given number of slots, discarding erased slots.
+			/// @param capacity The number of slots. Must be a power of two no less than the group size.
+			void rehash(uint64_t capacity);
+
+		public:
+			/// @brief Creates an empty table.
+			/// @param allocator The allocator to allocate columns with. Null selects the default allocator.
+			explicit flat_table(cc0::allocator *allocator = nullptr);
+
+			/// @brief Finds a key.
+			/// @param key The key.
+			/// @return The position of the key in the key column, or npos if the key is not found.
+			uint64_t find(const key_t &key) const;
+
+			/// @brief Finds a batch of keys, computing the start slots of several keys and prefetching their control bytes and slots before probing, so that the cache misses of different keys overlap.
+			/// @tparam fn_t The type of the function, called as fn(i, position) for the i:th key.
+			/// @param keys The keys.
+			/// @param count The number of keys.
+			/// @param fn The function, receiving the position of the key in the key column, or npos.
+			template < typename fn_t >
+			void find_many(const key_t *keys, uint64_t count, fn_t fn) const;
+
+			/// @brief Inserts a key if it is not already in the table, appending it to the key column.
+			/// @param key The key.
+			/// @param inserted Set to true if the key was inserted, and to false if it was already in the table.
+			/// @return The position of the key in the key column.
+			uint64_t insert(const key_t &key, bool &inserted);
+
+			/// @brief Erases a key, moving the last key in the key column into its position.
+			/// @param key The key.
+			/// @return The former position of the key in the key column, or npos if the key was not found.
+			uint64_t erase(const key_t &key);
+
+			/// @brief Ensures that a given number of keys can be inserted without rebuilding the index.
+			/// @param count The number of keys.
+			void reserve(uint64_t count);
+
+			/// @brief Removes all keys, keeping memory for reuse.
+			void clear( void );
+
+			/// @brief Removes all keys, and frees allocated memory.
+			void destroy( void );
+
+			/// @brief Provides a view of the keys in the table.
+			/// @return The keys.
+			cc0::slice<const key_t> keys( void ) const;
+
+			/// @brief Gets the allocator used to allocate the columns.
+			/// @return The allocator.
+			cc0::allocator *get_allocator( void ) const;
+
+			/// @brief Gets the number of slots in the index.
+			/// @return The number of slots.
+			uint64_t capacity( void ) const;
+
+			/// @brief Gets the number of keys in the table.
+			/// @return The number of keys.
+			uint64_t size( void ) const;
+		};
+	}
+
+	/// @brief A hash map with open addressing. Keys and values are stored contiguously in array columns, in insertion order unless entries are erased, and are indexed by a table of control bytes that is probed 16 slots at a time. Lookups and inserts allocate no memory per entry.
+	/// @note Inserting may reallocate the columns, which invalidates pointers to values and views of the keys and values. Erasing moves the last entry into the position of the erased entry.
+	/// @tparam key_t The type of the keys. Must be default-constructible and comparable for equality.
+	/// @tparam value_t The type of the values. Must be default-constructible.
+	/// @tparam hash_t The type of the hash function.
+	template < typename key_t, typename value_t, typename hash_t = std::hash<key_t> >
+	class flat_map
+	{
+	private:
+		cc0::internal::flat_table<key_t,hash_t> m_table;
+		cc0::array<value_t>                     m_values;
+
+	public:
+		/// @brief Creates an empty map.
+		/// @param allocator The allocator to allocate columns with. Null selects the default allocator.
+		explicit flat_map(cc0::allocator *allocator = nullptr);
+
+		/// @brief Finds the value of a key.
+		/// @param key The key.
+		/// @return The value, or null if the key is not in the map.
+		value_t *find(const key_t &key);
+
+		/// @brief Finds the value of a key.
+		/// @param key The key.
+		/// @return The value, or null if the key is not in the map.
+		const value_t *find(const key_t &key) const;
+
+		/// @brief Finds the values of a batch of keys, prefetching the index for several keys at a time so that cache misses overlap.
+		/// @tparam key2_t The type of the keys, i.e. key_t or const key_t.
+		/// @param keys The keys.
+		/// @param values Receives the value of each key, or null if the key is not in the map. Must be no smaller than the keys.
+		template < typename key2_t >
+		void find_many(cc0::slice<key2_t> keys, cc0::slice<value_t*> values);
+
+		/// @brief Finds the values of a batch of keys, prefetching the index for several keys at a time so that cache misses overlap.
+		/// @tparam key2_t The type of the keys, i.e. key_t or const key_t.
+		/// @param keys The keys.
+		/// @param values Receives the value of each key, or null if the key is not in the map. Must be no smaller than the keys.
+		template < typename key2_t >
+		void find_many(cc0::slice<key2_t> keys, cc0::slice<const value_t*> values) const;
+
+		/// @brief Checks if a key is in the map.
+		/// @param key The key.
+		/// @return True if the key is in the map.
+		bool contains(const key_t &key) const;
+
+		/// @brief Inserts a key and value if the key is not already in the map.
+		/// @param key The key.
+		/// @param value The value.
+		/// @return True if the key was inserted, and false if it was already in the map, in which case its value is left unchanged.
+		bool insert(const key_t &key, const value_t &value);
+
+		/// @brief Accesses the value of a key, inserting the key with a default-constructed value if it is not in the map.
+		/// @param key The key.
+		/// @return A reference to the value.
+		value_t &operator[](const key_t &key);
+
+		/// @brief Erases a key and its value, moving the last entry into its position.
+		/// @param key The key.
+		/// @return True if the key was erased, and false if it was not in the map.
+		bool erase(const key_t &key);
+
+		/// @brief Ensures that a given number of entries can be inserted without rebuilding the index.
+		/// @param count The number of entries.
+		void reserve(uint64_t count);
+
+		/// @brief Removes all entries, keeping memory for reuse.
+		void clear( void );
+
+		/// @brief Removes all entries, and frees allocated memory.
+		void destroy( void );
+
+		/// @brief Provides a view of the keys of all entries. The i:th key belongs to the i:th value.
+		/// @return The keys.
+		cc0::slice<const key_t> keys( void ) const;
+
+		/// @brief Provides a view of the values of all entries. The i:th value belongs to the i:th key.
+		/// @return The values.
+		cc0::slice<value_t> values( void );
+
+		/// @brief Provides a view of the values of all entries. The i:th value belongs to the i:th key.
+		/// @return The values.
+		cc0::slice<const value_t> values( void ) const;
+
+		/// @brief Gets the allocator used to allocate the columns.
+		/// @return The allocator.
+		cc0::allocator *get_allocator( void ) const;
+
+		/// @brief Gets the number of slots in the index.
+		/// @return The number of slots.
+		uint64_t capacity( void ) const;
+
+		/// @brief Gets the number of entries in the map.
+		/// @return The number of entries.
+		uint64_t size( void ) const;
+	};
+
+	/// @brief A hash set with open addressing. Keys are stored contiguously in an array column, in insertion order unless keys are erased, and are indexed by a table of control bytes that is probed 16 slots at a time. Lookups and inserts allocate no memory per key.
+	/// @tparam key_t The type of the keys. Must be default-constructible and comparable for equality.
+	/// @tparam hash_t The type of the hash function.
+	template < typename key_t, typename hash_t = std::hash<key_t> >
+	class flat_set
+	{
+	private:
+		cc0::internal::flat_table<key_t,hash_t> m_table;
+
+	public:
+		/// @brief Creates an empty set.
+		/// @param allocator The allocator to allocate columns with. Null selects the default allocator.
+		explicit flat_set(cc0::allocator *allocator = nullptr);
+
+		/// @brief Checks if a key is in the set.
+		/// @param key The key.
+		/// @return True if the key is in the set.
+		bool contains(const key_t &key) const;
+
+		/// @brief Checks if each of a batch of keys is in the set, prefetching the index for several keys at a time so that cache misses overlap.
+		/// @tparam key2_t The type of the keys, i.e. key_t or const key_t.
+		/// @param keys The keys.
+		/// @param found Receives true for each key in the set, and false otherwise. Must be no smaller than the keys.
+		template < typename key2_t >
+		void contains_many(cc0::slice<key2_t> keys, cc0::slice<bool> found) const;
+
+		/// @brief Inserts a key if it is not already in the set.
+		/// @param key The key.
+		/// @return True if the key was inserted, and false if it was already in the set.
+		bool insert(const key_t &key);
+
+		/// @brief Erases a key, moving the last key into its position.
+		/// @param key The key.
+		/// @return True if the key was erased, and false if it was not in the set.
+		bool erase(const key_t &key);
+
+		/// @brief Ensures that a given number of keys can be inserted without rebuilding the index.
+		/// @param count The number of keys.
+		void reserve(uint64_t count);
+
+		/// @brief Removes all keys, keeping memory for reuse.
+		void clear( void );
+
+		/// @brief Removes all keys, and frees allocated memory.
+		void destroy( void );
+
+		/// @brief Provides a view of the keys in the set.
+		/// @return The keys.
+		cc0::slice<const key_t> keys( void ) const;
+
+		/// @brief Gets the allocator used to allocate the columns.
+		/// @return The allocator.
+		cc0::allocator *get_allocator( void ) const;
+
+		/// @brief Gets the number of slots in the index.
+		/// @return The number of slots.
+		uint64_t capacity( void ) const;
+
+		/// @brief Gets the number of keys in the set.
+		/// @return The number of keys.
+		uint64_t size( void ) const;
+	};
+}
+
+inline void cc0::internal::prefetch(const void *mem)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	__builtin_prefetch(mem);
+#elif defined(__SSE2__)
+	_mm_prefetch(static_cast<const char*>(mem), _MM_HINT_T0);
+#else
+	(void)mem;
+#endif
+}
+
+inline uint64_t cc0::internal::lowest_bit(uint32_t bits)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return uint64_t(__builtin_ctz(bits));
+#else
+	uint64_t i = 0;
+	while ((bits & 1) == 0) {
+		bits >>= 1;
+		++i;
+	}
+	return i;
+#endif
+}
+
+inline uint32_t cc0::internal::match_byte(const int8_t *ctrl, int8_t value)
+{
+#if defined(__SSE2__)
+	return uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl)), _mm_set1_epi8(value))));
+#else
+	uint32_t bits = 0;
+	for (uint32_t i = 0; i < 16; ++i) {
+		bits |= uint32_t(ctrl[i] == value) << i;
+	}
+	return bits;
+#endif
+}
+
+inline uint32_t cc0::internal::match_free(const int8_t *ctrl)
+{
+	// Empty and erased slots are the only negative control bytes.
+#if defined(__SSE2__)
+	return uint32_t(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl))));
+#else
+	uint32_t bits = 0;
+	for (uint32_t i = 0; i < 16; ++i) {
+		bits |= uint32_t(ctrl[i] < 0) << i;
+	}
+	return bits;
+#endif
+}
+
+inline uint64_t cc0::internal::mix_hash(uint64_t hash)
+{
+	hash ^= hash >> 33;
+	hash *= 0xFF51AFD7ED558CCDULL;
+	hash ^= hash >> 33;
+	return hash;
+}
+
+template < typename key_t, typename hash_t >
+void cc0::internal::flat_table<key_t,hash_t>::set_ctrl(uint64_t slot, int8_t value)
+{
+	m_ctrl[slot] = value;
+	if (slot < group_size) {
+		m_ctrl[m_slots.size() + slot] = value;
+	}
+}
+
+template < typename key_t, typename hash_t >
+uint64_t cc0::internal::flat_table<key_t,hash_t>::find_free(uint64_t hash) const
+{
+	const uint64_t mask = m_slots.size() - 1;
+	uint64_t pos = (hash >> 7) & mask;
+	for (uint64_t step = group_size;; step += group_size) {
+		const uint32_t free = cc0::internal::match_free(&m_ctrl[pos]);
+		if (free != 0) {
+			return (pos + cc0::internal::lowest_bit(free)) & mask;
+		}
+		pos = (pos + step) & mask;
+	}
+}
+
+template < typename key_t, typename hash_t >
+uint64_t cc0::internal::flat_table<key_t,hash_t>::find_slot(const key_t &key, uint64_t hash) const
+{
+	if (m_slots.size() == 0) {
+		return npos;
+	}
+	const uint64_t mask = m_slots.size() - 1;
+	const int8_t h2 = int8_t(hash & 0x7F);
+	uint64_t pos = (hash >> 7) & mask;
+	// Groups are probed at triangular offsets, which visit every group once the number of slots is a power of two.
+	for (uint64_t step = group_size;; step += group_size) {
+		const int8_t *group = &m_ctrl[pos];
+		for (uint32_t match = cc0::internal::match_byte(group, h2); match != 0; match &= match - 1) {
+			const uint64_t slot = (pos + cc0::internal::lowest_bit(match)) & mask;
+			if (m_keys[m_slots[slot]] == key) {
+				return slot;
+			}
+		}
+		if (cc0::internal::match_byte(group, ctrl_empty) != 0) {
+			return npos;
+		}
+		pos = (pos + step) & mask;
+	}
+}
+
+template < typename key_t, typename hash_t >
+void cc0::internal::flat_table<key_t,hash_t>::rehash(uint64_t capacity)
+{
+	m_ctrl.create(capacity + group_size);
+	m_slots.create(capacity);
+	cc0::fill<int8_t>(m_ctrl, int8_t(ctrl_empty));
+	m_erased = 0;
+	for (uint64_t i = 0; i < m_keys.size(); ++i) {
+		const uint64_t hash = cc0::internal::mix_hash(uint64_t(m_hash(m_keys[i])));
+		const uint64_t slot = find_free(hash);
+		set_ctrl(slot, int8_t(hash & 0x7F));
+		m_slots[slot] = i;
+	}
+}
+
+template < typename key_t, typename hash_t >
+cc0::internal::flat_table<key_t,hash_t>::flat_table(cc0::allocator *allocator) : m_ctrl(allocator), m_slots(allocator), m_keys(allocator), m_erased(0), m_hash()
+{}
+
+template < typename key_t, typename hash_t >
+uint64_t cc0::internal::flat_table<key_t,hash_t>::find(const key_t &key) const
+{
+	const uint64_t slot = find_slot(key, cc0::internal::mix_hash(uint64_t(m_hash(key))));
+	return slot != npos ? m_slots[slot] : npos;
+}
+
+template < typename key_t, typename hash_t >
+template < typename fn_t >
+void cc0::internal::flat_table<key_t,hash_t>::find_many(const key_t *keys, uint64_t count, fn_t fn) const
+{
+	const uint64_t batch = 16;
+	uint64_t hashes[batch];
+	const uint64_t mask = m_slots.size() - 1;
+	for (uint64_t start = 0; start < count; start += batch) {
+		const uint64_t end = count - start < batch ? count : start + batch;
+		if (m_slots.size() > 0) {
+			for (uint64_t i = start; i < end; ++i) {
+				hashes[i - start] = cc0::internal::mix_hash(uint64_t(m_hash(keys[i])));
+				const uint64_t pos = (hashes[i - start] >> 7) & mask;
+				cc0::internal::prefetch(&m_ctrl[pos]);
+				cc0::internal::prefetch(&m_slots[pos]);
+			}
+		}
+		for (uint64_t i = start; i < end; ++i) {
+			const uint64_t slot = m_slots.size() > 0 ? find_slot(keys[i], hashes[i - start]) : npos;
+			fn(i, slot != npos ? m_slots[slot] : npos);
+		}
+	}
+}
+
+template < typename key_t, typename hash_t >
+uint64_t cc0::internal::flat_table<key_t,hash_t>::insert(const key_t &key, bool &inserted)
+{
+	const uint64_t hash = cc0::internal::mix_hash(uint64_t(m_hash(key)));
+	uint64_t slot = find_slot(key, hash);
+	if (slot != npos) {
+		inserted = false;
+		return m_slots[slot];
+	}
+	// Keep at least one slot in eight empty, so that probes are short and always end.
+	if ((m_keys.size() + m_erased + 1) * 8 > m_slots.size() * 7) {
+		const uint64_t capacity = m_slots.size() == 0 ? group_size : ((m_keys.size() + 1) * 16 > m_slots.size() * 7 ? m_slots.size() * 2 : m_slots.size());
+		rehash(capacity);
+	}
+	slot = find_free(hash);
+	if (m_ctrl[slot] == ctrl_erased) {
+		--m_erased;
+	}
+	set_ctrl(slot, int8_t(hash & 0x7F));
+	m_slots[slot] = m_keys.size();
+	m_keys.push_back(key);
+	inserted = true;
+	return m_keys.size() - 1;
+}
+
+template < typename key_t, typename hash_t >
+uint64_t cc0::internal::flat_table<key_t,hash_t>::erase(const key_t &key)
+{
+	const uint64_t slot = find_slot(key, cc0::internal::mix_hash(uint64_t(m_hash(key))));
+	if (slot == npos) {
+		return npos;
+	}
+	const uint64_t at = m_slots[slot];
+	const uint64_t last = m_keys.size() - 1;
+	set_ctrl(slot, ctrl_erased);
+	++m_erased;
+	if (at != last) {
+		// Move the last key into the hole, and point its slot at its new position.
+		const uint64_t moved = find_slot(m_keys[last], cc0::internal::mix_hash(uint64_t(m_hash(m_keys[last]))));
+		m_slots[moved] = at;
+		m_keys[at] = std::move(m_keys[last]);
+	}
+	m_keys.resize(last);
+	return at;
+}
+
+template < typename key_t, typename hash_t >
+void cc0::internal::flat_table<key_t,hash_t>::reserve(uint64_t count)
+{
+	uint64_t capacity = group_size;
+	while (count * 8 > capacity * 7) {
+		capacity *= 2;
+	}
+	if (capacity > m_slots.size()) {
+		m_keys.reserve(count);
+		rehash(capacity);
+	}
+}
+
+template < typename key_t, typename hash_t >
+void cc0::internal::flat_table<key_t,hash_t>::clear( void )
+{
+	m_keys.resize(0);
+	m_erased = 0;
+	if (m_ctrl.size() > 0) {
+		cc0::fill<int8_t>(m_ctrl, int8_t(ctrl_empty));
+	}
+}
+
+template < typename key_t, typename hash_t >
+void cc0::internal::flat_table<key_t,hash_t>::destroy( void )
+{
+	m_ctrl.destroy(false);
+	m_slots.destroy(false);
+	m_keys.destroy(false);
+	m_erased = 0;
+}
+
+template < typename key_t, typename hash_t >
+cc0::slice<const key_t> cc0::internal::flat_table<key_t,hash_t>::keys( void ) const
+{
+	return m_keys(0, m_keys.size());
+}
+
+template < typename key_t, typename hash_t >
+cc0::allocator *cc0::internal::flat_table<key_t,hash_t>::get_allocator( void ) const
+{
+	return m_keys.get_allocator();
+}
+
+template < typename key_t, typename hash_t >
+uint64_t cc0::internal::flat_table<key_t,hash_t>::capacity( void ) const
+{
+	return m_slots.size();
+}
+
+template < typename key_t, typename hash_t >
+uint64_t cc0::internal::flat_table<key_t,hash_t>::size( void ) const
+{
+	return m_keys.size();
+}
+
+template < typename key_t, typename value_t, typename hash_t >
+cc0::flat_map<key_t,value_t,hash_t>::flat_map(cc0::allocator *allocator) : m_table(allocator), m_values(allocator)
+{}
+
+template < typename key_t, typename value_t, typename hash_t >
+value_t *cc0::flat_map<key_t,value_t,hash_t>::find(const key_t &key)
+{
+	const uint64_t at = m_table.find(key);
+	return at != m_table.npos ? &m_values[at] : nullptr;
+}
+
+template < typename key_t, typename value_t, typename hash_t >
+const value_t *cc0::flat_map<key_t,value_t,hash_t>::find(const key_t &key) const
+{
+	const uint64_t at = m_table.find(key);
+	return at != m_table.npos ? &m_values[at] : nullptr;
+}
+
+template < typename key_t, typename value_t, typename hash_t >
+template < typename key2_t >
+void cc0::flat_map<key_t,value_t,hash_t>::find_many(cc0::slice<key2_t> keys, cc0::slice<value_t*> values)
+{
+	CC0_ARR_ASSERT(values.size() >= keys.size());
+	value_t *found = m_values;
+	value_t **out = values;
+	m_table.find_many(static_cast<const key_t*>(keys), keys.size(), [found, out](uint64_t i, uint64_t at) {
+		out[i] = at != cc0::internal::flat_table<key_t,hash_t>::npos ? found + at : nullptr;
+	});
+}
+
+template < typename key_t, typename value_t, typename hash_t >
+template < typename key2_t >
+void cc0::flat_map<key_t,value_t,hash_t>::find_many(cc0::slice<key2_t> keys, cc0::slice<const value_t*> values) const
+{
+	CC0_ARR_ASSERT(values.size() >= keys.size());
+	const value_t *found = m_values;
+	const value_t **out = values;
+	m_table.find_many(static_cast<const key_t*>(keys), keys.size(), [found, out](uint64_t i, uint64_t at) {
+		out[i] = at != cc0::internal::flat_table<key_t,hash_t>::npos ? found + at : nullptr;
+	});
+}
+
+template < typename key_t, typename value_t, typename hash_t >
+bool cc0::flat_map<key_t,value_t,hash_t>::contains(const key_t &key) const
+{
+	return m_table.find(key) != m_table.npos;
+}
+
+template < typename key_t, typename value_t, typename hash_t >
+bool cc0::flat_map<key_t,value_t,hash_t>::insert(const key_t &key, const value_t &value)
+{
+	bool inserted;
+	m_table.insert(key, inserted);
+	if (inserted) {
+		m_values.push_back(value);
+	}
+	return inserted;
+}
+
+template < typename key_t, typename value_t, typename hash_t >
+value_t &cc0::flat_map<key_t,value_t,hash_t>::operator[](const key_t &key)
+{
+	bool inserted;
+	const uint64_t at = m_table.insert(key, inserted);
+	if (inserted) {
+		m_values.emplace_back();
+	}
+	return m_values[at];
+}
+
+template < typename key_t, typename value_t, typename hash_t >
+bool cc0::flat_map<key_t,value_t,hash_t>::erase(const key_t &key)
+{
+	const uint64_t at = m_table.erase(key);
+	if (at == m_table.npos) {
+		return false;
+	}
+	const uint64_t last = m_values.size() - 1;
+	if (at != last) {
+		m_values[at] = std::move(m_values[last]);
+	}
+	m_values.resize(last);
+	return true;
+}
+
+template < typename key_t, typename value_t, typename hash_t >
+void cc0::flat_map<key_t,value_t,hash_t>::reserve(uint64_t count)
+{
+	m_table.reserve(count);
+	m_values.reserve(count);
+}
+
+template < typename key_t, typename value_t, typename hash_t >
+void cc0::flat_map<key_t,value_t,hash_t>::clear( void )
+{
+	m_table.clear();
+	m_values.resize(0);
+}
+
+template < typename key_t, typename value_t, typename hash_t >
+void cc0::flat_map<key_t,value_t,hash_t>::destroy( void )
+{
+	m_table.destroy();
+	m_values.destroy(false);
+}
+
+template < typename key_t, typename value_t, typename hash_t >
+cc0::slice<const key_t> cc0::flat_map<key_t,value_t,hash_t>::keys( void ) const
+{
+	return m_table.keys();
+}
+
+template < typename key_t, typename value_t, typename hash_t >
+cc0::slice<value_t> cc0::flat_map<key_t,value_t,hash_t>::values( void )
+{
+	return m_values(0, m_values.size());
+}
+
+template < typename key_t, typename value_t, typename hash_t >
+cc0::slice<const value_t> cc0::flat_map<key_t,value_t,hash_t>::values( void ) const
+{
+	return m_values(0, m_values.size());
+}
+
+template < typename key_t, typename value_t, typename hash_t >
+cc0::allocator *cc0::flat_map<key_t,value_t,hash_t>::get_allocator( void ) const
+{
+	return m_table.get_allocator();
+}
+
+template < typename key_t, typename value_t, typename hash_t >
+uint64_t cc0::flat_map<key_t,value_t,hash_t>::capacity( void ) const
+{
+	return m_table.capacity();
+}
+
+template < typename key_t, typename value_t, typename hash_t >
+uint64_t cc0::flat_map<key_t,value_t,hash_t>::size( void ) const
+{
+	return m_table.size();
+}
+
+template < typename key_t, typename hash_t >
+cc0::flat_set<key_t,hash_t>::flat_set(cc0::allocator *allocator) : m_table(allocator)
+{}
+
+template < typename key_t, typename hash_t >
+bool cc0::flat_set<key_t,hash_t>::contains(const key_t &key) const
+{
+	return m_table.find(key) != m_table.npos;
+}
+
+template < typename key_t, typename hash_t >
+template < typename key2_t >
+void cc0::flat_set<key_t,hash_t>::contains_many(cc0::slice<key2_t> keys, cc0::slice<bool> found) const
+{
+	CC0_ARR_ASSERT(found.size() >= keys.size());
+	bool *out = found;
+	m_table.find_many(static_cast<const key_t*>(keys), keys.size(), [out](uint64_t i, uint64_t at) {
+		out[i] = at != cc0::internal::flat_table<key_t,hash_t>::npos;
+	});
+}
+
+template < typename key_t, typename hash_t >
+bool cc0::flat_set<key_t,hash_t>::insert(const key_t &key)
+{
+	bool inserted;
+	m_table.insert(key, inserted);
+	return inserted;
+}
+
+template < typename key_t, typename hash_t >
+bool cc0::flat_set<key_t,hash_t>::erase(const key_t &key)
+{
+	return m_table.erase(key) != m_table.npos;
+}
+
+template < typename key_t, typename hash_t >
+void cc0::flat_set<key_t,hash_t>::reserve(uint64_t count)
+{
+	m_table.reserve(count);
+}
+
+template < typename key_t, typename hash_t >
+void cc0::flat_set<key_t,hash_t>::clear( void )
+{
+	m_table.clear();
+}
+
+template < typename key_t, typename hash_t >
+void cc0::flat_set<key_t,hash_t>::destroy( void )
+{
+	m_table.destroy();
+}
+
+template < typename key_t, typename hash_t >
+cc0::slice<const key_t> cc0::flat_set<key_t,hash_t>::keys( void ) const
+{
+	return m_table.keys();
+}
+
+template < typename key_t, typename hash_t >
+cc0::allocator *cc0::flat_set<key_t,hash_t>::get_allocator( void ) const
+{
+	return m_table.get_allocator();
+}
+
+template < typename key_t, typename hash_t >
+uint64_t cc0::flat_set<key_t,hash_t>::capacity( void ) const
+{
+	return m_table.capacity();
+}
+
+template < typename key_t, typename hash_t >
+uint64_t cc0::flat_set<key_t,hash_t>::size( void ) const
+{
+	return m_table.size();
+}
+
+#endif
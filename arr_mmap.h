@@ -0,0 +1,344 @@
+/// @file
+/// @author github.com/SirJonthe
+/// @date 2023
+/// @copyright Public domain.
+/// @license CC0 1.0
+
+#ifndef CC0_ARR_MMAP_H_INCLUDED__
+#define CC0_ARR_MMAP_H_INCLUDED__
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "arr.h"
+
+namespace cc0
+{
+	/// @brief The ways in which a file can be mapped into memory.
+	enum map_mode
+	{
+		map_read_only,    // The mapped memory can only be read.
+		map_copy_on_write // The mapped memory can be written to, but writes are private to the process and never reach the file.
+	};
+
+	/// @brief Hints to the operating system about how mapped memory is going to be accessed.
+	enum map_advice
+	{
+		advise_normal,     // No special treatment.
+		advise_sequential, // Memory will be accessed in sequential order, so pages can be read ahead aggressively and freed soon after access.
+		advise_random,     // Memory will be accessed in random order, so reading ahead is wasteful.
+		advise_will_need,  // Memory will be accessed soon, so pages should be read in ahead of time.
+		advise_dont_need   // Memory will not be accessed soon, so pages may be freed. Discards writes to memory mapped copy-on-write, which reads back the contents of the file on next access.
+	};
+
+	/// @brief An array whose elements are the contents of a memory-mapped file, allowing files to be viewed as slices without copying them into memory first. The array owns the mapping, and unmaps the file when destroyed. The number of elements is the size of the file divided by the size of the element type; trailing bytes that do not make up a full element are not accessible.
+	/// @note Requires a POSIX system.
+	/// @warning Writing to memory mapped in read-only mode results in a memory access violation.
+	/// @tparam type_t The type of the array. Should be trivially copyable.
+	template < typename type_t >
+	class mapped_array
+	{
+	private:
+		type_t   *m_values;
+		uint64_t  m_size;
+		uint64_t  m_bytes;
+
+	public:
+		/// @brief Default constructor. Sets the array memory to null, and size to 0.
+		mapped_array( void );
+
+		/// @brief Maps a file into memory.
+		/// @param path The path of the file to map.
+		/// @param mode The way to map the file.
+		explicit mapped_array(const char *path, cc0::map_mode mode = cc0::map_read_only);
+
+		/// @brief Moves a mapping from one array to another.
+		/// @param arr The other array.
+		mapped_array(mapped_array &&arr);
+
+		mapped_array(const mapped_array&) = delete;
+		mapped_array &operator=(const mapped_array&) = delete;
+
+		/// @brief Unmaps the file.
+		~mapped_array( void );
+
+		/// @brief Moves a mapping from one array to another.
+		/// @param arr The other array.
+		/// @return A reference to the object being assigned.
+		mapped_array &operator=(mapped_array &&arr);
+
+		/// @brief Maps a file into memory, unmapping any previously mapped file.
+		/// @param path The path of the file to map.
+		/// @param mode The way to map the file.
+		/// @return True if the file could be opened and mapped. An empty file results in an empty array.
+		bool open(const char *path, cc0::map_mode mode = cc0::map_read_only);
+
+		/// @brief Unmaps the file and sets the array size to 0.
+		void close( void );
+
+		/// @brief Hints to the operating system how the entire array is going to be accessed.
+		/// @warning advise_dont_need discards all writes to memory mapped copy-on-write.
+		/// @param advice The hint.
+		/// @return True if the hint was accepted.
+		bool advise(cc0::map_advice advice);
+
+		/// @brief Hints to the operating system how part of the array is going to be accessed.
+		/// @warning advise_dont_need discards writes to the part of memory mapped copy-on-write, and to any other elements sharing its pages.
+		/// @param advice The hint.
+		/// @param start The start index of the part (inclusive).
+		/// @param end The end index of the part (non-inclusive). Must not exceed the size of the array, and is clamped to it.
+		/// @return True if the hint was accepted.
+		bool advise(cc0::map_advice advice, uint64_t start, uint64_t end);
+
+		/// @brief Determines if a file is mapped.
+		/// @return True if a non-empty file is mapped.
+		bool is_open( void ) const;
+
+		/// @brief Allows direct access to the value array.
+		/// @return The pointer to the array data.
+		operator type_t*( void );
+
+		/// @brief Allows direct access to the value array.
+		/// @return The pointer to the array data.
+		operator const type_t*( void ) const;
+
+#if defined(CC0_ARR_CHECKED)
+		/// @brief Accesses an element, asserting that the index is within bounds. Only declared in checked mode; otherwise indexing decays to the pointer to the array data.
+		/// @tparam index_t The type of the index.
+		/// @param i The index of the element.
+		/// @return A reference to the element.
+		template < typename index_t >
+		type_t &operator[](index_t i);
+
+		/// @brief Accesses an element, asserting that the index is within bounds. Only declared in checked mode; otherwise indexing decays to the pointer to the array data.
+		/// @tparam index_t The type of the index.
+		/// @param i The index of the element.
+		/// @return A reference to the element.
+		template < typename index_t >
+		const type_t &operator[](index_t i) const;
+#endif
+
+		/// @brief Converts the array into a slice covering the full span of the array.
+		/// @tparam type2_t The other type.
+		/// @return The slice.
+		template < typename type2_t >
+		operator cc0::slice<type2_t>( void );
+
+		/// @brief Converts the array into a slice covering the full span of the array.
+		/// @return The slice.
+		operator cc0::slice<type_t>( void );
+
+		/// @brief Converts the array into a read-only slice covering the full span of the array.
+		/// @tparam type2_t The other type.
+		/// @return The slice.
+		template < typename type2_t >
+		operator const cc0::slice<const type2_t>( void ) const;
+
+		/// @brief Converts the array into a read-only slice covering the full span of the array.
+		/// @return The slice.
+		operator const cc0::slice<const type_t>( void ) const;
+
+		/// @brief Provides a view of the array with the given index bounds.
+		/// @param start The start index of the view (inclusive).
+		/// @param end The end index of the view (non-inclusive).
+		/// @return The slice view of the array.
+		cc0::slice<type_t> operator()(uint64_t start, uint64_t end);
+
+		/// @brief Provides a view of the array with the given index bounds.
+		/// @param start The start index of the view (inclusive).
+		/// @param end The end index of the view (non-inclusive).
+		/// @return The slice view of the array.
+		cc0::slice<const type_t> operator()(uint64_t start, uint64_t end) const;
+
+		/// @brief Gets the size of the array.
+		/// @return The number of elements in the array.
+		uint64_t size( void ) const;
+	};
+}
+
+template < typename type_t >
+cc0::mapped_array<type_t>::mapped_array( void ) : m_values(nullptr), m_size(0), m_bytes(0)
+{}
+
+template < typename type_t >
+cc0::mapped_array<type_t>::mapped_array(const char *path, cc0::map_mode mode) : mapped_array()
+{
+	open(path, mode);
+}
+
+template < typename type_t >
+cc0::mapped_array<type_t>::mapped_array(cc0::mapped_array<type_t> &&arr) : m_values(arr.m_values), m_size(arr.m_size), m_bytes(arr.m_bytes)
+{
+	arr.m_values = nullptr;
+	arr.m_size = 0;
+	arr.m_bytes = 0;
+}
+
+template < typename type_t >
+cc0::mapped_array<type_t>::~mapped_array( void )
+{
+	close();
+}
+
+template < typename type_t >
+cc0::mapped_array<type_t> &cc0::mapped_array<type_t>::operator=(cc0::mapped_array<type_t> &&arr)
+{
+	if (this != &arr) {
+		close();
+		m_values     = arr.m_values;
+		m_size       = arr.m_size;
+		m_bytes      = arr.m_bytes;
+		arr.m_values = nullptr;
+		arr.m_size   = 0;
+		arr.m_bytes  = 0;
+	}
+	return *this;
+}
+
+template < typename type_t >
+bool cc0::mapped_array<type_t>::open(const char *path, cc0::map_mode mode)
+{
+	close();
+	const int fd = ::open(path, O_RDONLY);
+	if (fd < 0) {
+		return false;
+	}
+	struct stat info;
+	if (fstat(fd, &info) != 0) {
+		::close(fd);
+		return false;
+	}
+	const uint64_t bytes = uint64_t(info.st_size);
+	if (bytes > 0) {
+		const int prot = mode == cc0::map_copy_on_write ? (PROT_READ | PROT_WRITE) : PROT_READ;
+		void *mem = mmap(nullptr, bytes, prot, MAP_PRIVATE, fd, 0);
+		if (mem == MAP_FAILED) {
+			::close(fd);
+			return false;
+		}
+		m_values = static_cast<type_t*>(mem);
+		m_size = bytes / sizeof(type_t);
+		m_bytes = bytes;
+	}
+	// The mapping keeps its own reference to the file.
+	::close(fd);
+	return true;
+}
+
+template < typename type_t >
+void cc0::mapped_array<type_t>::close( void )
+{
+	if (m_values != nullptr) {
+		munmap(const_cast<typename std::remove_cv<type_t>::type*>(m_values), m_bytes);
+	}
+	m_values = nullptr;
+	m_size = 0;
+	m_bytes = 0;
+}
+
+template < typename type_t >
+bool cc0::mapped_array<type_t>::advise(cc0::map_advice advice)
+{
+	return advise(advice, 0, m_size);
+}
+
+template < typename type_t >
+bool cc0::mapped_array<type_t>::advise(cc0::map_advice advice, uint64_t start, uint64_t end)
+{
+	CC0_ARR_ASSERT(start <= end && end <= m_size);
+	end = end < m_size ? end : m_size;
+	if (m_values == nullptr || start >= end) {
+		return m_values != nullptr;
+	}
+	static const int flags[] = { MADV_NORMAL, MADV_SEQUENTIAL, MADV_RANDOM, MADV_WILLNEED, MADV_DONTNEED };
+	// Advice must start on a page boundary. The mapping itself always does.
+	const uintptr_t page = uintptr_t(sysconf(_SC_PAGESIZE));
+	const uintptr_t first = reinterpret_cast<uintptr_t>(m_values + start) & ~(page - 1);
+	const uintptr_t last = reinterpret_cast<uintptr_t>(m_values + end);
+	return madvise(reinterpret_cast<void*>(first), last - first, flags[advice]) == 0;
+}
+
+template < typename type_t >
+bool cc0::mapped_array<type_t>::is_open( void ) const
+{
+	return m_values != nullptr;
+}
+
+template < typename type_t >
+cc0::mapped_array<type_t>::operator type_t*( void )
+{
+	return m_values;
+}
+
+template < typename type_t >
+cc0::mapped_array<type_t>::operator const type_t*( void ) const
+{
+	return m_values;
+}
+
+#if defined(CC0_ARR_CHECKED)
+template < typename type_t >
+template < typename index_t >
+type_t &cc0::mapped_array<type_t>::operator[](index_t i)
+{
+	CC0_ARR_ASSERT(static_cast<uint64_t>(i) < m_size);
+	return m_values[i];
+}
+
+template < typename type_t >
+template < typename index_t >
+const type_t &cc0::mapped_array<type_t>::operator[](index_t i) const
+{
+	CC0_ARR_ASSERT(static_cast<uint64_t>(i) < m_size);
+	return m_values[i];
+}
+#endif
+
+template < typename type_t >
+template < typename type2_t >
+cc0::mapped_array<type_t>::operator cc0::slice<type2_t>( void )
+{
+	return cc0::slice<type2_t>(m_values, m_size);
+}
+
+template < typename type_t >
+cc0::mapped_array<type_t>::operator cc0::slice<type_t>( void )
+{
+	return cc0::slice<type_t>(m_values, m_size);
+}
+
+template < typename type_t >
+template < typename type2_t >
+cc0::mapped_array<type_t>::operator const cc0::slice<const type2_t>( void ) const
+{
+	return cc0::slice<const type2_t>(m_values, m_size);
+}
+
+template < typename type_t >
+cc0::mapped_array<type_t>::operator const cc0::slice<const type_t>( void ) const
+{
+	return cc0::slice<const type_t>(m_values, m_size);
+}
+
+template < typename type_t >
+cc0::slice<type_t> cc0::mapped_array<type_t>::operator()(uint64_t start, uint64_t end)
+{
+	CC0_ARR_ASSERT(start <= end && end <= m_size);
+	return cc0::slice<type_t>(m_values + start, (end - start));
+}
+
+template < typename type_t >
+cc0::slice<const type_t> cc0::mapped_array<type_t>::operator()(uint64_t start, uint64_t end) const
+{
+	CC0_ARR_ASSERT(start <= end && end <= m_size);
+	return cc0::slice<const type_t>(m_values + start, (end - start));
+}
+
+template < typename type_t >
+uint64_t cc0::mapped_array<type_t>::size( void ) const
+{
+	return m_size;
+}
+
+#endif
@@ -0,0 +1,203 @@
+/// @file
+/// @author github.com/SirJonthe
+/// @date 2023
+/// @copyright Public domain.
+/// @license CC0 1.0
+
+#ifndef CC0_ARR_PAGE_H_INCLUDED__
+#define CC0_ARR_PAGE_H_INCLUDED__
+
+#include <new>
+#include <sys/mman.h>
+#include <unistd.h>
+#if defined(__linux__)
+	#include <sys/syscall.h>
+#endif
+#include "arr.h"
+#include "arr_par.h"
+
+namespace cc0
+{
+	/// @brief The ways in which pages can be placed on the nodes of a NUMA system.
+	enum numa_mode
+	{
+		numa_default,    // Pages are placed by the operating system, usually on the node of the thread that first touches them.
+		numa_preferred,  // Pages are placed on the first node in the node mask if possible, and elsewhere otherwise.
+		numa_bind,       // Pages are only placed on the nodes in the node mask.
+		numa_interleave  // Pages are spread evenly over the nodes in the node mask.
+	};
+
+	/// @brief Controls how a page allocator maps large allocations.
+	struct page_policy
+	{
+		uint64_t        threshold;        // Allocations of at least this many bytes are mapped directly from the operating system. Smaller allocations are forwarded to the upstream allocator.
+		uint64_t        huge_page_size;   // The size, in bytes, of a huge page. Mappings are sized and aligned to multiples of this. Must be a power of two, and must match the default huge page size of the system for explicit huge pages.
+		bool            explicit_huge;    // Requests pages from the reserved huge page pool of the system first, falling back to regular pages if none are available.
+		bool            transparent_huge; // Asks the system to back regular mappings with transparent huge pages.
+		cc0::numa_mode  numa;             // The placement of pages on NUMA nodes.
+		uint64_t        numa_nodes;       // A mask of the NUMA nodes to place pages on, where bit i selects node i. Ignored for the default placement.
+		bool            first_touch;      // Touches every page of new mappings in parallel on an executor, using the same partitioning as the parallel algorithms, so that pages are placed local to the threads that process them.
+		cc0::executor  *executor;         // The executor to touch pages on. Null selects the default executor.
+
+		/// @brief Creates a policy mapping allocations of at least 2 MiB on transparent huge pages, with default placement and no first touch.
+		page_policy( void );
+	};
+
+	/// @brief An allocator that maps large allocations directly from the operating system, allowing them to use huge pages to reduce TLB misses, and to be placed on given NUMA nodes. Small allocations are forwarded to an upstream allocator.
+	/// @note Requires a POSIX system. NUMA placement is only supported on Linux, and is ignored elsewhere or if the system rejects it. Huge pages are a request, and the system may use regular pages instead.
+	class page_allocator : public cc0::allocator
+	{
+	private:
+		cc0::page_policy  m_policy;
+		cc0::allocator   *m_upstream;
+
+	private:
+		/// @brief Computes the number of bytes mapped for an allocation.
+		/// @param size The number of bytes requested.
+		/// @return The number of bytes mapped.
+		uint64_t mapped_size(uint64_t size) const;
+
+		/// @brief Applies the NUMA policy to a mapping.
+		/// @param mem The mapping.
+		/// @param size The size of the mapping in bytes.
+		void place(void *mem, uint64_t size) const;
+
+		/// @brief Touches every page of a mapping in parallel.
+		/// @param mem The mapping.
+		/// @param size The size of the mapping in bytes.
+		/// @param granule The number of bytes that may be placed as a single page, which is never split between threads.
+		void touch(void *mem, uint64_t size, uint64_t granule) const;
+
+	public:
+		/// @brief Creates a page allocator.
+		/// @param policy The policy for mapping large allocations.
+		/// @param upstream The allocator to forward small allocations to. Null selects the default allocator.
+		explicit page_allocator(const cc0::page_policy &policy = cc0::page_policy(), cc0::allocator *upstream = nullptr);
+
+		/// @brief Allocates raw, uninitialized memory. Large allocations are mapped according to the policy, and are zero-filled.
+		/// @param size The number of bytes to allocate.
+		/// @param align The required alignment, in bytes, of the allocated memory.
+		/// @return The allocated memory.
+		void *allocate(uint64_t size, uint64_t align);
+
+		/// @brief Frees memory previously allocated by the allocator.
+		/// @param mem The memory to free.
+		/// @param size The number of bytes originally requested.
+		/// @param align The alignment originally requested.
+		void deallocate(void *mem, uint64_t size, uint64_t align);
+
+		/// @brief Gets the policy of the allocator.
+		/// @return The policy.
+		const cc0::page_policy &get_policy( void ) const;
+	};
+}
+
+inline cc0::page_policy::page_policy( void ) : threshold(2 * 1024 * 1024), huge_page_size(2 * 1024 * 1024), explicit_huge(false), transparent_huge(true), numa(cc0::numa_default), numa_nodes(0), first_touch(false), executor(nullptr)
+{}
+
+inline uint64_t cc0::page_allocator::mapped_size(uint64_t size) const
+{
+	return (size + m_policy.huge_page_size - 1) & ~(m_policy.huge_page_size - 1);
+}
+
+inline void cc0::page_allocator::place(void *mem, uint64_t size) const
+{
+#if defined(__linux__) && defined(SYS_mbind)
+	if (m_policy.numa == cc0::numa_default || m_policy.numa_nodes == 0) {
+		return;
+	}
+	// The values of MPOL_PREFERRED, MPOL_BIND and MPOL_INTERLEAVE, which avoids depending on libnuma headers.
+	const int mode = m_policy.numa == cc0::numa_preferred ? 1 : (m_policy.numa == cc0::numa_bind ? 2 : 3);
+	const uint64_t bits = sizeof(unsigned long) * 8;
+	unsigned long nodes[64 / bits];
+	for (uint64_t i = 0; i < 64 / bits; ++i) {
+		nodes[i] = static_cast<unsigned long>(m_policy.numa_nodes >> (i * bits));
+	}
+	// The kernel reads one bit less than the given maximum node count.
+	::syscall(SYS_mbind, mem, size, mode, nodes, sizeof(nodes) * 8 + 1, 0);
+#else
+	(void)mem;
+	(void)size;
+#endif
+}
+
+inline void cc0::page_allocator::touch(void *mem, uint64_t size, uint64_t granule) const
+{
+	// A huge page is placed as a whole by the first thread to touch it, so tasks never split one. Every regular page is still touched, in case the system did not provide huge pages.
+	const uint64_t page_size = uint64_t(::sysconf(_SC_PAGESIZE));
+	const uint64_t task = cc0::par::chunk_bytes > granule ? cc0::par::chunk_bytes : granule;
+	cc0::executor &exec = m_policy.executor != nullptr ? *m_policy.executor : cc0::default_executor();
+	volatile uint8_t *bytes = static_cast<volatile uint8_t*>(mem);
+	exec.run((size + task - 1) / task, [&](uint64_t i) {
+		const uint64_t end = (i + 1) * task < size ? (i + 1) * task : size;
+		for (uint64_t at = i * task; at < end; at += page_size) {
+			bytes[at] = 0;
+		}
+	});
+}
+
+inline cc0::page_allocator::page_allocator(const cc0::page_policy &policy, cc0::allocator *upstream) : m_policy(policy), m_upstream(upstream != nullptr ? upstream : cc0::default_allocator())
+{}
+
+inline void *cc0::page_allocator::allocate(uint64_t size, uint64_t align)
+{
+	if (size < m_policy.threshold || size == 0) {
+		return m_upstream->allocate(size, align);
+	}
+	const uint64_t length = mapped_size(size);
+	const uint64_t boundary = align > m_policy.huge_page_size ? align : m_policy.huge_page_size;
+	uint64_t granule = uint64_t(::sysconf(_SC_PAGESIZE));
+	void *mem = MAP_FAILED;
+#if defined(MAP_HUGETLB)
+	if (m_policy.explicit_huge && boundary == m_policy.huge_page_size) {
+		// Explicit huge page mappings are aligned to the huge page size by the system.
+		mem = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+		if (mem != MAP_FAILED) {
+			granule = m_policy.huge_page_size;
+		}
+	}
+#endif
+	if (mem == MAP_FAILED) {
+		// Over-map, and unmap the slack on either side to align the mapping, so that transparent huge pages can back all of it.
+		void *raw = ::mmap(nullptr, length + boundary, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (raw == MAP_FAILED) {
+			throw std::bad_alloc();
+		}
+		const uintptr_t start = reinterpret_cast<uintptr_t>(raw);
+		const uintptr_t addr = (start + boundary - 1) & ~uintptr_t(boundary - 1);
+		if (addr > start) {
+			::munmap(raw, addr - start);
+		}
+		if (start + length + boundary > addr + length) {
+			::munmap(reinterpret_cast<void*>(addr + length), start + length + boundary - (addr + length));
+		}
+		mem = reinterpret_cast<void*>(addr);
+#if defined(MADV_HUGEPAGE)
+		if (m_policy.transparent_huge) {
+			::madvise(mem, length, MADV_HUGEPAGE);
+			granule = m_policy.huge_page_size;
+		}
+#endif
+	}
+	place(mem, length);
+	if (m_policy.first_touch) {
+		touch(mem, length, granule);
+	}
+	return mem;
+}
+
+inline void cc0::page_allocator::deallocate(void *mem, uint64_t size, uint64_t align)
+{
+	if (size < m_policy.threshold || size == 0) {
+		m_upstream->deallocate(mem, size, align);
+	} else {
+		::munmap(mem, mapped_size(size));
+	}
+}
+
+inline const cc0::page_policy &cc0::page_allocator::get_policy( void ) const
+{
+	return m_policy;
+}
+
+#endif
@@ -0,0 +1,420 @@
+/// @file
+/// @author github.com/SirJonthe
+/// @date 2023
+/// @copyright Public domain.
+/// @license CC0 1.0
+
+#ifndef CC0_ARR_PAR_H_INCLUDED__
+#define CC0_ARR_PAR_H_INCLUDED__
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include "arr.h"
+
+namespace cc0
+{
+	/// @brief A small work-stealing thread pool. Work is submitted as a number of independent tasks which are distributed evenly over the queues of the worker threads. Workers that run out of tasks steal tasks from the queues of other workers. The thread submitting work participates in processing it.
+	class executor
+	{
+	private:
+		/// @brief A single unit of work.
+		struct task
+		{
+			void                  (*run)(const void *fn, uint64_t index);
+			const void             *fn;
+			uint64_t                index;
+			std::atomic<uint64_t>  *pending;
+		};
+
+		/// @brief The task queue of a single worker.
+		struct queue
+		{
+			std::mutex       lock;
+			std::deque<task> tasks;
+		};
+
+	private:
+		cc0::array<std::thread>  m_threads;
+		cc0::array<queue>        m_queues;
+		std::mutex               m_lock;
+		std::condition_variable  m_work;
+		std::condition_variable  m_done;
+		std::atomic<uint64_t>    m_queued;
+		bool                     m_stop;
+
+	private:
+		/// @brief Calls a function object with a given task index.
+		/// @tparam fn_t The type of the function object.
+		/// @param fn The function object.
+		/// @param index The task index.
+		template < typename fn_t >
+		static void invoke(const void *fn, uint64_t index);
+
+		/// @brief Pops a task from the front of a given queue, or steals a task from the back of any other queue.
+		/// @param first The queue to start looking in.
+		/// @param out The task.
+		/// @return True if a task was found.
+		bool pop(uint64_t first, task &out);
+
+		/// @brief Runs a task and signals waiting threads if it was the last pending task of its batch.
+		/// @param t The task to run.
+		void run(const task &t);
+
+		/// @brief The main loop of a worker thread.
+		/// @param index The index of the worker's queue.
+		void work(uint64_t index);
+
+	public:
+		/// @brief Starts a given number of worker threads.
+		/// @param thread_count The number of worker threads. A thread count of zero means that all work is processed by the submitting thread.
+		explicit executor(uint64_t thread_count);
+
+		/// @brief Starts one worker thread per hardware thread, minus one for the submitting thread.
+		executor( void );
+
+		executor(const executor&) = delete;
+		executor &operator=(const executor&) = delete;
+
+		/// @brief Stops and joins all worker threads.
+		~executor( void );
+
+		/// @brief Calls a function object for every index in the range [0, count) in parallel, and returns when all calls have completed.
+		/// @warning The function object must not throw.
+		/// @tparam fn_t The type of the function object. Must be callable with a uint64_t index.
+		/// @param count The number of tasks.
+		/// @param fn The function object.
+		template < typename fn_t >
+		void run(uint64_t count, const fn_t &fn);
+
+		/// @brief Gets the number of threads that process work, including the submitting thread.
+		/// @return The number of threads.
+		uint64_t thread_count( void ) const;
+	};
+
+	/// @brief Returns an executor shared by the parallel algorithms unless otherwise specified. The executor is created on first use.
+	/// @return The default executor.
+	cc0::executor &default_executor( void );
+
+	/// @brief Parallel versions of bulk operations on slices. Slices are partitioned into cache-sized sub-slices that are processed as independent tasks on an executor.
+	namespace par
+	{
+		/// @brief The approximate number of bytes of elements processed per task.
+		constexpr uint64_t chunk_bytes = 64 * 1024;
+
+		/// @brief Writes a given value to the entirety of the slice in parallel.
+		/// @tparam type_t The type of the slice.
+		/// @param dst The slice to write the value to.
+		/// @param value The value to write to the slice.
+		/// @param exec The executor to run on.
+		template < typename type_t >
+		void fill(cc0::slice<type_t> dst, const type_t &value, cc0::executor &exec = cc0::default_executor());
+
+		/// @brief Writes the result of a function of each element in one slice to the corresponding element of another slice in parallel.
+		/// @tparam type_t The type of the destination slice.
+		/// @tparam type2_t The type of the source slice.
+		/// @tparam fn_t The type of the function. Must be callable with an element of the source slice, and return a value assignable to an element of the destination slice.
+		/// @param dst The slice to write to.
+		/// @param src The slice to read from.
+		/// @param fn The function.
+		/// @param exec The executor to run on.
+		/// @return The number of elements transformed, i.e. the smaller of the sizes of the slices.
+		template < typename type_t, typename type2_t, typename fn_t >
+		uint64_t transform(cc0::slice<type_t> dst, cc0::slice<type2_t> src, const fn_t &fn, cc0::executor &exec = cc0::default_executor());
+
+		/// @brief Combines all elements in a slice with an initial value in parallel.
+		/// @note The function must be associative, as elements are combined in parallel in an unspecified grouping, although always in order.
+		/// @tparam type_t The type of the slice.
+		/// @tparam fn_t The type of the function. Must be callable with two values and return a value of the same type.
+		/// @param src The slice to reduce.
+		/// @param init The initial value.
+		/// @param fn The function.
+		/// @param exec The executor to run on.
+		/// @return The combined value.
+		template < typename type_t, typename fn_t >
+		typename std::remove_cv<type_t>::type reduce(cc0::slice<type_t> src, const typename std::remove_cv<type_t>::type &init, const fn_t &fn, cc0::executor &exec = cc0::default_executor());
+
+		/// @brief Calls a function for each element of a slice in parallel.
+		/// @tparam type_t The type of the slice.
+		/// @tparam fn_t The type of the function. Must be callable with an element of the slice.
+		/// @param arr The slice.
+		/// @param fn The function.
+		/// @param exec The executor to run on.
+		template < typename type_t, typename fn_t >
+		void for_each(cc0::slice<type_t> arr, const fn_t &fn, cc0::executor &exec = cc0::default_executor());
+
+		/// @brief Sorts the elements of a slice in ascending order in parallel. Sub-slices are sorted independently and then merged pairwise.
+		/// @tparam type_t The type of the slice.
+		/// @tparam less_t The type of the comparison function.
+		/// @param arr The slice to sort.
+		/// @param less The comparison function. Returns true if the first argument should be ordered before the second.
+		/// @param exec The executor to run on.
+		template < typename type_t, typename less_t >
+		void sort(cc0::slice<type_t> arr, const less_t &less, cc0::executor &exec = cc0::default_executor());
+
+		/// @brief Sorts the elements of a slice in ascending order in parallel using operator<.
+		/// @tparam type_t The type of the slice.
+		/// @param arr The slice to sort.
+		/// @param exec The executor to run on.
+		template < typename type_t >
+		void sort(cc0::slice<type_t> arr, cc0::executor &exec = cc0::default_executor());
+	}
+}
+
+template < typename fn_t >
+void cc0::executor::invoke(const void *fn, uint64_t index)
+{
+	(*static_cast<const fn_t*>(fn))(index);
+}
+
+inline bool cc0::executor::pop(uint64_t first, task &out)
+{
+	for (uint64_t i = 0; i < m_queues.size(); ++i) {
+		const uint64_t q = (first + i) % m_queues.size();
+		std::lock_guard<std::mutex> guard(m_queues[q].lock);
+		std::deque<task> &tasks = m_queues[q].tasks;
+		if (!tasks.empty()) {
+			if (i == 0) {
+				out = tasks.front();
+				tasks.pop_front();
+			} else {
+				out = tasks.back();
+				tasks.pop_back();
+			}
+			--m_queued;
+			return true;
+		}
+	}
+	return false;
+}
+
+inline void cc0::executor::run(const task &t)
+{
+	t.run(t.fn, t.index);
+	if (t.pending->fetch_sub(1) == 1) {
+		std::lock_guard<std::mutex> guard(m_lock);
+		m_done.notify_all();
+	}
+}
+
+inline void cc0::executor::work(uint64_t index)
+{
+	task t;
+	while (true) {
+		if (pop(index, t)) {
+			run(t);
+			continue;
+		}
+		std::unique_lock<std::mutex> lock(m_lock);
+		m_work.wait(lock, [this]{ return m_stop || m_queued > 0; });
+		if (m_stop && m_queued == 0) {
+			return;
+		}
+	}
+}
+
+inline cc0::executor::executor(uint64_t thread_count) : m_threads(), m_queues(), m_queued(0), m_stop(false)
+{
+	if (thread_count > 0) {
+		m_queues.create(thread_count, false);
+		m_threads.create(thread_count, false);
+		for (uint64_t i = 0; i < thread_count; ++i) {
+			m_threads[i] = std::thread(&cc0::executor::work, this, i);
+		}
+	}
+}
+
+inline cc0::executor::executor( void ) : executor(std::thread::hardware_concurrency() > 1 ? std::thread::hardware_concurrency() - 1 : 0)
+{}
+
+inline cc0::executor::~executor( void )
+{
+	{
+		std::lock_guard<std::mutex> guard(m_lock);
+		m_stop = true;
+	}
+	m_work.notify_all();
+	for (uint64_t i = 0; i < m_threads.size(); ++i) {
+		m_threads[i].join();
+	}
+}
+
+template < typename fn_t >
+void cc0::executor::run(uint64_t count, const fn_t &fn)
+{
+	if (m_queues.size() == 0 || count <= 1) {
+		for (uint64_t i = 0; i < count; ++i) {
+			fn(i);
+		}
+		return;
+	}
+
+	// Give each worker a contiguous block of task indices to keep neighboring tasks on the same thread.
+	std::atomic<uint64_t> pending(count);
+	const uint64_t workers = m_queues.size();
+	for (uint64_t w = 0; w < workers; ++w) {
+		const uint64_t start = count * w / workers;
+		const uint64_t end = count * (w + 1) / workers;
+		if (start < end) {
+			std::lock_guard<std::mutex> guard(m_queues[w].lock);
+			m_queued += end - start;
+			for (uint64_t i = start; i < end; ++i) {
+				const task t = { &cc0::executor::invoke<fn_t>, &fn, i, &pending };
+				m_queues[w].tasks.push_back(t);
+			}
+		}
+	}
+	{
+		std::lock_guard<std::mutex> guard(m_lock);
+	}
+	m_work.notify_all();
+
+	// Help out until there is nothing left to steal, then wait for the remaining tasks to complete.
+	task t;
+	while (pending > 0 && pop(0, t)) {
+		run(t);
+	}
+	std::unique_lock<std::mutex> lock(m_lock);
+	m_done.wait(lock, [&pending]{ return pending == 0; });
+}
+
+inline uint64_t cc0::executor::thread_count( void ) const
+{
+	return m_threads.size() + 1;
+}
+
+inline cc0::executor &cc0::default_executor( void )
+{
+	static cc0::executor exec;
+	return exec;
+}
+
+namespace cc0
+{
+	namespace internal
+	{
+		/// @brief Computes the number of elements processed per task.
+		/// @tparam type_t The type of the elements.
+		/// @return The number of elements.
+		template < typename type_t >
+		uint64_t chunk_size( void )
+		{
+			return sizeof(type_t) < cc0::par::chunk_bytes ? cc0::par::chunk_bytes / sizeof(type_t) : 1;
+		}
+
+		/// @brief Computes the number of tasks needed to process a given number of elements.
+		/// @tparam type_t The type of the elements.
+		/// @param size The number of elements.
+		/// @return The number of tasks.
+		template < typename type_t >
+		uint64_t chunk_count(uint64_t size)
+		{
+			return (size + cc0::internal::chunk_size<type_t>() - 1) / cc0::internal::chunk_size<type_t>();
+		}
+
+		/// @brief Computes the first index of a task.
+		/// @tparam type_t The type of the elements.
+		/// @param chunk The index of the task.
+		/// @param size The total number of elements.
+		/// @return The first index.
+		template < typename type_t >
+		uint64_t chunk_start(uint64_t chunk, uint64_t size)
+		{
+			const uint64_t start = chunk * cc0::internal::chunk_size<type_t>();
+			return start < size ? start : size;
+		}
+	}
+}
+
+template < typename type_t >
+void cc0::par::fill(cc0::slice<type_t> dst, const type_t &value, cc0::executor &exec)
+{
+	const uint64_t size = dst.size();
+	exec.run(cc0::internal::chunk_count<type_t>(size), [&](uint64_t chunk) {
+		cc0::fill(dst(cc0::internal::chunk_start<type_t>(chunk, size), cc0::internal::chunk_start<type_t>(chunk + 1, size)), value);
+	});
+}
+
+template < typename type_t, typename type2_t, typename fn_t >
+uint64_t cc0::par::transform(cc0::slice<type_t> dst, cc0::slice<type2_t> src, const fn_t &fn, cc0::executor &exec)
+{
+	const uint64_t size = dst.size() < src.size() ? dst.size() : src.size();
+	exec.run(cc0::internal::chunk_count<type_t>(size), [&](uint64_t chunk) {
+		const uint64_t end = cc0::internal::chunk_start<type_t>(chunk + 1, size);
+		for (uint64_t i = cc0::internal::chunk_start<type_t>(chunk, size); i < end; ++i) {
+			dst[i] = fn(src[i]);
+		}
+	});
+	return size;
+}
+
+template < typename type_t, typename fn_t >
+typename std::remove_cv<type_t>::type cc0::par::reduce(cc0::slice<type_t> src, const typename std::remove_cv<type_t>::type &init, const fn_t &fn, cc0::executor &exec)
+{
+	typedef typename std::remove_cv<type_t>::type value_t;
+	const uint64_t size = src.size();
+	const uint64_t chunks = cc0::internal::chunk_count<type_t>(size);
+	cc0::array<value_t> partials;
+	partials.reserve(chunks);
+	for (uint64_t i = 0; i < chunks; ++i) {
+		partials.push_back(src[cc0::internal::chunk_start<type_t>(i, size)]);
+	}
+	exec.run(chunks, [&](uint64_t chunk) {
+		const uint64_t end = cc0::internal::chunk_start<type_t>(chunk + 1, size);
+		value_t acc = partials[chunk];
+		for (uint64_t i = cc0::internal::chunk_start<type_t>(chunk, size) + 1; i < end; ++i) {
+			acc = fn(acc, src[i]);
+		}
+		partials[chunk] = acc;
+	});
+	value_t acc = init;
+	for (uint64_t i = 0; i < chunks; ++i) {
+		acc = fn(acc, partials[i]);
+	}
+	return acc;
+}
+
+template < typename type_t, typename fn_t >
+void cc0::par::for_each(cc0::slice<type_t> arr, const fn_t &fn, cc0::executor &exec)
+{
+	const uint64_t size = arr.size();
+	exec.run(cc0::internal::chunk_count<type_t>(size), [&](uint64_t chunk) {
+		const uint64_t end = cc0::internal::chunk_start<type_t>(chunk + 1, size);
+		for (uint64_t i = cc0::internal::chunk_start<type_t>(chunk, size); i < end; ++i) {
+			fn(arr[i]);
+		}
+	});
+}
+
+template < typename type_t, typename less_t >
+void cc0::par::sort(cc0::slice<type_t> arr, const less_t &less, cc0::executor &exec)
+{
+	type_t *values = arr;
+	const uint64_t size = arr.size();
+
+	// Use a power-of-two number of runs, at least as many as there are threads, so that runs merge pairwise.
+	uint64_t runs = 1;
+	while (runs < exec.thread_count() && runs * cc0::internal::chunk_size<type_t>() < size) {
+		runs *= 2;
+	}
+	exec.run(runs, [&](uint64_t run) {
+		std::sort(values + size * run / runs, values + size * (run + 1) / runs, less);
+	});
+	for (uint64_t width = 1; width < runs; width *= 2) {
+		exec.run(runs / (width * 2), [&](uint64_t pair) {
+			const uint64_t first = pair * width * 2;
+			std::inplace_merge(values + size * first / runs, values + size * (first + width) / runs, values + size * (first + width * 2) / runs, less);
+		});
+	}
+}
+
+template < typename type_t >
+void cc0::par::sort(cc0::slice<type_t> arr, cc0::executor &exec)
+{
+	cc0::par::sort(arr, [](const type_t &a, const type_t &b) { return a < b; }, exec);
+}
+
+#endif
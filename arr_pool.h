@@ -0,0 +1,279 @@
+/// @file
+/// @author github.com/SirJonthe
+/// @date 2023
+/// @copyright Public domain.
+/// @license CC0 1.0
+
+#ifndef CC0_ARR_POOL_H_INCLUDED__
+#define CC0_ARR_POOL_H_INCLUDED__
+
+#include <atomic>
+#include <mutex>
+#include "arr.h"
+
+namespace cc0
+{
+	class pool_allocator;
+
+	/// @brief Returns the process-wide pool allocator. The pool is created on first use and is never destroyed, so that arrays with static storage duration can safely return memory to it.
+	/// @return The pool allocator.
+	cc0::pool_allocator *global_pool( void );
+
+	/// @brief A process-wide allocator that recycles memory in power-of-two size classes. Freed blocks are cached per thread, and overflow into a shared depot that all threads draw from, so that memory is recycled between array objects instead of being returned to the heap. Use it by passing global_pool() to arrays, or opt in for all arrays with set_default_allocator(global_pool()).
+	/// @note Blocks are aligned to alignof(std::max_align_t), which the heap provides without overhead. Requests larger than the largest size class, or with stricter alignments, bypass the pool.
+	class pool_allocator : public cc0::allocator
+	{
+		friend cc0::pool_allocator *cc0::global_pool( void );
+
+	public:
+		/// @brief The number of bytes in the smallest size class, as a power of two.
+		static constexpr uint64_t min_class_log2 = 4;
+
+		/// @brief The number of bytes in the largest size class, as a power of two.
+		static constexpr uint64_t max_class_log2 = 24;
+
+		/// @brief The number of size classes.
+		static constexpr uint64_t class_count = max_class_log2 - min_class_log2 + 1;
+
+		/// @brief The maximum number of bytes per size class held in the cache of a single thread.
+		static constexpr uint64_t thread_cache_bytes = 256 * 1024;
+
+		/// @brief Usage statistics used for tuning.
+		struct statistics
+		{
+			uint64_t hits;       // The number of allocations served from cached blocks.
+			uint64_t misses;     // The number of allocations served from the heap.
+			uint64_t bytes_held; // The number of bytes currently cached by the pool.
+			uint64_t high_water; // The largest number of bytes cached by the pool at any one time.
+		};
+
+	private:
+		/// @brief A free block of memory, linked to the next free block of the same size class.
+		struct block
+		{
+			block *next;
+		};
+
+		/// @brief A per-thread cache of free blocks. Trivially destructible so that it remains usable while objects with static storage duration are destroyed.
+		struct cache
+		{
+			block    *free[class_count];
+			uint64_t  count[class_count];
+			bool      closed;
+		};
+
+		/// @brief Flushes the blocks of the cache of the calling thread to the depot when the thread exits, and closes the cache so that further blocks go directly to the depot.
+		struct flusher
+		{
+			~flusher( void );
+		};
+
+	private:
+		std::mutex            m_lock;
+		block                *m_depot[class_count];
+		std::atomic<uint64_t> m_hits;
+		std::atomic<uint64_t> m_misses;
+		std::atomic<uint64_t> m_held;
+		std::atomic<uint64_t> m_high_water;
+
+	private:
+		/// @brief Creates an empty pool.
+		pool_allocator( void );
+
+		/// @brief Returns the block cache of the calling thread.
+		/// @return The cache.
+		static cache &local( void );
+
+		/// @brief Determines the size class of an allocation.
+		/// @param size The number of bytes.
+		/// @param align The alignment.
+		/// @return The index of the size class, or class_count if the allocation bypasses the pool.
+		static uint64_t size_class(uint64_t size, uint64_t align);
+
+		/// @brief Gets the number of bytes in a size class.
+		/// @param c The index of the size class.
+		/// @return The number of bytes.
+		static uint64_t class_bytes(uint64_t c);
+
+		/// @brief Gets the alignment of blocks in a size class. Kept at the alignment the heap provides for free, since stricter alignments make the heap over-allocate every block.
+		/// @param c The index of the size class.
+		/// @return The alignment, in bytes.
+		static uint64_t class_align(uint64_t c);
+
+		/// @brief Accounts for blocks entering the pool.
+		/// @param bytes The number of bytes.
+		void hold(uint64_t bytes);
+
+	public:
+		pool_allocator(const pool_allocator&) = delete;
+		pool_allocator &operator=(const pool_allocator&) = delete;
+
+		/// @brief Allocates raw, uninitialized memory, reusing a cached block of the same size class if one is available.
+		/// @param size The number of bytes to allocate.
+		/// @param align The required alignment, in bytes, of the allocated memory.
+		/// @return The allocated memory.
+		void *allocate(uint64_t size, uint64_t align);
+
+		/// @brief Returns memory to the pool.
+		/// @param mem The memory to free.
+		/// @param size The number of bytes originally requested.
+		/// @param align The alignment originally requested.
+		void deallocate(void *mem, uint64_t size, uint64_t align);
+
+		/// @brief Frees all blocks cached in the shared depot and in the cache of the calling thread back to the heap.
+		void trim( void );
+
+		/// @brief Gets usage statistics for the pool.
+		/// @return The statistics.
+		statistics get_statistics( void ) const;
+	};
+}
+
+inline cc0::pool_allocator *cc0::global_pool( void )
+{
+	static cc0::pool_allocator *p = new cc0::pool_allocator;
+	return p;
+}
+
+inline cc0::pool_allocator::flusher::~flusher( void )
+{
+	cc0::pool_allocator *pool = cc0::global_pool();
+	cache &local_cache = local();
+	std::lock_guard<std::mutex> guard(pool->m_lock);
+	for (uint64_t c = 0; c < class_count; ++c) {
+		while (local_cache.free[c] != nullptr) {
+			block *b = local_cache.free[c];
+			local_cache.free[c] = b->next;
+			b->next = pool->m_depot[c];
+			pool->m_depot[c] = b;
+		}
+		local_cache.count[c] = 0;
+	}
+	local_cache.closed = true;
+}
+
+inline cc0::pool_allocator::pool_allocator( void ) : m_hits(0), m_misses(0), m_held(0), m_high_water(0)
+{
+	for (uint64_t c = 0; c < class_count; ++c) {
+		m_depot[c] = nullptr;
+	}
+}
+
+inline cc0::pool_allocator::cache &cc0::pool_allocator::local( void )
+{
+	static thread_local cache c; // Zero-initialized.
+	static thread_local flusher f;
+	(void)f;
+	return c;
+}
+
+inline uint64_t cc0::pool_allocator::size_class(uint64_t size, uint64_t align)
+{
+	// Over-aligned requests go to the heap, which handles them itself.
+	if (align > alignof(std::max_align_t)) {
+		return class_count;
+	}
+	uint64_t c = 0;
+	while (c < class_count && class_bytes(c) < size) {
+		++c;
+	}
+	return c;
+}
+
+inline uint64_t cc0::pool_allocator::class_bytes(uint64_t c)
+{
+	return uint64_t(1) << (c + min_class_log2);
+}
+
+inline uint64_t cc0::pool_allocator::class_align(uint64_t)
+{
+	return alignof(std::max_align_t);
+}
+
+inline void cc0::pool_allocator::hold(uint64_t bytes)
+{
+	const uint64_t held = m_held.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+	uint64_t high = m_high_water.load(std::memory_order_relaxed);
+	while (held > high && !m_high_water.compare_exchange_weak(high, held, std::memory_order_relaxed)) {}
+}
+
+inline void *cc0::pool_allocator::allocate(uint64_t size, uint64_t align)
+{
+	const uint64_t c = size_class(size, align);
+	if (c == class_count) {
+		m_misses.fetch_add(1, std::memory_order_relaxed);
+		return cc0::internal::heap()->allocate(size, align);
+	}
+	cache &local_cache = local();
+	block *b = local_cache.free[c];
+	if (b != nullptr) {
+		local_cache.free[c] = b->next;
+		--local_cache.count[c];
+	} else {
+		std::lock_guard<std::mutex> guard(m_lock);
+		b = m_depot[c];
+		if (b != nullptr) {
+			m_depot[c] = b->next;
+		}
+	}
+	if (b == nullptr) {
+		m_misses.fetch_add(1, std::memory_order_relaxed);
+		return cc0::internal::heap()->allocate(class_bytes(c), class_align(c));
+	}
+	m_hits.fetch_add(1, std::memory_order_relaxed);
+	m_held.fetch_sub(class_bytes(c), std::memory_order_relaxed);
+	return b;
+}
+
+inline void cc0::pool_allocator::deallocate(void *mem, uint64_t size, uint64_t align)
+{
+	const uint64_t c = size_class(size, align);
+	if (c == class_count) {
+		cc0::internal::heap()->deallocate(mem, size, align);
+		return;
+	}
+	block *b = static_cast<block*>(mem);
+	cache &local_cache = local();
+	if (!local_cache.closed && local_cache.count[c] * class_bytes(c) < thread_cache_bytes) {
+		b->next = local_cache.free[c];
+		local_cache.free[c] = b;
+		++local_cache.count[c];
+	} else {
+		std::lock_guard<std::mutex> guard(m_lock);
+		b->next = m_depot[c];
+		m_depot[c] = b;
+	}
+	hold(class_bytes(c));
+}
+
+inline void cc0::pool_allocator::trim( void )
+{
+	cache &local_cache = local();
+	std::lock_guard<std::mutex> guard(m_lock);
+	for (uint64_t c = 0; c < class_count; ++c) {
+		block *lists[2] = { local_cache.free[c], m_depot[c] };
+		local_cache.free[c] = nullptr;
+		local_cache.count[c] = 0;
+		m_depot[c] = nullptr;
+		for (uint64_t i = 0; i < 2; ++i) {
+			while (lists[i] != nullptr) {
+				block *b = lists[i];
+				lists[i] = b->next;
+				cc0::internal::heap()->deallocate(b, class_bytes(c), class_align(c));
+				m_held.fetch_sub(class_bytes(c), std::memory_order_relaxed);
+			}
+		}
+	}
+}
+
+inline cc0::pool_allocator::statistics cc0::pool_allocator::get_statistics( void ) const
+{
+	statistics stats;
+	stats.hits       = m_hits.load(std::memory_order_relaxed);
+	stats.misses     = m_misses.load(std::memory_order_relaxed);
+	stats.bytes_held = m_held.load(std::memory_order_relaxed);
+	stats.high_water = m_high_water.load(std::memory_order_relaxed);
+	return stats;
+}
+
+#endif
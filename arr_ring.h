@@ -0,0 +1,470 @@
+/// @file
+/// @author github.com/SirJonthe
+/// @date 2023
+/// @copyright Public domain.
+/// @license CC0 1.0
+
+#ifndef CC0_ARR_RING_H_INCLUDED__
+#define CC0_ARR_RING_H_INCLUDED__
+
+#include <atomic>
+#include "arr.h"
+
+namespace cc0
+{
+	namespace internal
+	{
+		/// @brief Rounds a number up to the nearest power of two.
+		/// @param n The number.
+		/// @return The smallest power of two no less than the number, or 1 if the number is 0.
+		uint64_t ceil_pow2(uint64_t n);
+	}
+
+	/// @brief A lock-free ring buffer for passing elements from exactly one producer thread to exactly one consumer thread. Pushing and popping are wait-free. Elements may also be transferred in bulk, without copying, by writing to or reading from the free or occupied regions of the ring directly.
+	/// @note The capacity is always a power of two.
+	/// @tparam type_t The type of the elements. Must be default constructible.
+	/// @tparam size_u The fixed capacity of the ring, which must be a power of two. A value of 0 allocates storage of a capacity given at runtime.
+	template < typename type_t, uint64_t size_u = 0 >
+	class ring
+	{
+		static_assert((size_u & (size_u - 1)) == 0, "size_u must be zero or a power of two");
+
+	private:
+		cc0::array<type_t,size_u> m_values;
+		uint64_t                  m_mask;
+		// The producer and consumer indices live on separate cache lines to avoid false sharing. Each side keeps a cached copy of the index of the other side, which single-element operations only reload when the ring appears full or empty.
+		char                      m_pad0[cc0::cache_line_align];
+		std::atomic<uint64_t>     m_tail;
+		uint64_t                  m_head_cache;
+		char                      m_pad1[cc0::cache_line_align - sizeof(std::atomic<uint64_t>) - sizeof(uint64_t)];
+		std::atomic<uint64_t>     m_head;
+		uint64_t                  m_tail_cache;
+		char                      m_pad2[cc0::cache_line_align - sizeof(std::atomic<uint64_t>) - sizeof(uint64_t)];
+
+	private:
+		/// @brief Gets the number of free slots from the point of view of the producer.
+		/// @param tail The index of the producer.
+		/// @return The number of free slots.
+		uint64_t writable(uint64_t tail);
+
+		/// @brief Gets the number of occupied slots from the point of view of the consumer.
+		/// @param head The index of the consumer.
+		/// @return The number of occupied slots.
+		uint64_t readable(uint64_t head);
+
+	public:
+		/// @brief Creates an empty ring. A ring of variable capacity has no storage until created.
+		ring( void );
+
+		/// @brief Creates an empty ring of variable capacity.
+		/// @param capacity The minimum number of elements the ring can hold. Rounded up to a power of two.
+		explicit ring(uint64_t capacity);
+
+		ring(const ring&) = delete;
+		ring &operator=(const ring&) = delete;
+
+		/// @brief Allocates new storage for a ring of variable capacity. Any elements in the ring are lost.
+		/// @warning Not thread safe. No other thread may access the ring at the same time.
+		/// @param capacity The minimum number of elements the ring can hold. Rounded up to a power of two.
+		void create(uint64_t capacity);
+
+		/// @brief Pushes an element. Only to be called from the producer thread.
+		/// @param value The element.
+		/// @return False if the ring is full.
+		bool try_push(const type_t &value);
+
+		/// @brief Pushes an element. Only to be called from the producer thread.
+		/// @param value The element.
+		/// @return False if the ring is full, in which case the value is not moved from.
+		bool try_push(type_t &&value);
+
+		/// @brief Pops an element. Only to be called from the consumer thread.
+		/// @param value The variable to move the element to.
+		/// @return False if the ring is empty.
+		bool try_pop(type_t &value);
+
+		/// @brief Pushes as many elements as fit in the ring. Only to be called from the producer thread.
+		/// @param values The elements.
+		/// @return The number of elements pushed.
+		uint64_t push(cc0::slice<const type_t> values);
+
+		/// @brief Pops as many elements as are available in the ring. Only to be called from the consumer thread.
+		/// @param values The slice to move the elements to.
+		/// @return The number of elements popped.
+		uint64_t pop(cc0::slice<type_t> values);
+
+		/// @brief Provides views of the free region of the ring, for writing elements in place. The region may wrap around the end of the storage, in which case it is split in two. Only to be called from the producer thread.
+		/// @param first Receives the first part of the free region.
+		/// @param second Receives the second part of the free region, which is empty unless the region wraps around.
+		/// @return The total number of free slots.
+		uint64_t begin_write(cc0::slice<type_t> &first, cc0::slice<type_t> &second);
+
+		/// @brief Publishes elements written in place to the consumer. Only to be called from the producer thread.
+		/// @param count The number of elements written, starting from the first free slot. Must not exceed the number of free slots.
+		void end_write(uint64_t count);
+
+		/// @brief Provides views of the occupied region of the ring, for reading elements in place. The region may wrap around the end of the storage, in which case it is split in two. Only to be called from the consumer thread.
+		/// @param first Receives the first part of the occupied region.
+		/// @param second Receives the second part of the occupied region, which is empty unless the region wraps around.
+		/// @return The total number of occupied slots.
+		uint64_t begin_read(cc0::slice<type_t> &first, cc0::slice<type_t> &second);
+
+		/// @brief Releases elements read in place back to the producer. Only to be called from the consumer thread.
+		/// @param count The number of elements read, starting from the first occupied slot. Must not exceed the number of occupied slots.
+		void end_read(uint64_t count);
+
+		/// @brief Gets the number of elements in the ring. Only exact if neither side is accessing the ring at the same time.
+		/// @return The number of elements in the ring.
+		uint64_t size( void ) const;
+
+		/// @brief Gets the capacity of the ring.
+		/// @return The number of elements the ring can hold.
+		uint64_t capacity( void ) const;
+	};
+
+	/// @brief A lock-free bounded ring buffer for passing elements between any number of producer and consumer threads. Each slot carries a sequence number that tells producers and consumers whose turn it is to access the slot, so that threads only contend on the shared indices.
+	/// @note The capacity is always a power of two, and at least 2, since with a single slot the sequence numbers of a full slot and an empty slot are the same.
+	/// @tparam type_t The type of the elements. Must be default constructible.
+	/// @tparam size_u The fixed capacity of the ring, which must be a power of two no less than 2. A value of 0 allocates storage of a capacity given at runtime.
+	template < typename type_t, uint64_t size_u = 0 >
+	class mpmc_ring
+	{
+		static_assert((size_u & (size_u - 1)) == 0, "size_u must be zero or a power of two");
+		static_assert(size_u == 0 || size_u >= 2, "size_u must be zero or at least 2");
+
+	private:
+		/// @brief A slot in the ring.
+		struct cell
+		{
+			std::atomic<uint64_t> sequence;
+			type_t                value;
+		};
+
+	private:
+		cc0::array<cell,size_u> m_cells;
+		uint64_t                m_mask;
+		char                    m_pad0[cc0::cache_line_align];
+		std::atomic<uint64_t>   m_tail;
+		char                    m_pad1[cc0::cache_line_align - sizeof(std::atomic<uint64_t>)];
+		std::atomic<uint64_t>   m_head;
+		char                    m_pad2[cc0::cache_line_align - sizeof(std::atomic<uint64_t>)];
+
+	private:
+		/// @brief Resets the sequence numbers and indices of the ring.
+		void reset( void );
+
+		/// @brief Claims a slot for writing.
+		/// @param pos Receives the position of the claimed slot.
+		/// @return The claimed slot, or null if the ring is full.
+		cell *claim_write(uint64_t &pos);
+
+	public:
+		/// @brief Creates an empty ring. A ring of variable capacity has no storage until created.
+		mpmc_ring( void );
+
+		/// @brief Creates an empty ring of variable capacity.
+		/// @param capacity The minimum number of elements the ring can hold. Rounded up to a power of two no less than 2.
+		explicit mpmc_ring(uint64_t capacity);
+
+		mpmc_ring(const mpmc_ring&) = delete;
+		mpmc_ring &operator=(const mpmc_ring&) = delete;
+
+		/// @brief Allocates new storage for a ring of variable capacity. Any elements in the ring are lost.
+		/// @warning Not thread safe. No other thread may access the ring at the same time.
+		/// @param capacity The minimum number of elements the ring can hold. Rounded up to a power of two no less than 2.
+		void create(uint64_t capacity);
+
+		/// @brief Pushes an element.
+		/// @param value The element.
+		/// @return False if the ring is full.
+		bool try_push(const type_t &value);
+
+		/// @brief Pushes an element.
+		/// @param value The element.
+		/// @return False if the ring is full, in which case the value is not moved from.
+		bool try_push(type_t &&value);
+
+		/// @brief Pops an element.
+		/// @param value The variable to move the element to.
+		/// @return False if the ring is empty.
+		bool try_pop(type_t &value);
+
+		/// @brief Gets the capacity of the ring.
+		/// @return The number of elements the ring can hold.
+		uint64_t capacity( void ) const;
+	};
+}
+
+inline uint64_t cc0::internal::ceil_pow2(uint64_t n)
+{
+	uint64_t p = 1;
+	while (p < n) {
+		p <<= 1;
+	}
+	return p;
+}
+
+template < typename type_t, uint64_t size_u >
+uint64_t cc0::ring<type_t,size_u>::writable(uint64_t tail)
+{
+	const uint64_t cap = m_mask + 1;
+	if (tail - m_head_cache == cap) {
+		m_head_cache = m_head.load(std::memory_order_acquire);
+	}
+	return cap - (tail - m_head_cache);
+}
+
+template < typename type_t, uint64_t size_u >
+uint64_t cc0::ring<type_t,size_u>::readable(uint64_t head)
+{
+	if (m_tail_cache == head) {
+		m_tail_cache = m_tail.load(std::memory_order_acquire);
+	}
+	return m_tail_cache - head;
+}
+
+template < typename type_t, uint64_t size_u >
+cc0::ring<type_t,size_u>::ring( void ) : m_values(), m_mask(size_u - 1), m_tail(0), m_head_cache(0), m_head(0), m_tail_cache(0)
+{}
+
+template < typename type_t, uint64_t size_u >
+cc0::ring<type_t,size_u>::ring(uint64_t capacity) : ring()
+{
+	create(capacity);
+}
+
+template < typename type_t, uint64_t size_u >
+void cc0::ring<type_t,size_u>::create(uint64_t capacity)
+{
+	static_assert(size_u == 0, "Only rings of variable capacity can be created");
+	m_values.create(cc0::internal::ceil_pow2(capacity));
+	m_mask = m_values.size() - 1;
+	m_tail.store(0, std::memory_order_relaxed);
+	m_head.store(0, std::memory_order_relaxed);
+	m_head_cache = 0;
+	m_tail_cache = 0;
+}
+
+template < typename type_t, uint64_t size_u >
+bool cc0::ring<type_t,size_u>::try_push(const type_t &value)
+{
+	const uint64_t tail = m_tail.load(std::memory_order_relaxed);
+	if (writable(tail) == 0) {
+		return false;
+	}
+	m_values[tail & m_mask] = value;
+	m_tail.store(tail + 1, std::memory_order_release);
+	return true;
+}
+
+template < typename type_t, uint64_t size_u >
+bool cc0::ring<type_t,size_u>::try_push(type_t &&value)
+{
+	const uint64_t tail = m_tail.load(std::memory_order_relaxed);
+	if (writable(tail) == 0) {
+		return false;
+	}
+	m_values[tail & m_mask] = std::move(value);
+	m_tail.store(tail + 1, std::memory_order_release);
+	return true;
+}
+
+template < typename type_t, uint64_t size_u >
+bool cc0::ring<type_t,size_u>::try_pop(type_t &value)
+{
+	const uint64_t head = m_head.load(std::memory_order_relaxed);
+	if (readable(head) == 0) {
+		return false;
+	}
+	value = std::move(m_values[head & m_mask]);
+	m_head.store(head + 1, std::memory_order_release);
+	return true;
+}
+
+template < typename type_t, uint64_t size_u >
+uint64_t cc0::ring<type_t,size_u>::push(cc0::slice<const type_t> values)
+{
+	cc0::slice<type_t> first, second;
+	begin_write(first, second);
+	uint64_t count = cc0::copy(first, values);
+	count += cc0::copy(second, values(count, values.size()));
+	end_write(count);
+	return count;
+}
+
+template < typename type_t, uint64_t size_u >
+uint64_t cc0::ring<type_t,size_u>::pop(cc0::slice<type_t> values)
+{
+	cc0::slice<type_t> first, second;
+	begin_read(first, second);
+	uint64_t count = cc0::move(values, first);
+	count += cc0::move(values(count, values.size()), second);
+	end_read(count);
+	return count;
+}
+
+template < typename type_t, uint64_t size_u >
+uint64_t cc0::ring<type_t,size_u>::begin_write(cc0::slice<type_t> &first, cc0::slice<type_t> &second)
+{
+	const uint64_t tail = m_tail.load(std::memory_order_relaxed);
+	// Slots may have been released since the cache was last refreshed.
+	m_head_cache = m_head.load(std::memory_order_acquire);
+	const uint64_t count = writable(tail);
+	const uint64_t start = tail & m_mask;
+	const uint64_t first_count = count < m_mask + 1 - start ? count : m_mask + 1 - start;
+	first = m_values(start, start + first_count);
+	second = m_values(0, count - first_count);
+	return count;
+}
+
+template < typename type_t, uint64_t size_u >
+void cc0::ring<type_t,size_u>::end_write(uint64_t count)
+{
+	m_tail.store(m_tail.load(std::memory_order_relaxed) + count, std::memory_order_release);
+}
+
+template < typename type_t, uint64_t size_u >
+uint64_t cc0::ring<type_t,size_u>::begin_read(cc0::slice<type_t> &first, cc0::slice<type_t> &second)
+{
+	const uint64_t head = m_head.load(std::memory_order_relaxed);
+	// Elements may have been published since the cache was last refreshed.
+	m_tail_cache = m_tail.load(std::memory_order_acquire);
+	const uint64_t count = readable(head);
+	const uint64_t start = head & m_mask;
+	const uint64_t first_count = count < m_mask + 1 - start ? count : m_mask + 1 - start;
+	first = m_values(start, start + first_count);
+	second = m_values(0, count - first_count);
+	return count;
+}
+
+template < typename type_t, uint64_t size_u >
+void cc0::ring<type_t,size_u>::end_read(uint64_t count)
+{
+	m_head.store(m_head.load(std::memory_order_relaxed) + count, std::memory_order_release);
+}
+
+template < typename type_t, uint64_t size_u >
+uint64_t cc0::ring<type_t,size_u>::size( void ) const
+{
+	const uint64_t head = m_head.load(std::memory_order_acquire);
+	const uint64_t tail = m_tail.load(std::memory_order_acquire);
+	return tail > head ? tail - head : 0;
+}
+
+template < typename type_t, uint64_t size_u >
+uint64_t cc0::ring<type_t,size_u>::capacity( void ) const
+{
+	return m_values.size();
+}
+
+template < typename type_t, uint64_t size_u >
+void cc0::mpmc_ring<type_t,size_u>::reset( void )
+{
+	for (uint64_t i = 0; i < m_cells.size(); ++i) {
+		m_cells[i].sequence.store(i, std::memory_order_relaxed);
+	}
+	m_tail.store(0, std::memory_order_relaxed);
+	m_head.store(0, std::memory_order_relaxed);
+}
+
+template < typename type_t, uint64_t size_u >
+typename cc0::mpmc_ring<type_t,size_u>::cell *cc0::mpmc_ring<type_t,size_u>::claim_write(uint64_t &pos)
+{
+	if (m_cells.size() == 0) {
+		return nullptr;
+	}
+	pos = m_tail.load(std::memory_order_relaxed);
+	for (;;) {
+		cell &c = m_cells[pos & m_mask];
+		const int64_t diff = int64_t(c.sequence.load(std::memory_order_acquire)) - int64_t(pos);
+		if (diff == 0) {
+			if (m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+				return &c;
+			}
+		} else if (diff < 0) {
+			return nullptr;
+		} else {
+			pos = m_tail.load(std::memory_order_relaxed);
+		}
+	}
+}
+
+template < typename type_t, uint64_t size_u >
+cc0::mpmc_ring<type_t,size_u>::mpmc_ring( void ) : m_cells(), m_mask(size_u - 1), m_tail(0), m_head(0)
+{
+	reset();
+}
+
+template < typename type_t, uint64_t size_u >
+cc0::mpmc_ring<type_t,size_u>::mpmc_ring(uint64_t capacity) : mpmc_ring()
+{
+	create(capacity);
+}
+
+template < typename type_t, uint64_t size_u >
+void cc0::mpmc_ring<type_t,size_u>::create(uint64_t capacity)
+{
+	static_assert(size_u == 0, "Only rings of variable capacity can be created");
+	m_cells.create(cc0::internal::ceil_pow2(capacity < 2 ? 2 : capacity));
+	m_mask = m_cells.size() - 1;
+	reset();
+}
+
+template < typename type_t, uint64_t size_u >
+bool cc0::mpmc_ring<type_t,size_u>::try_push(const type_t &value)
+{
+	uint64_t pos;
+	cell *c = claim_write(pos);
+	if (c == nullptr) {
+		return false;
+	}
+	c->value = value;
+	c->sequence.store(pos + 1, std::memory_order_release);
+	return true;
+}
+
+template < typename type_t, uint64_t size_u >
+bool cc0::mpmc_ring<type_t,size_u>::try_push(type_t &&value)
+{
+	uint64_t pos;
+	cell *c = claim_write(pos);
+	if (c == nullptr) {
+		return false;
+	}
+	c->value = std::move(value);
+	c->sequence.store(pos + 1, std::memory_order_release);
+	return true;
+}
+
+template < typename type_t, uint64_t size_u >
+bool cc0::mpmc_ring<type_t,size_u>::try_pop(type_t &value)
+{
+	if (m_cells.size() == 0) {
+		return false;
+	}
+	uint64_t pos = m_head.load(std::memory_order_relaxed);
+	for (;;) {
+		cell &c = m_cells[pos & m_mask];
+		const int64_t diff = int64_t(c.sequence.load(std::memory_order_acquire)) - int64_t(pos + 1);
+		if (diff == 0) {
+			if (m_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+				value = std::move(c.value);
+				// The slot becomes writable again one lap later.
+				c.sequence.store(pos + m_mask + 1, std::memory_order_release);
+				return true;
+			}
+		} else if (diff < 0) {
+			return false;
+		} else {
+			pos = m_head.load(std::memory_order_relaxed);
+		}
+	}
+}
+
+template < typename type_t, uint64_t size_u >
+uint64_t cc0::mpmc_ring<type_t,size_u>::capacity( void ) const
+{
+	return m_cells.size();
+}
+
+#endif
@@ -0,0 +1,492 @@
+/// @file
+/// @author github.com/SirJonthe
+/// @date 2023
+/// @copyright Public domain.
+/// @license CC0 1.0
+
+#ifndef CC0_ARR_SERIAL_H_INCLUDED__
+#define CC0_ARR_SERIAL_H_INCLUDED__
+
+#include <cstring>
+#include "arr.h"
+
+namespace cc0
+{
+	/// @brief The element types recorded in serialized arrays.
+	enum serial_type
+	{
+		serial_opaque,  // A trivially copyable type without a portable representation. Only the element size is checked when loading, and the bytes can not be converted between byte orders.
+		serial_bool,    // bool.
+		serial_int8,    // 8-bit signed integer.
+		serial_uint8,   // 8-bit unsigned integer.
+		serial_int16,   // 16-bit signed integer.
+		serial_uint16,  // 16-bit unsigned integer.
+		serial_int32,   // 32-bit signed integer.
+		serial_uint32,  // 32-bit unsigned integer.
+		serial_int64,   // 64-bit signed integer.
+		serial_uint64,  // 64-bit unsigned integer.
+		serial_float32, // 32-bit floating-point number.
+		serial_float64, // 64-bit floating-point number.
+		serial_nested   // An array of serialized arrays.
+	};
+
+	/// @brief The version of the serialization format written by this library.
+	constexpr uint16_t serial_version = 1;
+
+	namespace internal
+	{
+		/// @brief Determines the serialized element type of a type.
+		/// @tparam type_t The type.
+		template < typename type_t, bool integral_b = std::is_integral<type_t>::value, bool floating_b = std::is_floating_point<type_t>::value >
+		struct serial_tag : std::integral_constant<uint8_t, cc0::serial_opaque> {};
+
+		template < typename type_t >
+		struct serial_tag<type_t, true, false> : std::integral_constant<uint8_t,
+			std::is_same<type_t, bool>::value ? cc0::serial_bool :
+			sizeof(type_t) == 1 ? (std::is_signed<type_t>::value ? cc0::serial_int8  : cc0::serial_uint8) :
+			sizeof(type_t) == 2 ? (std::is_signed<type_t>::value ? cc0::serial_int16 : cc0::serial_uint16) :
+			sizeof(type_t) == 4 ? (std::is_signed<type_t>::value ? cc0::serial_int32 : cc0::serial_uint32) :
+			sizeof(type_t) == 8 ? (std::is_signed<type_t>::value ? cc0::serial_int64 : cc0::serial_uint64) :
+			cc0::serial_opaque> {};
+
+		template < typename type_t >
+		struct serial_tag<type_t, false, true> : std::integral_constant<uint8_t, sizeof(type_t) == 4 ? cc0::serial_float32 : (sizeof(type_t) == 8 ? cc0::serial_float64 : cc0::serial_opaque)> {};
+
+		/// @brief Determines if a type is serialized as a nested array rather than as plain bytes, and if so, the type of its elements.
+		/// @tparam type_t The type.
+		template < typename type_t >
+		struct is_serial_record : std::false_type {};
+
+		template < typename type_t, uint64_t size_u, uint64_t align_u >
+		struct is_serial_record< cc0::array<type_t,size_u,align_u> > : std::true_type { typedef type_t element_type; };
+
+		template < typename type_t >
+		struct is_serial_record< cc0::slice<type_t> > : std::true_type { typedef typename std::remove_cv<type_t>::type element_type; };
+
+		/// @brief The decoded header of a serialized array. Every record starts at an 8-byte boundary with a 32-byte header: a 4-byte magic, then the version (16 bits), element type (8 bits), byte order (8 bits), element size (32 bits), payload alignment (32 bits), element count (64 bits), and total record size in bytes (64 bits), all in the byte order of the writer. Elements follow at the first multiple of the payload alignment after the header, counted from the start of the buffer. Nested arrays have an element size of 0 and are followed by one record per element.
+		struct serial_header
+		{
+			uint16_t version;      // The format version.
+			uint8_t  type;         // The element type.
+			uint8_t  order;        // The byte order of the writer.
+			uint32_t element_size; // The size of an element in bytes.
+			uint32_t align;        // The alignment of the payload in bytes.
+			uint64_t count;        // The number of elements.
+			uint64_t size;         // The size of the record, including the header, in bytes.
+		};
+
+		/// @brief The size of a serialized header in bytes.
+		constexpr uint64_t serial_header_size = 32;
+
+		/// @brief The alignment of serialized headers in bytes.
+		constexpr uint64_t serial_header_align = 8;
+
+		/// @brief Gets the byte order of the system.
+		/// @return 1 for little endian, 2 for big endian.
+		uint8_t serial_native_order( void );
+
+		/// @brief Rounds an offset up to the next multiple of an alignment.
+		/// @param at The offset.
+		/// @param align The alignment. Must be a power of two.
+		/// @return The aligned offset.
+		uint64_t serial_align_up(uint64_t at, uint64_t align);
+
+		/// @brief Reverses the byte order of a sequence of elements in place.
+		/// @param mem The elements.
+		/// @param element_size The size of an element in bytes.
+		/// @param count The number of elements.
+		void swap_bytes(void *mem, uint64_t element_size, uint64_t count);
+
+		/// @brief Writes a header.
+		/// @param dst The memory to write to. Must hold serial_header_size bytes.
+		/// @param header The header.
+		void write_serial_header(uint8_t *dst, const cc0::internal::serial_header &header);
+
+		/// @brief Reads and validates a header, converting it to the byte order of the system.
+		/// @param src The buffer.
+		/// @param src_size The size of the buffer in bytes.
+		/// @param at The offset of the record. Must be aligned to serial_header_align.
+		/// @param header The decoded header.
+		/// @return True if the header is valid and the record fits in the buffer.
+		bool read_serial_header(const uint8_t *src, uint64_t src_size, uint64_t at, cc0::internal::serial_header &header);
+
+		/// @brief Gets the offset of the elements of a leaf record.
+		/// @param at The offset of the record.
+		/// @param header The header of the record.
+		/// @return The offset of the elements.
+		uint64_t serial_payload(uint64_t at, const cc0::internal::serial_header &header);
+
+		/// @brief Computes the end offset of a record of trivially copyable elements, or of nested arrays.
+		/// @tparam type_t The type of the elements.
+		/// @param values The elements.
+		/// @param count The number of elements.
+		/// @param at The offset the record is written at.
+		/// @return The offset of the end of the record.
+		template < typename type_t >
+		uint64_t serial_size(const type_t *values, uint64_t count, uint64_t at, std::false_type);
+
+		template < typename type_t >
+		uint64_t serial_size(const type_t *values, uint64_t count, uint64_t at, std::true_type);
+
+		/// @brief Writes a record of trivially copyable elements, or of nested arrays.
+		/// @tparam type_t The type of the elements.
+		/// @param dst The buffer.
+		/// @param dst_size The size of the buffer in bytes.
+		/// @param values The elements.
+		/// @param count The number of elements.
+		/// @param at The offset to write the record at.
+		/// @return The offset of the end of the record, or 0 if the buffer is too small.
+		template < typename type_t >
+		uint64_t serial_write(uint8_t *dst, uint64_t dst_size, const type_t *values, uint64_t count, uint64_t at, std::false_type);
+
+		template < typename type_t >
+		uint64_t serial_write(uint8_t *dst, uint64_t dst_size, const type_t *values, uint64_t count, uint64_t at, std::true_type);
+
+		/// @brief Copies the elements of a record into constructed memory, converting byte order if needed, or loads the nested records into each element.
+		/// @tparam type_t The type of the elements.
+		/// @param src The buffer.
+		/// @param src_size The size of the buffer in bytes.
+		/// @param at The offset of the record.
+		/// @param header The header of the record.
+		/// @param dst The memory to load into. Must hold header.count elements.
+		/// @return False if the record does not match the type.
+		template < typename type_t >
+		bool serial_read_elements(const uint8_t *src, uint64_t src_size, uint64_t at, const cc0::internal::serial_header &header, type_t *dst, std::false_type);
+
+		template < typename type_t >
+		bool serial_read_elements(const uint8_t *src, uint64_t src_size, uint64_t at, const cc0::internal::serial_header &header, type_t *dst, std::true_type);
+
+		/// @brief Loads a record into an array, or views it in place as a slice.
+		/// @param src The buffer.
+		/// @param src_size The size of the buffer in bytes.
+		/// @param at The offset of the record.
+		/// @param dst The array or slice to load into.
+		/// @return The offset of the end of the record, or 0 if the record could not be loaded.
+		template < typename type_t, uint64_t align_u >
+		uint64_t serial_read(const uint8_t *src, uint64_t src_size, uint64_t at, cc0::array<type_t,0,align_u> &dst);
+
+		template < typename type_t, uint64_t size_u, uint64_t align_u >
+		uint64_t serial_read(const uint8_t *src, uint64_t src_size, uint64_t at, cc0::array<type_t,size_u,align_u> &dst);
+
+		template < typename type_t >
+		uint64_t serial_read(const uint8_t *src, uint64_t src_size, uint64_t at, cc0::slice<const type_t> &dst);
+	}
+
+	/// @brief Computes the number of bytes needed to serialize elements at the start of a buffer.
+	/// @tparam type_t The type of the elements. Either trivially copyable, or an array or slice of serializable elements, which is stored as a nested array.
+	/// @param src The elements.
+	/// @return The number of bytes.
+	template < typename type_t >
+	uint64_t serialized_size(cc0::slice<const type_t> src);
+
+	/// @brief Serializes elements into a buffer. The record starts at the first 8-byte boundary at or after the given offset, and its elements are padded to their natural alignment from the start of the buffer, so that they can later be loaded in place if the buffer is suitably aligned.
+	/// @tparam type_t The type of the elements. Either trivially copyable, or an array or slice of serializable elements, which is stored as a nested array.
+	/// @param dst The buffer to write to.
+	/// @param src The elements.
+	/// @param at The offset in the buffer to write at.
+	/// @return The offset of the end of the record, or 0 if the buffer is too small.
+	template < typename type_t >
+	uint64_t serialize(cc0::slice<uint8_t> dst, cc0::slice<const type_t> src, uint64_t at = 0);
+
+	/// @brief Serializes elements to the end of an array of bytes, growing the array as needed.
+	/// @tparam type_t The type of the elements. Either trivially copyable, or an array or slice of serializable elements, which is stored as a nested array.
+	/// @tparam align_u The alignment of the byte array.
+	/// @param dst The array to append to.
+	/// @param src The elements.
+	/// @return The offset of the end of the record, which is the new size of the array.
+	template < typename type_t, uint64_t align_u >
+	uint64_t serialize(cc0::array<uint8_t,0,align_u> &dst, cc0::slice<const type_t> src);
+
+	/// @brief Loads serialized elements. Loading into a read-only slice does not copy, and instead points the slice straight into the buffer, which requires the record to have been written in the byte order of the system with elements at an address aligned for the type; note that an array of slices loads a nested array without copying. Loading into an array copies the elements, and converts them from the byte order of the writer if needed.
+	/// @warning Slices loaded from a buffer are only valid as long as the buffer is.
+	/// @tparam type_t The type to load into; an array, or a read-only slice.
+	/// @param src The buffer holding the record.
+	/// @param dst The array or slice to load into.
+	/// @param at The offset of the record in the buffer. Rounded up to the next 8-byte boundary.
+	/// @return The offset of the end of the record, or 0 if the record is malformed, does not fit in the buffer, does not match the type being loaded into, or can not be loaded without copying when loading into a slice.
+	template < typename type_t >
+	uint64_t deserialize(cc0::slice<const uint8_t> src, type_t &dst, uint64_t at = 0);
+}
+
+inline uint8_t cc0::internal::serial_native_order( void )
+{
+	const uint16_t probe = 1;
+	uint8_t first;
+	memcpy(&first, &probe, 1);
+	return first == 1 ? 1 : 2;
+}
+
+inline uint64_t cc0::internal::serial_align_up(uint64_t at, uint64_t align)
+{
+	return (at + align - 1) & ~(align - 1);
+}
+
+inline void cc0::internal::swap_bytes(void *mem, uint64_t element_size, uint64_t count)
+{
+	uint8_t *bytes = static_cast<uint8_t*>(mem);
+	for (uint64_t i = 0; i < count; ++i, bytes += element_size) {
+		for (uint64_t lo = 0, hi = element_size - 1; lo < hi; ++lo, --hi) {
+			const uint8_t t = bytes[lo];
+			bytes[lo] = bytes[hi];
+			bytes[hi] = t;
+		}
+	}
+}
+
+inline void cc0::internal::write_serial_header(uint8_t *dst, const cc0::internal::serial_header &header)
+{
+	dst[0] = 'c';
+	dst[1] = 'c';
+	dst[2] = '0';
+	dst[3] = 'a';
+	memcpy(dst + 4, &header.version, 2);
+	dst[6] = header.type;
+	dst[7] = header.order;
+	memcpy(dst + 8, &header.element_size, 4);
+	memcpy(dst + 12, &header.align, 4);
+	memcpy(dst + 16, &header.count, 8);
+	memcpy(dst + 24, &header.size, 8);
+}
+
+inline bool cc0::internal::read_serial_header(const uint8_t *src, uint64_t src_size, uint64_t at, cc0::internal::serial_header &header)
+{
+	if (at > src_size || src_size - at < cc0::internal::serial_header_size) {
+		return false;
+	}
+	src += at;
+	if (src[0] != 'c' || src[1] != 'c' || src[2] != '0' || src[3] != 'a') {
+		return false;
+	}
+	memcpy(&header.version, src + 4, 2);
+	header.type = src[6];
+	header.order = src[7];
+	memcpy(&header.element_size, src + 8, 4);
+	memcpy(&header.align, src + 12, 4);
+	memcpy(&header.count, src + 16, 8);
+	memcpy(&header.size, src + 24, 8);
+	if (header.order != 1 && header.order != 2) {
+		return false;
+	}
+	if (header.order != cc0::internal::serial_native_order()) {
+		cc0::internal::swap_bytes(&header.version, 2, 1);
+		cc0::internal::swap_bytes(&header.element_size, 4, 1);
+		cc0::internal::swap_bytes(&header.align, 4, 1);
+		cc0::internal::swap_bytes(&header.count, 8, 1);
+		cc0::internal::swap_bytes(&header.size, 8, 1);
+	}
+	if (header.version == 0 || header.version > cc0::serial_version || header.align == 0 || (header.align & (header.align - 1)) != 0) {
+		return false;
+	}
+	if (header.size < cc0::internal::serial_header_size || header.size > src_size - at) {
+		return false;
+	}
+	if (header.type != cc0::serial_nested) {
+		const uint64_t payload = cc0::internal::serial_payload(at, header) - at;
+		if (header.element_size == 0 || payload > header.size || header.count > (header.size - payload) / header.element_size) {
+			return false;
+		}
+	}
+	return true;
+}
+
+inline uint64_t cc0::internal::serial_payload(uint64_t at, const cc0::internal::serial_header &header)
+{
+	return cc0::internal::serial_align_up(at + cc0::internal::serial_header_size, header.align);
+}
+
+template < typename type_t >
+uint64_t cc0::internal::serial_size(const type_t*, uint64_t count, uint64_t at, std::false_type)
+{
+	static_assert(std::is_trivially_copyable<type_t>::value, "Serialized elements must be trivially copyable");
+	at = cc0::internal::serial_align_up(at, cc0::internal::serial_header_align);
+	return cc0::internal::serial_align_up(at + cc0::internal::serial_header_size, alignof(type_t)) + count * sizeof(type_t);
+}
+
+template < typename type_t >
+uint64_t cc0::internal::serial_size(const type_t *values, uint64_t count, uint64_t at, std::true_type)
+{
+	typedef typename cc0::internal::is_serial_record<type_t>::element_type element_t;
+	at = cc0::internal::serial_align_up(at, cc0::internal::serial_header_align) + cc0::internal::serial_header_size;
+	for (uint64_t i = 0; i < count; ++i) {
+		at = cc0::internal::serial_size(static_cast<const element_t*>(values[i]), values[i].size(), at, cc0::internal::is_serial_record<element_t>());
+	}
+	return at;
+}
+
+template < typename type_t >
+uint64_t cc0::internal::serial_write(uint8_t *dst, uint64_t dst_size, const type_t *values, uint64_t count, uint64_t at, std::false_type)
+{
+	const uint64_t start = cc0::internal::serial_align_up(at, cc0::internal::serial_header_align);
+	const uint64_t end = cc0::internal::serial_size(values, count, at, std::false_type());
+	if (end > dst_size) {
+		return 0;
+	}
+	cc0::internal::serial_header header;
+	header.version      = cc0::serial_version;
+	header.type         = cc0::internal::serial_tag<typename std::remove_cv<type_t>::type>::value;
+	header.order        = cc0::internal::serial_native_order();
+	header.element_size = uint32_t(sizeof(type_t));
+	header.align        = uint32_t(alignof(type_t));
+	header.count        = count;
+	header.size         = end - start;
+	const uint64_t payload = cc0::internal::serial_payload(start, header);
+	memset(dst + at, 0, start - at);
+	cc0::internal::write_serial_header(dst + start, header);
+	memset(dst + start + cc0::internal::serial_header_size, 0, payload - start - cc0::internal::serial_header_size);
+	if (count > 0) {
+		memcpy(dst + payload, values, count * sizeof(type_t));
+	}
+	return end;
+}
+
+template < typename type_t >
+uint64_t cc0::internal::serial_write(uint8_t *dst, uint64_t dst_size, const type_t *values, uint64_t count, uint64_t at, std::true_type)
+{
+	typedef typename cc0::internal::is_serial_record<type_t>::element_type element_t;
+	const uint64_t start = cc0::internal::serial_align_up(at, cc0::internal::serial_header_align);
+	if (start + cc0::internal::serial_header_size > dst_size) {
+		return 0;
+	}
+	uint64_t end = start + cc0::internal::serial_header_size;
+	for (uint64_t i = 0; i < count; ++i) {
+		end = cc0::internal::serial_write(dst, dst_size, static_cast<const element_t*>(values[i]), values[i].size(), end, cc0::internal::is_serial_record<element_t>());
+		if (end == 0) {
+			return 0;
+		}
+	}
+	cc0::internal::serial_header header;
+	header.version      = cc0::serial_version;
+	header.type         = cc0::serial_nested;
+	header.order        = cc0::internal::serial_native_order();
+	header.element_size = 0;
+	header.align        = uint32_t(cc0::internal::serial_header_align);
+	header.count        = count;
+	header.size         = end - start;
+	memset(dst + at, 0, start - at);
+	cc0::internal::write_serial_header(dst + start, header);
+	return end;
+}
+
+template < typename type_t >
+bool cc0::internal::serial_read_elements(const uint8_t *src, uint64_t, uint64_t at, const cc0::internal::serial_header &header, type_t *dst, std::false_type)
+{
+	static_assert(std::is_trivially_copyable<type_t>::value, "Serialized elements must be trivially copyable");
+	if (header.type != cc0::internal::serial_tag<type_t>::value || header.element_size != sizeof(type_t)) {
+		return false;
+	}
+	const bool swap = header.order != cc0::internal::serial_native_order();
+	if (swap && header.type == cc0::serial_opaque) {
+		return false;
+	}
+	if (header.count > 0) {
+		memcpy(static_cast<void*>(dst), src + cc0::internal::serial_payload(at, header), header.count * sizeof(type_t));
+		if (swap) {
+			cc0::internal::swap_bytes(dst, sizeof(type_t), header.count);
+		}
+	}
+	return true;
+}
+
+template < typename type_t >
+bool cc0::internal::serial_read_elements(const uint8_t *src, uint64_t, uint64_t at, const cc0::internal::serial_header &header, type_t *dst, std::true_type)
+{
+	if (header.type != cc0::serial_nested) {
+		return false;
+	}
+	// Nested records must stay within the record that holds them.
+	const uint64_t end = at + header.size;
+	at += cc0::internal::serial_header_size;
+	for (uint64_t i = 0; i < header.count; ++i) {
+		at = cc0::internal::serial_read(src, end, at, dst[i]);
+		if (at == 0) {
+			return false;
+		}
+	}
+	return at == end;
+}
+
+template < typename type_t, uint64_t align_u >
+uint64_t cc0::internal::serial_read(const uint8_t *src, uint64_t src_size, uint64_t at, cc0::array<type_t,0,align_u> &dst)
+{
+	at = cc0::internal::serial_align_up(at, cc0::internal::serial_header_align);
+	cc0::internal::serial_header header;
+	if (!cc0::internal::read_serial_header(src, src_size, at, header)) {
+		return 0;
+	}
+	// Every nested element is at least a header, which bounds the allocation by the size of the record.
+	if (header.type == cc0::serial_nested && header.count > header.size / cc0::internal::serial_header_size) {
+		return 0;
+	}
+	dst.create(header.count);
+	if (!cc0::internal::serial_read_elements(src, src_size, at, header, static_cast<type_t*>(dst), cc0::internal::is_serial_record<type_t>())) {
+		dst.create(0);
+		return 0;
+	}
+	return at + header.size;
+}
+
+template < typename type_t, uint64_t size_u, uint64_t align_u >
+uint64_t cc0::internal::serial_read(const uint8_t *src, uint64_t src_size, uint64_t at, cc0::array<type_t,size_u,align_u> &dst)
+{
+	at = cc0::internal::serial_align_up(at, cc0::internal::serial_header_align);
+	cc0::internal::serial_header header;
+	if (!cc0::internal::read_serial_header(src, src_size, at, header) || header.count != size_u) {
+		return 0;
+	}
+	if (!cc0::internal::serial_read_elements(src, src_size, at, header, static_cast<type_t*>(dst), cc0::internal::is_serial_record<type_t>())) {
+		return 0;
+	}
+	return at + header.size;
+}
+
+template < typename type_t >
+uint64_t cc0::internal::serial_read(const uint8_t *src, uint64_t src_size, uint64_t at, cc0::slice<const type_t> &dst)
+{
+	static_assert(!cc0::internal::is_serial_record<typename std::remove_cv<type_t>::type>::value, "Nested arrays can not be viewed in place; load them into an array of slices");
+	at = cc0::internal::serial_align_up(at, cc0::internal::serial_header_align);
+	cc0::internal::serial_header header;
+	if (!cc0::internal::read_serial_header(src, src_size, at, header)) {
+		return 0;
+	}
+	typedef typename std::remove_cv<type_t>::type element_t;
+	if (header.type != cc0::internal::serial_tag<element_t>::value || header.element_size != sizeof(element_t) || header.order != cc0::internal::serial_native_order()) {
+		return 0;
+	}
+	const uint8_t *payload = src + cc0::internal::serial_payload(at, header);
+	if (reinterpret_cast<uintptr_t>(payload) % alignof(element_t) != 0) {
+		return 0;
+	}
+	dst = cc0::slice<const type_t>(reinterpret_cast<const type_t*>(payload), header.count);
+	return at + header.size;
+}
+
+template < typename type_t >
+uint64_t cc0::serialized_size(cc0::slice<const type_t> src)
+{
+	typedef typename std::remove_cv<type_t>::type element_t;
+	return cc0::internal::serial_size(static_cast<const element_t*>(src), src.size(), 0, cc0::internal::is_serial_record<element_t>());
+}
+
+template < typename type_t >
+uint64_t cc0::serialize(cc0::slice<uint8_t> dst, cc0::slice<const type_t> src, uint64_t at)
+{
+	typedef typename std::remove_cv<type_t>::type element_t;
+	return cc0::internal::serial_write(static_cast<uint8_t*>(dst), dst.size(), static_cast<const element_t*>(src), src.size(), at, cc0::internal::is_serial_record<element_t>());
+}
+
+template < typename type_t, uint64_t align_u >
+uint64_t cc0::serialize(cc0::array<uint8_t,0,align_u> &dst, cc0::slice<const type_t> src)
+{
+	typedef typename std::remove_cv<type_t>::type element_t;
+	const uint64_t at = dst.size();
+	dst.resize(cc0::internal::serial_size(static_cast<const element_t*>(src), src.size(), at, cc0::internal::is_serial_record<element_t>()));
+	return cc0::internal::serial_write(static_cast<uint8_t*>(dst), dst.size(), static_cast<const element_t*>(src), src.size(), at, cc0::internal::is_serial_record<element_t>());
+}
+
+template < typename type_t >
+uint64_t cc0::deserialize(cc0::slice<const uint8_t> src, type_t &dst, uint64_t at)
+{
+	return cc0::internal::serial_read(static_cast<const uint8_t*>(src), src.size(), at, dst);
+}
+
+#endif
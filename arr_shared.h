@@ -0,0 +1,284 @@
+/// @file
+/// @author github.com/SirJonthe
+/// @date 2023
+/// @copyright Public domain.
+/// @license CC0 1.0
+
+#ifndef CC0_ARR_SHARED_H_INCLUDED__
+#define CC0_ARR_SHARED_H_INCLUDED__
+
+#include <atomic>
+#include "arr.h"
+
+namespace cc0
+{
+	/// @brief A reference-counted, copy-on-write array. Copying a shared array only increments an atomic reference count, and all copies view the same elements until one of them asks for mutable access, at which point that copy makes a deep copy of its own if the elements are still shared. Reading never copies, and shared arrays convert to read-only slices at no cost.
+	/// @note Distinct shared arrays sharing the same elements can be used from different threads at the same time. A single shared array object is not synchronized.
+	/// @tparam type_t The type of the array.
+	/// @tparam align_u The alignment of the array.
+	template < typename type_t, uint64_t align_u = alignof(type_t) >
+	class shared_array
+	{
+	private:
+		/// @brief The shared elements and their reference count.
+		struct block
+		{
+			std::atomic<uint64_t>         refs;
+			cc0::array<type_t,0,align_u>  values;
+		};
+
+	private:
+		block *m_block;
+
+	private:
+		/// @brief Creates a block holding a given array.
+		/// @param values The array to move into the block.
+		/// @return The block.
+		static block *new_block(cc0::array<type_t,0,align_u> &&values);
+
+		/// @brief Drops the reference to the shared elements, destroying them if this was the last reference.
+		void release( void );
+
+	public:
+		/// @brief Creates an empty array.
+		shared_array( void );
+
+		/// @brief Creates an array of a given size. Elements are default-initialized.
+		/// @param size The number of elements.
+		/// @param allocator The allocator to allocate the elements with. Null selects the default allocator.
+		explicit shared_array(uint64_t size, cc0::allocator *allocator = nullptr);
+
+		/// @brief Creates an array by copying the elements of an array.
+		/// @param arr The array to copy.
+		explicit shared_array(const cc0::array<type_t,0,align_u> &arr);
+
+		/// @brief Creates an array by taking over the memory of an array, without copying elements.
+		/// @param arr The array to take over. Left empty.
+		explicit shared_array(cc0::array<type_t,0,align_u> &&arr);
+
+		/// @brief Creates an array by copying the elements of a slice.
+		/// @param arr The slice to copy.
+		explicit shared_array(cc0::slice<const type_t> arr);
+
+		/// @brief Shares the elements of another array.
+		/// @param arr The other array.
+		shared_array(const shared_array &arr);
+
+		/// @brief Takes over the reference of another array, leaving the other array empty.
+		/// @param arr The other array.
+		shared_array(shared_array &&arr);
+
+		/// @brief Drops the reference to the shared elements.
+		~shared_array( void );
+
+		/// @brief Drops the reference to the current elements, and shares the elements of another array.
+		/// @param arr The other array.
+		/// @return A reference to the object being assigned.
+		shared_array &operator=(const shared_array &arr);
+
+		/// @brief Drops the reference to the current elements, and takes over the reference of another array, leaving the other array empty.
+		/// @param arr The other array.
+		/// @return A reference to the object being assigned.
+		shared_array &operator=(shared_array &&arr);
+
+		/// @brief Gets mutable access to the elements, first making a deep copy of the elements if they are shared with other arrays. Pointers and slices obtained from the array before are invalidated if a copy is made.
+		/// @return The mutable elements.
+		cc0::slice<type_t> write( void );
+
+		/// @brief Drops the reference to the shared elements, leaving the array empty.
+		void reset( void );
+
+		/// @brief Allows direct read-only access to the elements. Never copies.
+		/// @return The pointer to the array data.
+		operator const type_t*( void ) const;
+
+#if defined(CC0_ARR_CHECKED)
+		/// @brief Accesses an element for reading, asserting that the index is within bounds. Only declared in checked mode; otherwise indexing decays to the pointer to the array data.
+		/// @tparam index_t The type of the index.
+		/// @param i The index of the element.
+		/// @return A reference to the element.
+		template < typename index_t >
+		const type_t &operator[](index_t i) const;
+#endif
+
+		/// @brief Converts the array into a read-only slice covering the full span of the array. Never copies.
+		/// @return The slice.
+		operator cc0::slice<const type_t>( void ) const;
+
+		/// @brief Provides a read-only view of the array with the given index bounds. Never copies.
+		/// @param start The start index of the view (inclusive).
+		/// @param end The end index of the view (non-inclusive).
+		/// @return The slice view of the array.
+		cc0::slice<const type_t> operator()(uint64_t start, uint64_t end) const;
+
+		/// @brief Determines if the array is the only reference to its elements, in which case write does not copy.
+		/// @return True if the array is not sharing its elements.
+		bool is_unique( void ) const;
+
+		/// @brief Gets the number of arrays sharing the elements.
+		/// @return The number of references, or 0 if the array is empty.
+		uint64_t use_count( void ) const;
+
+		/// @brief Gets the size of the array.
+		/// @return The number of elements in the array.
+		uint64_t size( void ) const;
+	};
+}
+
+template < typename type_t, uint64_t align_u >
+typename cc0::shared_array<type_t,align_u>::block *cc0::shared_array<type_t,align_u>::new_block(cc0::array<type_t,0,align_u> &&values)
+{
+	// The block is allocated with the allocator of the elements, so that it can be freed once the elements are gone.
+	block *b = static_cast<block*>(cc0::internal::allocate(values.get_allocator(), sizeof(block), alignof(block)));
+	new (&b->refs) std::atomic<uint64_t>(1);
+	new (&b->values) cc0::array<type_t,0,align_u>(std::move(values));
+	return b;
+}
+
+template < typename type_t, uint64_t align_u >
+void cc0::shared_array<type_t,align_u>::release( void )
+{
+	if (m_block != nullptr && m_block->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+		cc0::allocator *allocator = m_block->values.get_allocator();
+		m_block->values.~array();
+		m_block->refs.~atomic();
+		cc0::internal::deallocate(allocator, m_block, sizeof(block), alignof(block));
+	}
+	m_block = nullptr;
+}
+
+template < typename type_t, uint64_t align_u >
+cc0::shared_array<type_t,align_u>::shared_array( void ) : m_block(nullptr)
+{}
+
+template < typename type_t, uint64_t align_u >
+cc0::shared_array<type_t,align_u>::shared_array(uint64_t size, cc0::allocator *allocator) : m_block(new_block(cc0::array<type_t,0,align_u>(size, allocator)))
+{}
+
+template < typename type_t, uint64_t align_u >
+cc0::shared_array<type_t,align_u>::shared_array(const cc0::array<type_t,0,align_u> &arr) : m_block(new_block(cc0::array<type_t,0,align_u>(arr)))
+{}
+
+template < typename type_t, uint64_t align_u >
+cc0::shared_array<type_t,align_u>::shared_array(cc0::array<type_t,0,align_u> &&arr) : m_block(new_block(std::move(arr)))
+{}
+
+template < typename type_t, uint64_t align_u >
+cc0::shared_array<type_t,align_u>::shared_array(cc0::slice<const type_t> arr) : m_block(new_block(cc0::array<type_t,0,align_u>(arr)))
+{}
+
+template < typename type_t, uint64_t align_u >
+cc0::shared_array<type_t,align_u>::shared_array(const cc0::shared_array<type_t,align_u> &arr) : m_block(arr.m_block)
+{
+	if (m_block != nullptr) {
+		m_block->refs.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+template < typename type_t, uint64_t align_u >
+cc0::shared_array<type_t,align_u>::shared_array(cc0::shared_array<type_t,align_u> &&arr) : m_block(arr.m_block)
+{
+	arr.m_block = nullptr;
+}
+
+template < typename type_t, uint64_t align_u >
+cc0::shared_array<type_t,align_u>::~shared_array( void )
+{
+	release();
+}
+
+template < typename type_t, uint64_t align_u >
+cc0::shared_array<type_t,align_u> &cc0::shared_array<type_t,align_u>::operator=(const cc0::shared_array<type_t,align_u> &arr)
+{
+	if (m_block != arr.m_block) {
+		if (arr.m_block != nullptr) {
+			arr.m_block->refs.fetch_add(1, std::memory_order_relaxed);
+		}
+		release();
+		m_block = arr.m_block;
+	}
+	return *this;
+}
+
+template < typename type_t, uint64_t align_u >
+cc0::shared_array<type_t,align_u> &cc0::shared_array<type_t,align_u>::operator=(cc0::shared_array<type_t,align_u> &&arr)
+{
+	if (this != &arr) {
+		release();
+		m_block = arr.m_block;
+		arr.m_block = nullptr;
+	}
+	return *this;
+}
+
+template < typename type_t, uint64_t align_u >
+cc0::slice<type_t> cc0::shared_array<type_t,align_u>::write( void )
+{
+	if (m_block == nullptr) {
+		return cc0::slice<type_t>();
+	}
+	// The acquire pairs with the release of other references, so that their reads of the elements happen before the elements are modified.
+	if (m_block->refs.load(std::memory_order_acquire) != 1) {
+		cc0::array<type_t,0,align_u> values(m_block->values.get_allocator());
+		values = m_block->values;
+		block *copy = new_block(std::move(values));
+		release();
+		m_block = copy;
+	}
+	return m_block->values;
+}
+
+template < typename type_t, uint64_t align_u >
+void cc0::shared_array<type_t,align_u>::reset( void )
+{
+	release();
+}
+
+template < typename type_t, uint64_t align_u >
+cc0::shared_array<type_t,align_u>::operator const type_t*( void ) const
+{
+	return m_block != nullptr ? static_cast<const type_t*>(m_block->values) : nullptr;
+}
+
+#if defined(CC0_ARR_CHECKED)
+template < typename type_t, uint64_t align_u >
+template < typename index_t >
+const type_t &cc0::shared_array<type_t,align_u>::operator[](index_t i) const
+{
+	CC0_ARR_ASSERT(static_cast<uint64_t>(i) < size());
+	return static_cast<const type_t*>(m_block->values)[i];
+}
+#endif
+
+template < typename type_t, uint64_t align_u >
+cc0::shared_array<type_t,align_u>::operator cc0::slice<const type_t>( void ) const
+{
+	return cc0::slice<const type_t>(static_cast<const type_t*>(*this), size());
+}
+
+template < typename type_t, uint64_t align_u >
+cc0::slice<const type_t> cc0::shared_array<type_t,align_u>::operator()(uint64_t start, uint64_t end) const
+{
+	CC0_ARR_ASSERT(start <= end && end <= size());
+	return cc0::slice<const type_t>(static_cast<const type_t*>(*this) + start, end - start);
+}
+
+template < typename type_t, uint64_t align_u >
+bool cc0::shared_array<type_t,align_u>::is_unique( void ) const
+{
+	return m_block == nullptr || m_block->refs.load(std::memory_order_acquire) == 1;
+}
+
+template < typename type_t, uint64_t align_u >
+uint64_t cc0::shared_array<type_t,align_u>::use_count( void ) const
+{
+	return m_block != nullptr ? m_block->refs.load(std::memory_order_relaxed) : 0;
+}
+
+template < typename type_t, uint64_t align_u >
+uint64_t cc0::shared_array<type_t,align_u>::size( void ) const
+{
+	return m_block != nullptr ? m_block->values.size() : 0;
+}
+
+#endif
@@ -0,0 +1,523 @@
+/// @file
+/// @author github.com/SirJonthe
+/// @date 2023
+/// @copyright Public domain.
+/// @license CC0 1.0
+
+#ifndef CC0_ARR_SOA_H_INCLUDED__
+#define CC0_ARR_SOA_H_INCLUDED__
+
+#include <tuple>
+#include "arr.h"
+
+namespace cc0
+{
+	namespace internal
+	{
+		/// @brief The alignment of a column in a structure-of-arrays; at least a cache line, so that no two columns share a cache line and all columns are suitably aligned for vector loads.
+		template < typename type_t >
+		struct soa_align
+		{
+			static constexpr uint64_t value = alignof(type_t) > cc0::cache_line_align ? alignof(type_t) : cc0::cache_line_align;
+		};
+	}
+
+	/// @brief A variable-size array of rows where each field of the rows is stored in a separate, contiguous and aligned column. Processing a single field only touches the memory of that field, and each column can be handed to vectorized kernels as a slice. All columns are always resized together.
+	/// @tparam fields_t The types of the fields of a row.
+	template < typename... fields_t >
+	class soa_array
+	{
+		static_assert(sizeof...(fields_t) > 0, "A structure-of-arrays must have at least one field.");
+
+	public:
+		/// @brief The value of a row.
+		typedef std::tuple<fields_t...> value_type;
+
+		/// @brief Information about a field.
+		/// @tparam field_u The index of the field.
+		template < uint64_t field_u >
+		struct field
+		{
+			typedef typename std::tuple_element<field_u, value_type>::type type;     // The type of the field.
+			static constexpr uint64_t align = cc0::internal::soa_align<type>::value; // The alignment of the column of the field.
+		};
+
+		/// @brief A reference to a row, in place of the reference to a structure an array-of-structures would provide.
+		class reference
+		{
+			friend class soa_array;
+
+		private:
+			soa_array *m_arr;
+			uint64_t   m_index;
+
+		private:
+			/// @brief References a row.
+			/// @param arr The array.
+			/// @param index The index of the row.
+			reference(soa_array *arr, uint64_t index);
+
+		public:
+			/// @brief References the same row as another reference.
+			/// @param row The other reference.
+			reference(const reference &row) = default;
+
+			/// @brief Accesses a field of the row.
+			/// @tparam field_u The index of the field.
+			/// @return A reference to the field.
+			template < uint64_t field_u >
+			typename field<field_u>::type &get( void ) const;
+
+			/// @brief Reads the row.
+			/// @return The values of the fields of the row.
+			operator value_type( void ) const;
+
+			/// @brief Writes the row.
+			/// @param value The values to write to the fields of the row.
+			/// @return A reference to the object being assigned.
+			const reference &operator=(const value_type &value) const;
+
+			/// @brief Copies the values of one row to another. Does not change which row is referenced.
+			/// @param row The other row.
+			/// @return A reference to the object being assigned.
+			const reference &operator=(const reference &row) const;
+		};
+
+		/// @brief A read-only reference to a row.
+		class const_reference
+		{
+			friend class soa_array;
+
+		private:
+			const soa_array *m_arr;
+			uint64_t         m_index;
+
+		private:
+			/// @brief References a row.
+			/// @param arr The array.
+			/// @param index The index of the row.
+			const_reference(const soa_array *arr, uint64_t index);
+
+		public:
+			/// @brief Converts a reference into a read-only reference.
+			/// @param row The reference.
+			const_reference(const reference &row);
+
+			/// @brief Accesses a field of the row.
+			/// @tparam field_u The index of the field.
+			/// @return A reference to the field.
+			template < uint64_t field_u >
+			const typename field<field_u>::type &get( void ) const;
+
+			/// @brief Reads the row.
+			/// @return The values of the fields of the row.
+			operator value_type( void ) const;
+		};
+
+	private:
+		typedef typename cc0::internal::make_index_list<sizeof...(fields_t)>::type indices;
+
+		/// @brief Shrinks all columns back to a number of rows when going out of scope unless released, so that all columns keep the same size if growing one of them throws.
+		struct size_guard
+		{
+			soa_array *arr;
+			uint64_t   size;
+
+			/// @brief Shrinks the columns, unless released.
+			~size_guard( void );
+		};
+
+	private:
+		std::tuple< cc0::array<fields_t,0,cc0::internal::soa_align<fields_t>::value>... > m_columns;
+
+	private:
+		/// @brief Computes the capacity to grow to in order to fit at least a given number of rows, growing geometrically to amortize the cost of repeated growth.
+		/// @param size The number of rows that need to fit.
+		/// @return The new capacity.
+		uint64_t grow(uint64_t size) const;
+
+		template < uint64_t... i_u >
+		void truncate(uint64_t size, cc0::internal::index_list<i_u...>);
+
+		template < uint64_t... i_u >
+		void create(uint64_t size, bool use_pool, cc0::internal::index_list<i_u...>);
+
+		template < uint64_t... i_u >
+		void destroy(bool use_pool, cc0::internal::index_list<i_u...>);
+
+		template < uint64_t... i_u >
+		void reserve(uint64_t capacity, cc0::internal::index_list<i_u...>);
+
+		template < uint64_t... i_u >
+		void resize(uint64_t size, cc0::internal::index_list<i_u...>);
+
+		template < uint64_t... i_u >
+		void push_back(cc0::internal::index_list<i_u...>, const fields_t&... values);
+
+		template < uint64_t... i_u >
+		void shrink_to_fit(cc0::internal::index_list<i_u...>);
+
+		template < uint64_t... i_u >
+		void set_allocator(cc0::allocator *allocator, cc0::internal::index_list<i_u...>);
+
+		template < uint64_t... i_u >
+		value_type get(uint64_t index, cc0::internal::index_list<i_u...>) const;
+
+		template < uint64_t... i_u >
+		void set(uint64_t index, const value_type &value, cc0::internal::index_list<i_u...>);
+
+	public:
+		/// @brief Default constructor. Creates an empty array.
+		soa_array( void );
+
+		/// @brief Creates an empty array that allocates the memory of all columns via the given allocator.
+		/// @param allocator The allocator. Null selects the default allocator.
+		explicit soa_array(cc0::allocator *allocator);
+
+		/// @brief Creates an array with the given number of default-initialized rows.
+		/// @param size The number of rows.
+		explicit soa_array(uint64_t size);
+
+		/// @brief Creates an array with the given number of default-initialized rows that allocates the memory of all columns via the given allocator.
+		/// @param size The number of rows.
+		/// @param allocator The allocator. Null selects the default allocator.
+		soa_array(uint64_t size, cc0::allocator *allocator);
+
+		/// @brief Creates a new array with the given number of rows, destroying the previous contents.
+		/// @param size The number of rows.
+		/// @param use_pool Reuses the already allocated memory of the columns if it is large enough.
+		void create(uint64_t size, bool use_pool = true);
+
+		/// @brief Destroys all rows.
+		/// @param use_pool Keeps the allocated memory of the columns for later use.
+		void destroy(bool use_pool = true);
+
+		/// @brief Ensures that all columns can hold the given number of rows without allocating new memory.
+		/// @param capacity The number of rows.
+		void reserve(uint64_t capacity);
+
+		/// @brief Changes the number of rows, preserving existing rows. New rows are default-initialized. If growing throws, the number of rows is unchanged.
+		/// @param size The number of rows.
+		void resize(uint64_t size);
+
+		/// @brief Appends a row. If appending throws, the number of rows is unchanged.
+		/// @param values The values of the fields of the row.
+		void push_back(const fields_t&... values);
+
+		/// @brief Appends a row. If appending throws, the number of rows is unchanged.
+		/// @param value The values of the fields of the row.
+		void push_back(const value_type &value);
+
+		/// @brief Reduces the capacity of all columns to the number of rows.
+		void shrink_to_fit( void );
+
+		/// @brief Sets the allocator of all columns. Allocated memory is freed.
+		/// @param allocator The allocator. Null selects the default allocator.
+		void set_allocator(cc0::allocator *allocator);
+
+		/// @brief Provides a view of the column of a field.
+		/// @tparam field_u The index of the field.
+		/// @return The aligned slice of all values of the field.
+		template < uint64_t field_u >
+		cc0::aligned_slice<typename field<field_u>::type, field<field_u>::align> column( void );
+
+		/// @brief Provides a view of the column of a field.
+		/// @tparam field_u The index of the field.
+		/// @return The aligned slice of all values of the field.
+		template < uint64_t field_u >
+		cc0::aligned_slice<const typename field<field_u>::type, field<field_u>::align> column( void ) const;
+
+		/// @brief Accesses a row.
+		/// @param index The index of the row.
+		/// @return A reference to the row.
+		reference operator[](uint64_t index);
+
+		/// @brief Accesses a row.
+		/// @param index The index of the row.
+		/// @return A reference to the row.
+		const_reference operator[](uint64_t index) const;
+
+		/// @brief Gets the size of the array.
+		/// @return The number of rows in the array.
+		uint64_t size( void ) const;
+
+		/// @brief Gets the capacity of the array.
+		/// @return The number of rows the array can hold without allocating new memory.
+		uint64_t capacity( void ) const;
+	};
+}
+
+template < typename... fields_t >
+cc0::soa_array<fields_t...>::reference::reference(cc0::soa_array<fields_t...> *arr, uint64_t index) : m_arr(arr), m_index(index)
+{}
+
+template < typename... fields_t >
+template < uint64_t field_u >
+typename cc0::soa_array<fields_t...>::template field<field_u>::type &cc0::soa_array<fields_t...>::reference::get( void ) const
+{
+	return std::get<field_u>(m_arr->m_columns)[m_index];
+}
+
+template < typename... fields_t >
+cc0::soa_array<fields_t...>::reference::operator value_type( void ) const
+{
+	return m_arr->get(m_index, indices());
+}
+
+template < typename... fields_t >
+const typename cc0::soa_array<fields_t...>::reference &cc0::soa_array<fields_t...>::reference::operator=(const value_type &value) const
+{
+	m_arr->set(m_index, value, indices());
+	return *this;
+}
+
+template < typename... fields_t >
+const typename cc0::soa_array<fields_t...>::reference &cc0::soa_array<fields_t...>::reference::operator=(const reference &row) const
+{
+	m_arr->set(m_index, value_type(row), indices());
+	return *this;
+}
+
+template < typename... fields_t >
+cc0::soa_array<fields_t...>::const_reference::const_reference(const cc0::soa_array<fields_t...> *arr, uint64_t index) : m_arr(arr), m_index(index)
+{}
+
+template < typename... fields_t >
+cc0::soa_array<fields_t...>::const_reference::const_reference(const reference &row) : m_arr(row.m_arr), m_index(row.m_index)
+{}
+
+template < typename... fields_t >
+template < uint64_t field_u >
+const typename cc0::soa_array<fields_t...>::template field<field_u>::type &cc0::soa_array<fields_t...>::const_reference::get( void ) const
+{
+	return std::get<field_u>(m_arr->m_columns)[m_index];
+}
+
+template < typename... fields_t >
+cc0::soa_array<fields_t...>::const_reference::operator value_type( void ) const
+{
+	return m_arr->get(m_index, indices());
+}
+
+template < typename... fields_t >
+template < uint64_t... i_u >
+void cc0::soa_array<fields_t...>::create(uint64_t size, bool use_pool, cc0::internal::index_list<i_u...>)
+{
+	const int expand[] = { (std::get<i_u>(m_columns).create(size, use_pool), 0)... };
+	(void)expand;
+}
+
+template < typename... fields_t >
+template < uint64_t... i_u >
+void cc0::soa_array<fields_t...>::destroy(bool use_pool, cc0::internal::index_list<i_u...>)
+{
+	const int expand[] = { (std::get<i_u>(m_columns).destroy(use_pool), 0)... };
+	(void)expand;
+}
+
+template < typename... fields_t >
+template < uint64_t... i_u >
+void cc0::soa_array<fields_t...>::reserve(uint64_t capacity, cc0::internal::index_list<i_u...>)
+{
+	const int expand[] = { (std::get<i_u>(m_columns).reserve(capacity), 0)... };
+	(void)expand;
+}
+
+template < typename... fields_t >
+cc0::soa_array<fields_t...>::size_guard::~size_guard( void )
+{
+	if (arr != nullptr) {
+		arr->truncate(size, indices());
+	}
+}
+
+template < typename... fields_t >
+uint64_t cc0::soa_array<fields_t...>::grow(uint64_t size) const
+{
+	const uint64_t capacity = this->capacity() > ~uint64_t(0) / 2 ? ~uint64_t(0) : this->capacity() * 2;
+	return capacity > size ? capacity : size;
+}
+
+template < typename... fields_t >
+template < uint64_t... i_u >
+void cc0::soa_array<fields_t...>::truncate(uint64_t size, cc0::internal::index_list<i_u...>)
+{
+	// Shrinking only destroys rows, so it cannot throw.
+	const int expand[] = { (std::get<i_u>(m_columns).size() > size ? std::get<i_u>(m_columns).resize(size) : void(), 0)... };
+	(void)expand;
+}
+
+template < typename... fields_t >
+template < uint64_t... i_u >
+void cc0::soa_array<fields_t...>::resize(uint64_t size, cc0::internal::index_list<i_u...>)
+{
+	const int expand[] = { (std::get<i_u>(m_columns).resize(size), 0)... };
+	(void)expand;
+}
+
+template < typename... fields_t >
+template < uint64_t... i_u >
+void cc0::soa_array<fields_t...>::push_back(cc0::internal::index_list<i_u...>, const fields_t&... values)
+{
+	const int expand[] = { (std::get<i_u>(m_columns).push_back(values), 0)... };
+	(void)expand;
+}
+
+template < typename... fields_t >
+template < uint64_t... i_u >
+void cc0::soa_array<fields_t...>::shrink_to_fit(cc0::internal::index_list<i_u...>)
+{
+	const int expand[] = { (std::get<i_u>(m_columns).shrink_to_fit(), 0)... };
+	(void)expand;
+}
+
+template < typename... fields_t >
+template < uint64_t... i_u >
+void cc0::soa_array<fields_t...>::set_allocator(cc0::allocator *allocator, cc0::internal::index_list<i_u...>)
+{
+	const int expand[] = { (std::get<i_u>(m_columns).set_allocator(allocator), 0)... };
+	(void)expand;
+}
+
+template < typename... fields_t >
+template < uint64_t... i_u >
+typename cc0::soa_array<fields_t...>::value_type cc0::soa_array<fields_t...>::get(uint64_t index, cc0::internal::index_list<i_u...>) const
+{
+	return value_type(std::get<i_u>(m_columns)[index]...);
+}
+
+template < typename... fields_t >
+template < uint64_t... i_u >
+void cc0::soa_array<fields_t...>::set(uint64_t index, const value_type &value, cc0::internal::index_list<i_u...>)
+{
+	const int expand[] = { (std::get<i_u>(m_columns)[index] = std::get<i_u>(value), 0)... };
+	(void)expand;
+}
+
+template < typename... fields_t >
+cc0::soa_array<fields_t...>::soa_array( void ) : m_columns()
+{}
+
+template < typename... fields_t >
+cc0::soa_array<fields_t...>::soa_array(cc0::allocator *allocator) : m_columns()
+{
+	set_allocator(allocator);
+}
+
+template < typename... fields_t >
+cc0::soa_array<fields_t...>::soa_array(uint64_t size) : m_columns()
+{
+	create(size);
+}
+
+template < typename... fields_t >
+cc0::soa_array<fields_t...>::soa_array(uint64_t size, cc0::allocator *allocator) : m_columns()
+{
+	set_allocator(allocator);
+	create(size);
+}
+
+template < typename... fields_t >
+void cc0::soa_array<fields_t...>::create(uint64_t size, bool use_pool)
+{
+	create(size, use_pool, indices());
+}
+
+template < typename... fields_t >
+void cc0::soa_array<fields_t...>::destroy(bool use_pool)
+{
+	destroy(use_pool, indices());
+}
+
+template < typename... fields_t >
+void cc0::soa_array<fields_t...>::reserve(uint64_t capacity)
+{
+	reserve(capacity, indices());
+}
+
+template < typename... fields_t >
+void cc0::soa_array<fields_t...>::resize(uint64_t size)
+{
+	// Allocate all columns before growing any, and undo the growth if constructing a row throws.
+	if (size > capacity()) {
+		reserve(grow(size));
+	}
+	size_guard guard = { this, this->size() };
+	resize(size, indices());
+	guard.arr = nullptr;
+}
+
+template < typename... fields_t >
+void cc0::soa_array<fields_t...>::push_back(const fields_t&... values)
+{
+	// Allocate all columns before appending to any, and undo the append if copying a field throws.
+	if (size() == capacity()) {
+		reserve(grow(size() + 1));
+	}
+	size_guard guard = { this, size() };
+	push_back(indices(), values...);
+	guard.arr = nullptr;
+}
+
+template < typename... fields_t >
+void cc0::soa_array<fields_t...>::push_back(const value_type &value)
+{
+	size_guard guard = { this, size() };
+	resize(size() + 1);
+	set(size() - 1, value, indices());
+	guard.arr = nullptr;
+}
+
+template < typename... fields_t >
+void cc0::soa_array<fields_t...>::shrink_to_fit( void )
+{
+	shrink_to_fit(indices());
+}
+
+template < typename... fields_t >
+void cc0::soa_array<fields_t...>::set_allocator(cc0::allocator *allocator)
+{
+	set_allocator(allocator, indices());
+}
+
+template < typename... fields_t >
+template < uint64_t field_u >
+cc0::aligned_slice<typename cc0::soa_array<fields_t...>::template field<field_u>::type, cc0::soa_array<fields_t...>::template field<field_u>::align> cc0::soa_array<fields_t...>::column( void )
+{
+	return cc0::aligned_slice<typename field<field_u>::type, field<field_u>::align>(std::get<field_u>(m_columns));
+}
+
+template < typename... fields_t >
+template < uint64_t field_u >
+cc0::aligned_slice<const typename cc0::soa_array<fields_t...>::template field<field_u>::type, cc0::soa_array<fields_t...>::template field<field_u>::align> cc0::soa_array<fields_t...>::column( void ) const
+{
+	return cc0::aligned_slice<const typename field<field_u>::type, field<field_u>::align>(std::get<field_u>(m_columns));
+}
+
+template < typename... fields_t >
+typename cc0::soa_array<fields_t...>::reference cc0::soa_array<fields_t...>::operator[](uint64_t index)
+{
+	CC0_ARR_ASSERT(index < size());
+	return reference(this, index);
+}
+
+template < typename... fields_t >
+typename cc0::soa_array<fields_t...>::const_reference cc0::soa_array<fields_t...>::operator[](uint64_t index) const
+{
+	CC0_ARR_ASSERT(index < size());
+	return const_reference(this, index);
+}
+
+template < typename... fields_t >
+uint64_t cc0::soa_array<fields_t...>::size( void ) const
+{
+	return std::get<0>(m_columns).size();
+}
+
+template < typename... fields_t >
+uint64_t cc0::soa_array<fields_t...>::capacity( void ) const
+{
+	return std::get<0>(m_columns).capacity();
+}
+
+#endif
@@ -0,0 +1,730 @@
+/// @file
+/// @author github.com/SirJonthe
+/// @date 2023
+/// @copyright Public domain.
+/// @license CC0 1.0
+
+#ifndef CC0_ARR_SORT_H_INCLUDED__
+#define CC0_ARR_SORT_H_INCLUDED__
+
+#include "arr.h"
+
+namespace cc0
+{
+	/// @brief Sorts the elements of a slice in ascending order. Integer and floating-point elements are sorted by a radix sort, and all other elements by a pattern-defeating quicksort using operator<.
+	/// @note Floating-point elements are ordered as by operator<, with -0 equal to +0, except that NaNs are ordered too, with NaNs that have the sign bit set before and other NaNs after all other values. The order is the same for all sizes of slices.
+	/// @note Radix sorting allocates a temporary buffer of the same size as the slice from the default allocator.
+	/// @tparam type_t The type of the slice.
+	/// @param arr The slice to sort.
+	template < typename type_t >
+	void sort(cc0::slice<type_t> arr);
+
+	/// @brief Sorts the elements of a slice in ascending order using a pattern-defeating quicksort. Runs in O(n log n) time in the worst case, and in linear time for many common patterns, e.g. sorted or reverse sorted input. Equal elements may be reordered.
+	/// @tparam type_t The type of the slice.
+	/// @tparam less_t The type of the comparison.
+	/// @param arr The slice to sort.
+	/// @param less A strict weak ordering, called as less(a, b) to determine if a goes before b.
+	template < typename type_t, typename less_t >
+	void sort(cc0::slice<type_t> arr, less_t less);
+
+	/// @brief Sorts the elements of a slice in ascending order, preserving the order of equal elements. Integer and floating-point elements are sorted by a radix sort, and all other elements by a merge sort using operator<.
+	/// @note Floating-point elements are ordered as by sort, so -0 and +0 are equal and keep their order.
+	/// @note Sorting allocates a temporary buffer of up to the size of the slice from the default allocator.
+	/// @tparam type_t The type of the slice.
+	/// @param arr The slice to sort.
+	template < typename type_t >
+	void stable_sort(cc0::slice<type_t> arr);
+
+	/// @brief Sorts the elements of a slice in ascending order using a merge sort, preserving the order of equal elements.
+	/// @note Sorting allocates a temporary buffer of half the size of the slice from the default allocator.
+	/// @tparam type_t The type of the slice.
+	/// @tparam less_t The type of the comparison.
+	/// @param arr The slice to sort.
+	/// @param less A strict weak ordering, called as less(a, b) to determine if a goes before b.
+	template < typename type_t, typename less_t >
+	void stable_sort(cc0::slice<type_t> arr, less_t less);
+
+	/// @brief Finds the first element in a sorted slice that is not less than a value. The search is branchless, so its running time does not depend on the outcome of comparisons.
+	/// @tparam type_t The type of the slice.
+	/// @param arr The sorted slice.
+	/// @param value The value to search for.
+	/// @return The index of the element, or the size of the slice if all elements are less than the value.
+	template < typename type_t >
+	uint64_t lower_bound(cc0::slice<type_t> arr, const typename std::remove_cv<type_t>::type &value);
+
+	/// @brief Finds the first element in a sorted slice that is not less than a value. The search is branchless, so its running time does not depend on the outcome of comparisons.
+	/// @tparam type_t The type of the slice.
+	/// @tparam value_t The type of the value.
+	/// @tparam less_t The type of the comparison.
+	/// @param arr The slice, sorted by the comparison.
+	/// @param value The value to search for.
+	/// @param less The ordering the slice is sorted by, called as less(element, value).
+	/// @return The index of the element, or the size of the slice if all elements are less than the value.
+	template < typename type_t, typename value_t, typename less_t >
+	uint64_t lower_bound(cc0::slice<type_t> arr, const value_t &value, less_t less);
+
+	/// @brief Finds the first element in a sorted slice that is greater than a value. The search is branchless, so its running time does not depend on the outcome of comparisons.
+	/// @tparam type_t The type of the slice.
+	/// @param arr The sorted slice.
+	/// @param value The value to search for.
+	/// @return The index of the element, or the size of the slice if no element is greater than the value.
+	template < typename type_t >
+	uint64_t upper_bound(cc0::slice<type_t> arr, const typename std::remove_cv<type_t>::type &value);
+
+	/// @brief Finds the first element in a sorted slice that is greater than a value. The search is branchless, so its running time does not depend on the outcome of comparisons.
+	/// @tparam type_t The type of the slice.
+	/// @tparam value_t The type of the value.
+	/// @tparam less_t The type of the comparison.
+	/// @param arr The slice, sorted by the comparison.
+	/// @param value The value to search for.
+	/// @param less The ordering the slice is sorted by, called as less(value, element).
+	/// @return The index of the element, or the size of the slice if no element is greater than the value.
+	template < typename type_t, typename value_t, typename less_t >
+	uint64_t upper_bound(cc0::slice<type_t> arr, const value_t &value, less_t less);
+
+	/// @brief Determines if a sorted slice contains an element equivalent to a value.
+	/// @tparam type_t The type of the slice.
+	/// @param arr The sorted slice.
+	/// @param value The value to search for.
+	/// @return True if the value was found.
+	template < typename type_t >
+	bool binary_search(cc0::slice<type_t> arr, const typename std::remove_cv<type_t>::type &value);
+
+	/// @brief Determines if a sorted slice contains an element equivalent to a value.
+	/// @tparam type_t The type of the slice.
+	/// @tparam value_t The type of the value.
+	/// @tparam less_t The type of the comparison.
+	/// @param arr The slice, sorted by the comparison.
+	/// @param value The value to search for.
+	/// @param less The ordering the slice is sorted by, called both as less(element, value) and less(value, element).
+	/// @return True if the value was found.
+	template < typename type_t, typename value_t, typename less_t >
+	bool binary_search(cc0::slice<type_t> arr, const value_t &value, less_t less);
+
+	/// @brief Copies a sorted slice into Eytzinger (breadth-first binary tree) order, where the children of the element at index k are at indices 2k+1 and 2k+2. Searching the Eytzinger layout touches memory in a predictable pattern that can be prefetched, which is faster than binary search over large slices that are searched much more often than they are modified.
+	/// @tparam type_t The type of the destination slice.
+	/// @tparam type2_t The type of the sorted slice.
+	/// @param dst The slice to write the layout to. Must be the same size as the sorted slice.
+	/// @param sorted The sorted slice.
+	template < typename type_t, typename type2_t >
+	void eytzinger(cc0::slice<type_t> dst, cc0::slice<type2_t> sorted);
+
+	/// @brief Finds the smallest element in an Eytzinger layout that is not less than a value, i.e. the element that lower_bound would find in the sorted slice. The search is branchless and prefetches the elements it will visit next.
+	/// @tparam type_t The type of the layout.
+	/// @param layout The layout created by eytzinger.
+	/// @param value The value to search for.
+	/// @return The index of the element in the layout, or the size of the layout if all elements are less than the value.
+	template < typename type_t >
+	uint64_t eytzinger_lower_bound(cc0::slice<type_t> layout, const typename std::remove_cv<type_t>::type &value);
+
+	/// @brief Finds the smallest element in an Eytzinger layout that is not less than a value, i.e. the element that lower_bound would find in the sorted slice. The search is branchless and prefetches the elements it will visit next.
+	/// @tparam type_t The type of the layout.
+	/// @tparam value_t The type of the value.
+	/// @tparam less_t The type of the comparison.
+	/// @param layout The layout created by eytzinger from a slice sorted by the comparison.
+	/// @param value The value to search for.
+	/// @param less The ordering of the sorted slice, called as less(element, value).
+	/// @return The index of the element in the layout, or the size of the layout if all elements are less than the value.
+	template < typename type_t, typename value_t, typename less_t >
+	uint64_t eytzinger_lower_bound(cc0::slice<type_t> layout, const value_t &value, less_t less);
+}
+
+namespace cc0
+{
+	namespace internal
+	{
+		/// @brief Compares values using operator<.
+		struct less_op
+		{
+			template < typename type_t, typename type2_t >
+			bool operator()(const type_t &a, const type2_t &b) const { return a < b; }
+		};
+
+		/// @brief Slices shorter than this are sorted by insertion sort.
+		constexpr uint64_t insertion_sort_threshold = 24;
+
+		/// @brief Slices longer than this use the pseudomedian of nine elements as pivot.
+		constexpr uint64_t ninther_threshold = 128;
+
+		/// @brief The number of element moves after which partial insertion sort gives up.
+		constexpr uint64_t partial_insertion_sort_limit = 8;
+
+		/// @brief Slices shorter than this are not radix sorted, since computing the digit histograms would dominate.
+		constexpr uint64_t radix_sort_threshold = 256;
+
+		/// @brief Determines if elements are sorted by radix sort.
+		template < typename type_t >
+		struct is_radix_sortable : std::integral_constant<bool, ((std::is_integral<type_t>::value && !std::is_same<type_t,bool>::value) || std::is_floating_point<type_t>::value) && (sizeof(type_t) == 1 || sizeof(type_t) == 2 || sizeof(type_t) == 4 || sizeof(type_t) == 8)> {};
+
+		/// @brief The unsigned integer type of a given size.
+		template < uint64_t size_u > struct radix_key;
+		template <> struct radix_key<1> { typedef uint8_t  type; };
+		template <> struct radix_key<2> { typedef uint16_t type; };
+		template <> struct radix_key<4> { typedef uint32_t type; };
+		template <> struct radix_key<8> { typedef uint64_t type; };
+
+		/// @brief Maps an unsigned integer to its radix key, which sorts as unsigned integers sort.
+		template < typename key_t, typename type_t >
+		key_t to_radix_key(type_t value, std::integral_constant<int,0>)
+		{
+			return key_t(value);
+		}
+
+		/// @brief Maps a signed integer to its radix key by flipping the sign bit, which sorts negative values before positive values.
+		template < typename key_t, typename type_t >
+		key_t to_radix_key(type_t value, std::integral_constant<int,1>)
+		{
+			return key_t(value) ^ (key_t(1) << (sizeof(key_t) * 8 - 1));
+		}
+
+		/// @brief Maps a floating-point value to its radix key by flipping all bits of negative values, and the sign bit of positive values. -0 is mapped to the key of +0, so that the two compare equal as they do under operator<.
+		template < typename key_t, typename type_t >
+		key_t to_radix_key(type_t value, std::integral_constant<int,2>)
+		{
+			key_t bits;
+			memcpy(&bits, &value, sizeof(key_t));
+			const key_t sign = key_t(1) << (sizeof(key_t) * 8 - 1);
+			bits = key_t(bits << 1) == 0 ? key_t(0) : bits;
+			return bits ^ (key_t(0 - (bits >> (sizeof(key_t) * 8 - 1))) | sign);
+		}
+
+		/// @brief Compares values by their radix keys, so that slices too short to radix sort are ordered exactly as radix sorted slices are.
+		template < typename type_t >
+		struct radix_less
+		{
+			typedef typename cc0::internal::radix_key<sizeof(type_t)>::type key_t;
+			typedef std::integral_constant<int, std::is_floating_point<type_t>::value ? 2 : (std::is_signed<type_t>::value ? 1 : 0)> kind_t;
+			bool operator()(const type_t &a, const type_t &b) const { return cc0::internal::to_radix_key<key_t>(a, kind_t()) < cc0::internal::to_radix_key<key_t>(b, kind_t()); }
+		};
+
+		/// @brief Sorts elements by the digits of their radix keys, least significant digit first. Stable. Digits are 11 bits wide, which keeps the histograms small enough to stay in cache while reducing the number of passes over the elements, e.g. to 6 for 64-bit keys. Passes over digits that are identical for all elements are skipped.
+		template < typename type_t >
+		void radix_sort(type_t *values, uint64_t count)
+		{
+			typedef typename cc0::internal::radix_key<sizeof(type_t)>::type key_t;
+			typedef std::integral_constant<int, std::is_floating_point<type_t>::value ? 2 : (std::is_signed<type_t>::value ? 1 : 0)> kind_t;
+			const uint64_t digit_bits = sizeof(type_t) > 1 ? 11 : 8;
+			const uint64_t buckets = uint64_t(1) << digit_bits;
+			const uint64_t mask = buckets - 1;
+			const uint64_t digits = (sizeof(type_t) * 8 + digit_bits - 1) / digit_bits;
+
+			cc0::array<uint64_t> histograms(digits * buckets);
+			cc0::fill<uint64_t>(histograms, 0);
+			for (uint64_t i = 0; i < count; ++i) {
+				const key_t key = cc0::internal::to_radix_key<key_t>(values[i], kind_t());
+				for (uint64_t d = 0; d < digits; ++d) {
+					++histograms[d * buckets + ((key >> (d * digit_bits)) & mask)];
+				}
+			}
+
+			cc0::array<type_t> scratch(count);
+			type_t *src = values;
+			type_t *dst = scratch;
+			for (uint64_t d = 0; d < digits; ++d) {
+				uint64_t *histogram = histograms + d * buckets;
+				const key_t first = cc0::internal::to_radix_key<key_t>(src[0], kind_t());
+				if (histogram[(first >> (d * digit_bits)) & mask] == count) {
+					continue;
+				}
+				uint64_t offset = 0;
+				for (uint64_t b = 0; b < buckets; ++b) {
+					const uint64_t n = histogram[b];
+					histogram[b] = offset;
+					offset += n;
+				}
+				for (uint64_t i = 0; i < count; ++i) {
+					const key_t key = cc0::internal::to_radix_key<key_t>(src[i], kind_t());
+					dst[histogram[(key >> (d * digit_bits)) & mask]++] = src[i];
+				}
+				std::swap(src, dst);
+			}
+			if (src != values) {
+				memcpy(values, src, count * sizeof(type_t));
+			}
+		}
+
+		/// @brief Sorts elements by insertion sort. Stable.
+		template < typename type_t, typename less_t >
+		void insertion_sort(type_t *begin, type_t *end, less_t &less)
+		{
+			if (begin == end) {
+				return;
+			}
+			for (type_t *cur = begin + 1; cur != end; ++cur) {
+				type_t *sift = cur;
+				type_t *sift_1 = cur - 1;
+				if (less(*sift, *sift_1)) {
+					type_t tmp = std::move(*sift);
+					do {
+						*sift-- = std::move(*sift_1);
+					} while (sift != begin && less(tmp, *--sift_1));
+					*sift = std::move(tmp);
+				}
+			}
+		}
+
+		/// @brief Sorts elements by insertion sort, assuming that the element before the range is not greater than any element in the range.
+		template < typename type_t, typename less_t >
+		void unguarded_insertion_sort(type_t *begin, type_t *end, less_t &less)
+		{
+			if (begin == end) {
+				return;
+			}
+			for (type_t *cur = begin + 1; cur != end; ++cur) {
+				type_t *sift = cur;
+				type_t *sift_1 = cur - 1;
+				if (less(*sift, *sift_1)) {
+					type_t tmp = std::move(*sift);
+					do {
+						*sift-- = std::move(*sift_1);
+					} while (less(tmp, *--sift_1));
+					*sift = std::move(tmp);
+				}
+			}
+		}
+
+		/// @brief Attempts to sort elements by insertion sort, giving up if too many elements need to be moved.
+		/// @return True if the elements were sorted.
+		template < typename type_t, typename less_t >
+		bool partial_insertion_sort(type_t *begin, type_t *end, less_t &less)
+		{
+			if (begin == end) {
+				return true;
+			}
+			uint64_t moves = 0;
+			for (type_t *cur = begin + 1; cur != end; ++cur) {
+				type_t *sift = cur;
+				type_t *sift_1 = cur - 1;
+				if (less(*sift, *sift_1)) {
+					type_t tmp = std::move(*sift);
+					do {
+						*sift-- = std::move(*sift_1);
+					} while (sift != begin && less(tmp, *--sift_1));
+					*sift = std::move(tmp);
+					moves += uint64_t(cur - sift);
+				}
+				if (moves > cc0::internal::partial_insertion_sort_limit) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+		template < typename type_t, typename less_t >
+		void sort2(type_t *a, type_t *b, less_t &less)
+		{
+			if (less(*b, *a)) {
+				std::swap(*a, *b);
+			}
+		}
+
+		template < typename type_t, typename less_t >
+		void sort3(type_t *a, type_t *b, type_t *c, less_t &less)
+		{
+			cc0::internal::sort2(a, b, less);
+			cc0::internal::sort2(b, c, less);
+			cc0::internal::sort2(a, b, less);
+		}
+
+		/// @brief Restores the heap property of the subtree at a given index of a max-heap.
+		template < typename type_t, typename less_t >
+		void sift_down(type_t *heap, uint64_t index, uint64_t count, less_t &less)
+		{
+			type_t tmp = std::move(heap[index]);
+			for (;;) {
+				uint64_t child = index * 2 + 1;
+				if (child >= count) {
+					break;
+				}
+				if (child + 1 < count && less(heap[child], heap[child + 1])) {
+					++child;
+				}
+				if (!less(tmp, heap[child])) {
+					break;
+				}
+				heap[index] = std::move(heap[child]);
+				index = child;
+			}
+			heap[index] = std::move(tmp);
+		}
+
+		/// @brief Sorts elements by heapsort. Used as a fallback that guarantees O(n log n) time when partitioning goes badly.
+		template < typename type_t, typename less_t >
+		void heap_sort(type_t *begin, type_t *end, less_t &less)
+		{
+			const uint64_t count = uint64_t(end - begin);
+			for (uint64_t i = count / 2; i > 0; --i) {
+				cc0::internal::sift_down(begin, i - 1, count, less);
+			}
+			for (uint64_t i = count; i > 1; --i) {
+				std::swap(begin[0], begin[i - 1]);
+				cc0::internal::sift_down(begin, 0, i - 1, less);
+			}
+		}
+
+		/// @brief Partitions elements around the pivot at the beginning of the range, placing elements equal to the pivot to the right of it.
+		/// @return The position of the pivot, and whether the elements were already partitioned.
+		template < typename type_t, typename less_t >
+		std::pair<type_t*,bool> partition_right(type_t *begin, type_t *end, less_t &less)
+		{
+			type_t pivot = std::move(*begin);
+			type_t *first = begin;
+			type_t *last = end;
+
+			// The median-of-three guarantees an element not less than the pivot to the right, and the pivot itself stops the search to the left.
+			while (less(*++first, pivot)) {}
+			if (first - 1 == begin) {
+				while (first < last && !less(*--last, pivot)) {}
+			} else {
+				while (!less(*--last, pivot)) {}
+			}
+
+			const bool already_partitioned = first >= last;
+			while (first < last) {
+				std::swap(*first, *last);
+				while (less(*++first, pivot)) {}
+				while (!less(*--last, pivot)) {}
+			}
+
+			type_t *pivot_pos = first - 1;
+			*begin = std::move(*pivot_pos);
+			*pivot_pos = std::move(pivot);
+			return std::pair<type_t*,bool>(pivot_pos, already_partitioned);
+		}
+
+		/// @brief Partitions elements around the pivot at the beginning of the range, placing elements equal to the pivot to the left of it. Used when the pivot equals the element before the range, in which case all elements equal to the pivot are already in their final position.
+		/// @return The position of the pivot.
+		template < typename type_t, typename less_t >
+		type_t *partition_left(type_t *begin, type_t *end, less_t &less)
+		{
+			type_t pivot = std::move(*begin);
+			type_t *first = begin;
+			type_t *last = end;
+
+			while (less(pivot, *--last)) {}
+			if (last + 1 == end) {
+				while (first < last && !less(pivot, *++first)) {}
+			} else {
+				while (!less(pivot, *++first)) {}
+			}
+
+			while (first < last) {
+				std::swap(*first, *last);
+				while (less(pivot, *--last)) {}
+				while (!less(pivot, *++first)) {}
+			}
+
+			type_t *pivot_pos = last;
+			*begin = std::move(*pivot_pos);
+			*pivot_pos = std::move(pivot);
+			return pivot_pos;
+		}
+
+		/// @brief The main loop of pattern-defeating quicksort (Orson Peters). Recurses into the left partition and loops over the right partition.
+		/// @param bad_allowed The number of highly unbalanced partitions allowed before falling back to heapsort.
+		/// @param leftmost True if the range is the leftmost part of the slice, i.e. there is no element before it to act as a sentinel.
+		template < typename type_t, typename less_t >
+		void pdq_sort(type_t *begin, type_t *end, less_t &less, uint64_t bad_allowed, bool leftmost)
+		{
+			const uint64_t threshold = cc0::internal::insertion_sort_threshold;
+			for (;;) {
+				const uint64_t size = uint64_t(end - begin);
+				if (size < threshold) {
+					if (leftmost) {
+						cc0::internal::insertion_sort(begin, end, less);
+					} else {
+						cc0::internal::unguarded_insertion_sort(begin, end, less);
+					}
+					return;
+				}
+
+				// Move the pivot to the beginning of the range.
+				const uint64_t s2 = size / 2;
+				if (size > cc0::internal::ninther_threshold) {
+					cc0::internal::sort3(begin, begin + s2, end - 1, less);
+					cc0::internal::sort3(begin + 1, begin + (s2 - 1), end - 2, less);
+					cc0::internal::sort3(begin + 2, begin + (s2 + 1), end - 3, less);
+					cc0::internal::sort3(begin + (s2 - 1), begin + s2, begin + (s2 + 1), less);
+					std::swap(*begin, *(begin + s2));
+				} else {
+					cc0::internal::sort3(begin + s2, begin, end - 1, less);
+				}
+
+				// If the pivot equals the element before the range, the range holds many equal elements, which are all put in place by partitioning them to the left.
+				if (!leftmost && !less(*(begin - 1), *begin)) {
+					begin = cc0::internal::partition_left(begin, end, less) + 1;
+					continue;
+				}
+
+				const std::pair<type_t*,bool> part = cc0::internal::partition_right(begin, end, less);
+				type_t *pivot_pos = part.first;
+				const uint64_t l_size = uint64_t(pivot_pos - begin);
+				const uint64_t r_size = uint64_t(end - (pivot_pos + 1));
+
+				if (l_size < size / 8 || r_size < size / 8) {
+					// Fall back to heapsort if partitioning keeps going badly, and otherwise shuffle elements to break up patterns that cause bad partitions.
+					if (--bad_allowed == 0) {
+						cc0::internal::heap_sort(begin, end, less);
+						return;
+					}
+					if (l_size >= threshold) {
+						std::swap(begin[0], begin[l_size / 4]);
+						std::swap(pivot_pos[-1], pivot_pos[-int64_t(l_size / 4)]);
+						if (l_size > cc0::internal::ninther_threshold) {
+							std::swap(begin[1], begin[l_size / 4 + 1]);
+							std::swap(begin[2], begin[l_size / 4 + 2]);
+							std::swap(pivot_pos[-2], pivot_pos[-int64_t(l_size / 4 + 1)]);
+							std::swap(pivot_pos[-3], pivot_pos[-int64_t(l_size / 4 + 2)]);
+						}
+					}
+					if (r_size >= threshold) {
+						std::swap(pivot_pos[1], pivot_pos[1 + r_size / 4]);
+						std::swap(end[-1], end[-int64_t(r_size / 4)]);
+						if (r_size > cc0::internal::ninther_threshold) {
+							std::swap(pivot_pos[2], pivot_pos[2 + r_size / 4]);
+							std::swap(pivot_pos[3], pivot_pos[3 + r_size / 4]);
+							std::swap(end[-2], end[-int64_t(1 + r_size / 4)]);
+							std::swap(end[-3], end[-int64_t(2 + r_size / 4)]);
+						}
+					}
+				} else if (part.second && cc0::internal::partial_insertion_sort(begin, pivot_pos, less) && cc0::internal::partial_insertion_sort(pivot_pos + 1, end, less)) {
+					// The partitions were already in order, so the range is likely sorted.
+					return;
+				}
+
+				cc0::internal::pdq_sort(begin, pivot_pos, less, bad_allowed, leftmost);
+				begin = pivot_pos + 1;
+				leftmost = false;
+			}
+		}
+
+		/// @brief Sorts elements by pattern-defeating quicksort.
+		template < typename type_t, typename less_t >
+		void pdq_sort(type_t *values, uint64_t count, less_t &less)
+		{
+			uint64_t log2 = 1;
+			while ((count >> log2) > 0) {
+				++log2;
+			}
+			cc0::internal::pdq_sort(values, values + count, less, log2, true);
+		}
+
+		/// @brief Sorts elements by top-down merge sort, merging through a buffer holding the left half. Stable.
+		/// @param buffer Uninitialized memory for count / 2 elements.
+		template < typename type_t, typename less_t >
+		void merge_sort(type_t *values, uint64_t count, type_t *buffer, less_t &less)
+		{
+			if (count <= cc0::internal::insertion_sort_threshold) {
+				cc0::internal::insertion_sort(values, values + count, less);
+				return;
+			}
+			const uint64_t half = count / 2;
+			cc0::internal::merge_sort(values, half, buffer, less);
+			cc0::internal::merge_sort(values + half, count - half, buffer, less);
+			if (!less(values[half], values[half - 1])) {
+				return;
+			}
+			cc0::internal::move_construct(buffer, values, half);
+			uint64_t i = 0, j = half, k = 0;
+			while (i < half && j < count) {
+				if (less(values[j], buffer[i])) {
+					values[k++] = std::move(values[j++]);
+				} else {
+					values[k++] = std::move(buffer[i++]);
+				}
+			}
+			while (i < half) {
+				values[k++] = std::move(buffer[i++]);
+			}
+			cc0::internal::destruct(buffer, half);
+		}
+
+		/// @brief Sorts elements by merge sort, allocating the buffer from the default allocator.
+		template < typename type_t, typename less_t >
+		void merge_sort(type_t *values, uint64_t count, less_t &less)
+		{
+			if (count <= cc0::internal::insertion_sort_threshold) {
+				cc0::internal::insertion_sort(values, values + count, less);
+				return;
+			}
+			const uint64_t bytes = (count / 2) * sizeof(type_t);
+			cc0::allocator *allocator = cc0::default_allocator();
+			type_t *buffer = static_cast<type_t*>(cc0::internal::allocate(allocator, bytes, alignof(type_t)));
+			cc0::internal::merge_sort(values, count, buffer, less);
+			cc0::internal::deallocate(allocator, buffer, bytes, alignof(type_t));
+		}
+
+		template < typename type_t >
+		void sort(type_t *values, uint64_t count, std::true_type)
+		{
+			if (count < cc0::internal::radix_sort_threshold) {
+				cc0::internal::radix_less<typename std::remove_cv<type_t>::type> less;
+				cc0::internal::pdq_sort(values, count, less);
+			} else {
+				cc0::internal::radix_sort(values, count);
+			}
+		}
+
+		template < typename type_t >
+		void sort(type_t *values, uint64_t count, std::false_type)
+		{
+			cc0::internal::less_op less;
+			cc0::internal::pdq_sort(values, count, less);
+		}
+
+		template < typename type_t >
+		void stable_sort(type_t *values, uint64_t count, std::true_type)
+		{
+			if (count < cc0::internal::radix_sort_threshold) {
+				cc0::internal::radix_less<typename std::remove_cv<type_t>::type> less;
+				cc0::internal::insertion_sort(values, values + count, less);
+			} else {
+				cc0::internal::radix_sort(values, count);
+			}
+		}
+
+		template < typename type_t >
+		void stable_sort(type_t *values, uint64_t count, std::false_type)
+		{
+			cc0::internal::less_op less;
+			cc0::internal::merge_sort(values, count, less);
+		}
+
+		/// @brief Writes the subtree at index k (1-based) of an Eytzinger layout by an in-order traversal of the sorted elements.
+		/// @return The index of the next sorted element.
+		template < typename type_t, typename type2_t >
+		uint64_t eytzinger(type_t *dst, const type2_t *sorted, uint64_t count, uint64_t i, uint64_t k)
+		{
+			if (k <= count) {
+				i = cc0::internal::eytzinger(dst, sorted, count, i, 2 * k);
+				dst[k - 1] = sorted[i++];
+				i = cc0::internal::eytzinger(dst, sorted, count, i, 2 * k + 1);
+			}
+			return i;
+		}
+	}
+}
+
+template < typename type_t >
+void cc0::sort(cc0::slice<type_t> arr)
+{
+	cc0::internal::sort(static_cast<type_t*>(arr), arr.size(), cc0::internal::is_radix_sortable<type_t>());
+}
+
+template < typename type_t, typename less_t >
+void cc0::sort(cc0::slice<type_t> arr, less_t less)
+{
+	cc0::internal::pdq_sort(static_cast<type_t*>(arr), arr.size(), less);
+}
+
+template < typename type_t >
+void cc0::stable_sort(cc0::slice<type_t> arr)
+{
+	cc0::internal::stable_sort(static_cast<type_t*>(arr), arr.size(), cc0::internal::is_radix_sortable<type_t>());
+}
+
+template < typename type_t, typename less_t >
+void cc0::stable_sort(cc0::slice<type_t> arr, less_t less)
+{
+	cc0::internal::merge_sort(static_cast<type_t*>(arr), arr.size(), less);
+}
+
+template < typename type_t >
+uint64_t cc0::lower_bound(cc0::slice<type_t> arr, const typename std::remove_cv<type_t>::type &value)
+{
+	return cc0::lower_bound(arr, value, cc0::internal::less_op());
+}
+
+template < typename type_t, typename value_t, typename less_t >
+uint64_t cc0::lower_bound(cc0::slice<type_t> arr, const value_t &value, less_t less)
+{
+	uint64_t count = arr.size();
+	if (count == 0) {
+		return 0;
+	}
+	const type_t *first = arr;
+	const type_t *base = first;
+	while (count > 1) {
+		const uint64_t half = count / 2;
+		base = less(base[half], value) ? base + half : base;
+		count -= half;
+	}
+	return uint64_t(base - first) + (less(*base, value) ? 1 : 0);
+}
+
+template < typename type_t >
+uint64_t cc0::upper_bound(cc0::slice<type_t> arr, const typename std::remove_cv<type_t>::type &value)
+{
+	return cc0::upper_bound(arr, value, cc0::internal::less_op());
+}
+
+template < typename type_t, typename value_t, typename less_t >
+uint64_t cc0::upper_bound(cc0::slice<type_t> arr, const value_t &value, less_t less)
+{
+	uint64_t count = arr.size();
+	if (count == 0) {
+		return 0;
+	}
+	const type_t *first = arr;
+	const type_t *base = first;
+	while (count > 1) {
+		const uint64_t half = count / 2;
+		base = less(value, base[half]) ? base : base + half;
+		count -= half;
+	}
+	return uint64_t(base - first) + (less(value, *base) ? 0 : 1);
+}
+
+template < typename type_t >
+bool cc0::binary_search(cc0::slice<type_t> arr, const typename std::remove_cv<type_t>::type &value)
+{
+	return cc0::binary_search(arr, value, cc0::internal::less_op());
+}
+
+template < typename type_t, typename value_t, typename less_t >
+bool cc0::binary_search(cc0::slice<type_t> arr, const value_t &value, less_t less)
+{
+	const uint64_t i = cc0::lower_bound(arr, value, less);
+	return i < arr.size() && !less(value, static_cast<const type_t*>(arr)[i]);
+}
+
+template < typename type_t, typename type2_t >
+void cc0::eytzinger(cc0::slice<type_t> dst, cc0::slice<type2_t> sorted)
+{
+	CC0_ARR_ASSERT(dst.size() == sorted.size());
+	cc0::internal::eytzinger(static_cast<type_t*>(dst), static_cast<const type2_t*>(sorted), sorted.size(), 0, 1);
+}
+
+template < typename type_t >
+uint64_t cc0::eytzinger_lower_bound(cc0::slice<type_t> layout, const typename std::remove_cv<type_t>::type &value)
+{
+	return cc0::eytzinger_lower_bound(layout, value, cc0::internal::less_op());
+}
+
+template < typename type_t, typename value_t, typename less_t >
+uint64_t cc0::eytzinger_lower_bound(cc0::slice<type_t> layout, const value_t &value, less_t less)
+{
+	const type_t *values = layout;
+	const uint64_t count = layout.size();
+	// The descendants four levels down are contiguous, and span a cache line for elements of up to four bytes.
+	const uint64_t prefetch_stride = 16;
+	uint64_t k = 1;
+	while (k <= count) {
+#if defined(__GNUC__)
+		__builtin_prefetch(reinterpret_cast<const void*>(reinterpret_cast<uintptr_t>(values) + (prefetch_stride * k - 1) * sizeof(type_t)));
+#endif
+		k = 2 * k + (less(values[k - 1], value) ? 1 : 0);
+	}
+	// The path went right after the last left turn until falling off the tree, so the result is where the last left turn was taken.
+#if defined(__GNUC__)
+	k >>= __builtin_ctzll(~k) + 1;
+#else
+	while ((k & 1) != 0) {
+		k >>= 1;
+	}
+	k >>= 1;
+#endif
+	return k > 0 ? k - 1 : count;
+}
+
+#endif
@@ -0,0 +1,900 @@
+/// @file
+/// @author github.com/SirJonthe
+/// @date 2023
+/// @copyright Public domain.
+/// @license CC0 1.0
+
+#ifndef CC0_ARR_SPARSE_H_INCLUDED__
+#define CC0_ARR_SPARSE_H_INCLUDED__
+
+#include "arr.h"
+
+namespace cc0
+{
+	/// @brief A sparse array, storing only its non-zero elements as a column of sorted indices and a column of values. Elements that are not stored are zero, i.e. value-initialized. Memory and the work of bulk operations scale with the number of stored elements rather than with the size of the array.
+	/// @tparam type_t The type of the array. Must be value-initializable to zero and comparable for equality, e.g. an arithmetic type.
+	template < typename type_t >
+	class sparse_array
+	{
+	private:
+		cc0::array<uint64_t> m_indices;
+		cc0::array<type_t>   m_values;
+		uint64_t             m_size;
+
+	private:
+		/// @brief Finds where an element is, or would be, stored.
+		/// @param index The index of the element.
+		/// @return The position of the first stored element with an index no less than the given index.
+		uint64_t lower_bound(uint64_t index) const;
+
+	public:
+		/// @brief Creates an array where all elements are zero.
+		/// @param size The number of elements in the array.
+		/// @param allocator The allocator to allocate the columns with. Null selects the default allocator.
+		explicit sparse_array(uint64_t size = 0, cc0::allocator *allocator = nullptr);
+
+		/// @brief Creates an array from the non-zero elements of a dense slice.
+		/// @tparam type2_t The type of the slice.
+		/// @param dense The slice.
+		/// @param allocator The allocator to allocate the columns with. Null selects the default allocator.
+		template < typename type2_t >
+		explicit sparse_array(cc0::slice<type2_t> dense, cc0::allocator *allocator = nullptr);
+
+		/// @brief Sets the size of the array, and sets all elements to zero. Memory is kept for reuse.
+		/// @param size The number of elements in the array.
+		void create(uint64_t size);
+
+		/// @brief Frees allocated memory and sets the array size to 0.
+		void destroy( void );
+
+		/// @brief Ensures that the array can store a given number of non-zero elements without allocating new memory.
+		/// @param count The number of non-zero elements.
+		void reserve(uint64_t count);
+
+		/// @brief Stores an element after all stored elements, which is the fastest way to build an array.
+		/// @param index The index of the element. Must be greater than the indices of all stored elements, and less than the size of the array.
+		/// @param value The value of the element.
+		void push_back(uint64_t index, const type_t &value);
+
+		/// @brief Sets the value of an element. Storing a new element among existing ones moves all stored elements after it.
+		/// @param index The index of the element. Must be less than the size of the array.
+		/// @param value The value of the element. Setting an element that is not stored to zero stores nothing.
+		void set(uint64_t index, const type_t &value);
+
+		/// @brief Gets the value of an element.
+		/// @param index The index of the element. Must be less than the size of the array.
+		/// @return The value of the element, or zero if it is not stored.
+		type_t get(uint64_t index) const;
+
+		/// @brief Removes stored elements that are zero.
+		void prune( void );
+
+		/// @brief Sets the array to the non-zero elements of a dense slice.
+		/// @tparam type2_t The type of the slice.
+		/// @param dense The slice. The size of the array is set to the size of the slice.
+		template < typename type2_t >
+		void from_dense(cc0::slice<type2_t> dense);
+
+		/// @brief Writes all elements of the array, including zeros, to a dense slice.
+		/// @tparam type2_t The type of the slice.
+		/// @param dense The slice. Must be no smaller than the array.
+		template < typename type2_t >
+		void to_dense(cc0::slice<type2_t> dense) const;
+
+		/// @brief Writes all elements of the array, including zeros, to a dense array.
+		/// @tparam align_u The alignment of the array.
+		/// @param dense The array. Its size is set to the size of the sparse array.
+		template < uint64_t align_u >
+		void to_dense(cc0::array<type_t,0,align_u> &dense) const;
+
+		/// @brief Provides a view of the indices of stored elements, in ascending order.
+		/// @return The indices.
+		cc0::slice<const uint64_t> indices( void ) const;
+
+		/// @brief Provides a view of the values of stored elements, in the order of their indices.
+		/// @return The values.
+		cc0::slice<type_t> values( void );
+
+		/// @brief Provides a view of the values of stored elements, in the order of their indices.
+		/// @return The values.
+		cc0::slice<const type_t> values( void ) const;
+
+		/// @brief Gets the allocator used to allocate the columns.
+		/// @return The allocator.
+		cc0::allocator *get_allocator( void ) const;
+
+		/// @brief Gets the number of stored elements.
+		/// @return The number of stored elements.
+		uint64_t count( void ) const;
+
+		/// @brief Gets the size of the array.
+		/// @return The number of elements in the array, including zeros.
+		uint64_t size( void ) const;
+	};
+
+	/// @brief A block-sparse array, storing its elements in fixed-size blocks of which only blocks containing non-zero elements are stored. Suited to data where non-zero elements are clustered, as bulk operations work on contiguous blocks and only one index is stored per block. Elements that are not stored are zero, i.e. value-initialized.
+	/// @tparam type_t The type of the array. Must be value-initializable to zero and comparable for equality, e.g. an arithmetic type.
+	/// @tparam block_size_u The number of elements in a block.
+	template < typename type_t, uint64_t block_size_u = 16 >
+	class block_sparse_array
+	{
+		static_assert(block_size_u > 0, "block_size_u must not be zero");
+
+	public:
+		/// @brief The number of elements in a block.
+		static constexpr uint64_t block_size = block_size_u;
+
+	private:
+		cc0::array<uint64_t> m_blocks;
+		cc0::array<type_t>   m_values;
+		uint64_t             m_size;
+
+	private:
+		/// @brief Finds where a block is, or would be, stored.
+		/// @param block The number of the block, i.e. the index of its first element divided by the block size.
+		/// @return The position of the first stored block with a number no less than the given number.
+		uint64_t lower_bound(uint64_t block) const;
+
+		/// @brief Stores a block of zeros.
+		/// @param at The position to store the block at.
+		/// @param block The number of the block.
+		void insert(uint64_t at, uint64_t block);
+
+	public:
+		/// @brief Creates an array where all elements are zero.
+		/// @param size The number of elements in the array.
+		/// @param allocator The allocator to allocate the columns with. Null selects the default allocator.
+		explicit block_sparse_array(uint64_t size = 0, cc0::allocator *allocator = nullptr);
+
+		/// @brief Creates an array from the blocks of a dense slice that contain non-zero elements.
+		/// @tparam type2_t The type of the slice.
+		/// @param dense The slice.
+		/// @param allocator The allocator to allocate the columns with. Null selects the default allocator.
+		template < typename type2_t >
+		explicit block_sparse_array(cc0::slice<type2_t> dense, cc0::allocator *allocator = nullptr);
+
+		/// @brief Sets the size of the array, and sets all elements to zero. Memory is kept for reuse.
+		/// @param size The number of elements in the array.
+		void create(uint64_t size);
+
+		/// @brief Frees allocated memory and sets the array size to 0.
+		void destroy( void );
+
+		/// @brief Ensures that the array can store a given number of blocks without allocating new memory.
+		/// @param count The number of blocks.
+		void reserve(uint64_t count);
+
+		/// @brief Sets the value of an element. Storing a new block among existing ones moves all stored blocks after it.
+		/// @param index The index of the element. Must be less than the size of the array.
+		/// @param value The value of the element. Setting an element in a block that is not stored to zero stores nothing.
+		void set(uint64_t index, const type_t &value);
+
+		/// @brief Gets the value of an element.
+		/// @param index The index of the element. Must be less than the size of the array.
+		/// @return The value of the element, or zero if its block is not stored.
+		type_t get(uint64_t index) const;
+
+		/// @brief Removes stored blocks that only contain zeros.
+		void prune( void );
+
+		/// @brief Sets the array to the blocks of a dense slice that contain non-zero elements.
+		/// @tparam type2_t The type of the slice.
+		/// @param dense The slice. The size of the array is set to the size of the slice.
+		template < typename type2_t >
+		void from_dense(cc0::slice<type2_t> dense);
+
+		/// @brief Writes all elements of the array, including zeros, to a dense slice.
+		/// @tparam type2_t The type of the slice.
+		/// @param dense The slice. Must be no smaller than the array.
+		template < typename type2_t >
+		void to_dense(cc0::slice<type2_t> dense) const;
+
+		/// @brief Writes all elements of the array, including zeros, to a dense array.
+		/// @tparam align_u The alignment of the array.
+		/// @param dense The array. Its size is set to the size of the sparse array.
+		template < uint64_t align_u >
+		void to_dense(cc0::array<type_t,0,align_u> &dense) const;
+
+		/// @brief Provides a view of the numbers of stored blocks, i.e. the indices of their first elements divided by the block size, in ascending order.
+		/// @return The block numbers.
+		cc0::slice<const uint64_t> blocks( void ) const;
+
+		/// @brief Provides a view of the elements of a stored block.
+		/// @param i The position of the block among stored blocks.
+		/// @return The elements. Elements of the last block beyond the size of the array are zero.
+		cc0::slice<type_t> block(uint64_t i);
+
+		/// @brief Provides a view of the elements of a stored block.
+		/// @param i The position of the block among stored blocks.
+		/// @return The elements. Elements of the last block beyond the size of the array are zero.
+		cc0::slice<const type_t> block(uint64_t i) const;
+
+		/// @brief Gets the allocator used to allocate the columns.
+		/// @return The allocator.
+		cc0::allocator *get_allocator( void ) const;
+
+		/// @brief Gets the number of stored blocks.
+		/// @return The number of stored blocks.
+		uint64_t block_count( void ) const;
+
+		/// @brief Gets the size of the array.
+		/// @return The number of elements in the array, including zeros.
+		uint64_t size( void ) const;
+	};
+
+	/// @brief Computes the dot product of a sparse array and a dense slice, only visiting stored elements.
+	/// @tparam type_t The type of the sparse array.
+	/// @tparam type2_t The type of the slice.
+	/// @param a The sparse array.
+	/// @param b The slice. Must be no smaller than the sparse array.
+	/// @return The sum of the element-wise products.
+	template < typename type_t, typename type2_t >
+	type_t dot(const cc0::sparse_array<type_t> &a, cc0::slice<type2_t> b);
+
+	/// @brief Computes the dot product of a block-sparse array and a dense slice, only visiting stored blocks.
+	/// @tparam type_t The type of the sparse array.
+	/// @tparam block_size_u The number of elements in a block.
+	/// @tparam type2_t The type of the slice.
+	/// @param a The block-sparse array.
+	/// @param b The slice. Must be no smaller than the sparse array.
+	/// @return The sum of the element-wise products.
+	template < typename type_t, uint64_t block_size_u, typename type2_t >
+	type_t dot(const cc0::block_sparse_array<type_t,block_size_u> &a, cc0::slice<type2_t> b);
+
+	/// @brief Adds a scaled sparse array to a dense slice, i.e. y += alpha * x, only visiting stored elements.
+	/// @tparam type_t The type of the sparse array.
+	/// @tparam type2_t The type of the slice.
+	/// @param alpha The scale.
+	/// @param x The sparse array.
+	/// @param y The slice. Must be no smaller than the sparse array.
+	template < typename type_t, typename type2_t >
+	void axpy(const type_t &alpha, const cc0::sparse_array<type_t> &x, cc0::slice<type2_t> y);
+
+	/// @brief Adds a scaled block-sparse array to a dense slice, i.e. y += alpha * x, only visiting stored blocks.
+	/// @tparam type_t The type of the sparse array.
+	/// @tparam block_size_u The number of elements in a block.
+	/// @tparam type2_t The type of the slice.
+	/// @param alpha The scale.
+	/// @param x The block-sparse array.
+	/// @param y The slice. Must be no smaller than the sparse array.
+	template < typename type_t, uint64_t block_size_u, typename type2_t >
+	void axpy(const type_t &alpha, const cc0::block_sparse_array<type_t,block_size_u> &x, cc0::slice<type2_t> y);
+
+	/// @brief Adds two sparse arrays element-wise by merging their stored elements.
+	/// @tparam type_t The type of the arrays.
+	/// @param a The first array.
+	/// @param b The second array. Must be of the same size as the first.
+	/// @return The sum, storing the non-zero elements stored by either array.
+	template < typename type_t >
+	cc0::sparse_array<type_t> operator+(const cc0::sparse_array<type_t> &a, const cc0::sparse_array<type_t> &b);
+
+	/// @brief Subtracts two sparse arrays element-wise by merging their stored elements.
+	/// @tparam type_t The type of the arrays.
+	/// @param a The first array.
+	/// @param b The second array. Must be of the same size as the first.
+	/// @return The difference, storing the non-zero elements stored by either array.
+	template < typename type_t >
+	cc0::sparse_array<type_t> operator-(const cc0::sparse_array<type_t> &a, const cc0::sparse_array<type_t> &b);
+
+	/// @brief Multiplies two sparse arrays element-wise by merging their stored elements.
+	/// @tparam type_t The type of the arrays.
+	/// @param a The first array.
+	/// @param b The second array. Must be of the same size as the first.
+	/// @return The product, storing the non-zero elements stored by both arrays.
+	template < typename type_t >
+	cc0::sparse_array<type_t> operator*(const cc0::sparse_array<type_t> &a, const cc0::sparse_array<type_t> &b);
+
+	/// @brief Adds two block-sparse arrays element-wise by merging their stored blocks.
+	/// @tparam type_t The type of the arrays.
+	/// @tparam block_size_u The number of elements in a block.
+	/// @param a The first array.
+	/// @param b The second array. Must be of the same size as the first.
+	/// @return The sum, storing the non-zero blocks stored by either array.
+	template < typename type_t, uint64_t block_size_u >
+	cc0::block_sparse_array<type_t,block_size_u> operator+(const cc0::block_sparse_array<type_t,block_size_u> &a, const cc0::block_sparse_array<type_t,block_size_u> &b);
+
+	/// @brief Subtracts two block-sparse arrays element-wise by merging their stored blocks.
+	/// @tparam type_t The type of the arrays.
+	/// @tparam block_size_u The number of elements in a block.
+	/// @param a The first array.
+	/// @param b The second array. Must be of the same size as the first.
+	/// @return The difference, storing the non-zero blocks stored by either array.
+	template < typename type_t, uint64_t block_size_u >
+	cc0::block_sparse_array<type_t,block_size_u> operator-(const cc0::block_sparse_array<type_t,block_size_u> &a, const cc0::block_sparse_array<type_t,block_size_u> &b);
+
+	/// @brief Multiplies two block-sparse arrays element-wise by merging their stored blocks.
+	/// @tparam type_t The type of the arrays.
+	/// @tparam block_size_u The number of elements in a block.
+	/// @param a The first array.
+	/// @param b The second array. Must be of the same size as the first.
+	/// @return The product, storing the non-zero blocks stored by both arrays.
+	template < typename type_t, uint64_t block_size_u >
+	cc0::block_sparse_array<type_t,block_size_u> operator*(const cc0::block_sparse_array<type_t,block_size_u> &a, const cc0::block_sparse_array<type_t,block_size_u> &b);
+
+	namespace internal
+	{
+		template < typename type_t >
+		bool is_zero(const type_t &value)
+		{
+			return value == type_t();
+		}
+
+		struct sparse_add
+		{
+			static constexpr bool intersect = false;
+			template < typename type_t >
+			static type_t apply(const type_t &a, const type_t &b) { return a + b; }
+		};
+
+		struct sparse_sub
+		{
+			static constexpr bool intersect = false;
+			template < typename type_t >
+			static type_t apply(const type_t &a, const type_t &b) { return a - b; }
+		};
+
+		struct sparse_mul
+		{
+			static constexpr bool intersect = true;
+			template < typename type_t >
+			static type_t apply(const type_t &a, const type_t &b) { return a * b; }
+		};
+
+		/// @brief Combines the stored elements of two sparse arrays element-wise, in a single pass over both in index order.
+		/// @tparam op_t The operation. Elements stored by only one array are combined with zero, unless the operation only applies where both arrays store elements.
+		/// @tparam type_t The type of the arrays.
+		/// @param a The first array.
+		/// @param b The second array.
+		/// @return The result, storing only non-zero elements.
+		template < typename op_t, typename type_t >
+		cc0::sparse_array<type_t> merge(const cc0::sparse_array<type_t> &a, const cc0::sparse_array<type_t> &b)
+		{
+			CC0_ARR_ASSERT(a.size() == b.size());
+			cc0::sparse_array<type_t> out(a.size(), a.get_allocator());
+			out.reserve(op_t::intersect ? (a.count() < b.count() ? a.count() : b.count()) : a.count() + b.count());
+			const cc0::slice<const uint64_t> ai = a.indices(), bi = b.indices();
+			const cc0::slice<const type_t> av = a.values(), bv = b.values();
+			const type_t zero = type_t();
+			auto emit = [&out](uint64_t index, const type_t &value) {
+				if (!cc0::internal::is_zero(value)) {
+					out.push_back(index, value);
+				}
+			};
+			uint64_t i = 0, j = 0;
+			while (i < ai.size() && j < bi.size()) {
+				if (ai[i] == bi[j]) {
+					emit(ai[i], op_t::apply(av[i], bv[j]));
+					++i;
+					++j;
+				} else if (ai[i] < bi[j]) {
+					if (!op_t::intersect) {
+						emit(ai[i], op_t::apply(av[i], zero));
+					}
+					++i;
+				} else {
+					if (!op_t::intersect) {
+						emit(bi[j], op_t::apply(zero, bv[j]));
+					}
+					++j;
+				}
+			}
+			for (; !op_t::intersect && i < ai.size(); ++i) {
+				emit(ai[i], op_t::apply(av[i], zero));
+			}
+			for (; !op_t::intersect && j < bi.size(); ++j) {
+				emit(bi[j], op_t::apply(zero, bv[j]));
+			}
+			return out;
+		}
+
+		/// @brief Combines the stored blocks of two block-sparse arrays element-wise, in a single pass over both in block order.
+		/// @tparam op_t The operation. Blocks stored by only one array are combined with zero, unless the operation only applies where both arrays store blocks.
+		/// @tparam type_t The type of the arrays.
+		/// @tparam block_size_u The number of elements in a block.
+		/// @param a The first array.
+		/// @param b The second array.
+		/// @return The result, storing only non-zero blocks.
+		template < typename op_t, typename type_t, uint64_t block_size_u >
+		cc0::block_sparse_array<type_t,block_size_u> merge(const cc0::block_sparse_array<type_t,block_size_u> &a, const cc0::block_sparse_array<type_t,block_size_u> &b)
+		{
+			CC0_ARR_ASSERT(a.size() == b.size());
+			cc0::block_sparse_array<type_t,block_size_u> out(a.size(), a.get_allocator());
+			out.reserve(op_t::intersect ? (a.block_count() < b.block_count() ? a.block_count() : b.block_count()) : a.block_count() + b.block_count());
+			const cc0::slice<const uint64_t> ab = a.blocks(), bb = b.blocks();
+			const type_t zero = type_t();
+			uint64_t i = 0, j = 0;
+			while (i < ab.size() || j < bb.size()) {
+				const bool in_a = i < ab.size() && (j >= bb.size() || ab[i] <= bb[j]);
+				const bool in_b = j < bb.size() && (i >= ab.size() || bb[j] <= ab[i]);
+				const uint64_t block = in_a ? ab[i] : bb[j];
+				if (!op_t::intersect || (in_a && in_b)) {
+					const cc0::slice<const type_t> x = in_a ? a.block(i) : cc0::slice<const type_t>();
+					const cc0::slice<const type_t> y = in_b ? b.block(j) : cc0::slice<const type_t>();
+					// Blocks are visited in order, so setting elements appends blocks, and blocks of zeros are never stored.
+					const uint64_t start = block * block_size_u;
+					for (uint64_t k = 0; k < block_size_u && start + k < a.size(); ++k) {
+						const type_t value = op_t::apply(in_a ? x[k] : zero, in_b ? y[k] : zero);
+						if (!cc0::internal::is_zero(value)) {
+							out.set(start + k, value);
+						}
+					}
+				}
+				i += in_a ? 1 : 0;
+				j += in_b ? 1 : 0;
+			}
+			return out;
+		}
+	}
+}
+
+template < typename type_t >
+uint64_t cc0::sparse_array<type_t>::lower_bound(uint64_t index) const
+{
+	uint64_t lo = 0, hi = m_indices.size();
+	while (lo < hi) {
+		const uint64_t mid = lo + (hi - lo) / 2;
+		if (m_indices[mid] < index) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+	return lo;
+}
+
+template < typename type_t >
+cc0::sparse_array<type_t>::sparse_array(uint64_t size, cc0::allocator *allocator) : m_indices(allocator), m_values(allocator), m_size(size)
+{}
+
+template < typename type_t >
+template < typename type2_t >
+cc0::sparse_array<type_t>::sparse_array(cc0::slice<type2_t> dense, cc0::allocator *allocator) : m_indices(allocator), m_values(allocator), m_size(0)
+{
+	from_dense(dense);
+}
+
+template < typename type_t >
+void cc0::sparse_array<type_t>::create(uint64_t size)
+{
+	m_indices.resize(0);
+	m_values.resize(0);
+	m_size = size;
+}
+
+template < typename type_t >
+void cc0::sparse_array<type_t>::destroy( void )
+{
+	m_indices.destroy(false);
+	m_values.destroy(false);
+	m_size = 0;
+}
+
+template < typename type_t >
+void cc0::sparse_array<type_t>::reserve(uint64_t count)
+{
+	m_indices.reserve(count);
+	m_values.reserve(count);
+}
+
+template < typename type_t >
+void cc0::sparse_array<type_t>::push_back(uint64_t index, const type_t &value)
+{
+	CC0_ARR_ASSERT(index < m_size);
+	CC0_ARR_ASSERT(m_indices.size() == 0 || m_indices[m_indices.size() - 1] < index);
+	m_indices.push_back(index);
+	m_values.push_back(value);
+}
+
+template < typename type_t >
+void cc0::sparse_array<type_t>::set(uint64_t index, const type_t &value)
+{
+	CC0_ARR_ASSERT(index < m_size);
+	const uint64_t at = lower_bound(index);
+	if (at < m_indices.size() && m_indices[at] == index) {
+		m_values[at] = value;
+		return;
+	}
+	if (cc0::internal::is_zero(value)) {
+		return;
+	}
+	const uint64_t count = m_indices.size();
+	m_indices.resize(count + 1);
+	m_values.resize(count + 1);
+	for (uint64_t i = count; i > at; --i) {
+		m_indices[i] = m_indices[i - 1];
+		m_values[i] = std::move(m_values[i - 1]);
+	}
+	m_indices[at] = index;
+	m_values[at] = value;
+}
+
+template < typename type_t >
+type_t cc0::sparse_array<type_t>::get(uint64_t index) const
+{
+	CC0_ARR_ASSERT(index < m_size);
+	const uint64_t at = lower_bound(index);
+	return at < m_indices.size() && m_indices[at] == index ? m_values[at] : type_t();
+}
+
+template < typename type_t >
+void cc0::sparse_array<type_t>::prune( void )
+{
+	uint64_t count = 0;
+	for (uint64_t i = 0; i < m_indices.size(); ++i) {
+		if (!cc0::internal::is_zero(m_values[i])) {
+			if (count != i) {
+				m_indices[count] = m_indices[i];
+				m_values[count] = std::move(m_values[i]);
+			}
+			++count;
+		}
+	}
+	m_indices.resize(count);
+	m_values.resize(count);
+}
+
+template < typename type_t >
+template < typename type2_t >
+void cc0::sparse_array<type_t>::from_dense(cc0::slice<type2_t> dense)
+{
+	create(dense.size());
+	for (uint64_t i = 0; i < dense.size(); ++i) {
+		if (!cc0::internal::is_zero(dense[i])) {
+			m_indices.push_back(i);
+			m_values.push_back(dense[i]);
+		}
+	}
+}
+
+template < typename type_t >
+template < typename type2_t >
+void cc0::sparse_array<type_t>::to_dense(cc0::slice<type2_t> dense) const
+{
+	CC0_ARR_ASSERT(dense.size() >= m_size);
+	typedef typename std::remove_cv<type2_t>::type value_t;
+	cc0::fill<type2_t>(dense(0, m_size), value_t());
+	for (uint64_t i = 0; i < m_indices.size(); ++i) {
+		dense[m_indices[i]] = m_values[i];
+	}
+}
+
+template < typename type_t >
+template < uint64_t align_u >
+void cc0::sparse_array<type_t>::to_dense(cc0::array<type_t,0,align_u> &dense) const
+{
+	dense.create(m_size);
+	to_dense(dense(0, m_size));
+}
+
+template < typename type_t >
+cc0::slice<const uint64_t> cc0::sparse_array<type_t>::indices( void ) const
+{
+	return m_indices(0, m_indices.size());
+}
+
+template < typename type_t >
+cc0::slice<type_t> cc0::sparse_array<type_t>::values( void )
+{
+	return m_values(0, m_values.size());
+}
+
+template < typename type_t >
+cc0::slice<const type_t> cc0::sparse_array<type_t>::values( void ) const
+{
+	return m_values(0, m_values.size());
+}
+
+template < typename type_t >
+cc0::allocator *cc0::sparse_array<type_t>::get_allocator( void ) const
+{
+	return m_values.get_allocator();
+}
+
+template < typename type_t >
+uint64_t cc0::sparse_array<type_t>::count( void ) const
+{
+	return m_indices.size();
+}
+
+template < typename type_t >
+uint64_t cc0::sparse_array<type_t>::size( void ) const
+{
+	return m_size;
+}
+
+template < typename type_t, uint64_t block_size_u >
+uint64_t cc0::block_sparse_array<type_t,block_size_u>::lower_bound(uint64_t block) const
+{
+	uint64_t lo = 0, hi = m_blocks.size();
+	while (lo < hi) {
+		const uint64_t mid = lo + (hi - lo) / 2;
+		if (m_blocks[mid] < block) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+	return lo;
+}
+
+template < typename type_t, uint64_t block_size_u >
+void cc0::block_sparse_array<type_t,block_size_u>::insert(uint64_t at, uint64_t block)
+{
+	const uint64_t count = m_blocks.size();
+	m_blocks.resize(count + 1);
+	m_values.resize((count + 1) * block_size_u);
+	for (uint64_t i = count; i > at; --i) {
+		m_blocks[i] = m_blocks[i - 1];
+	}
+	for (uint64_t i = count * block_size_u; i > at * block_size_u; --i) {
+		m_values[i + block_size_u - 1] = std::move(m_values[i - 1]);
+	}
+	m_blocks[at] = block;
+	cc0::fill<type_t>(m_values(at * block_size_u, (at + 1) * block_size_u), type_t());
+}
+
+template < typename type_t, uint64_t block_size_u >
+cc0::block_sparse_array<type_t,block_size_u>::block_sparse_array(uint64_t size, cc0::allocator *allocator) : m_blocks(allocator), m_values(allocator), m_size(size)
+{}
+
+template < typename type_t, uint64_t block_size_u >
+template < typename type2_t >
+cc0::block_sparse_array<type_t,block_size_u>::block_sparse_array(cc0::slice<type2_t> dense, cc0::allocator *allocator) : m_blocks(allocator), m_values(allocator), m_size(0)
+{
+	from_dense(dense);
+}
+
+template < typename type_t, uint64_t block_size_u >
+void cc0::block_sparse_array<type_t,block_size_u>::create(uint64_t size)
+{
+	m_blocks.resize(0);
+	m_values.resize(0);
+	m_size = size;
+}
+
+template < typename type_t, uint64_t block_size_u >
+void cc0::block_sparse_array<type_t,block_size_u>::destroy( void )
+{
+	m_blocks.destroy(false);
+	m_values.destroy(false);
+	m_size = 0;
+}
+
+template < typename type_t, uint64_t block_size_u >
+void cc0::block_sparse_array<type_t,block_size_u>::reserve(uint64_t count)
+{
+	m_blocks.reserve(count);
+	m_values.reserve(count * block_size_u);
+}
+
+template < typename type_t, uint64_t block_size_u >
+void cc0::block_sparse_array<type_t,block_size_u>::set(uint64_t index, const type_t &value)
+{
+	CC0_ARR_ASSERT(index < m_size);
+	const uint64_t block = index / block_size_u;
+	// Blocks are usually set in order, so check the last block before searching.
+	uint64_t at = m_blocks.size() > 0 && m_blocks[m_blocks.size() - 1] < block ? m_blocks.size() : lower_bound(block);
+	if (at == m_blocks.size() || m_blocks[at] != block) {
+		if (cc0::internal::is_zero(value)) {
+			return;
+		}
+		insert(at, block);
+	}
+	m_values[at * block_size_u + index % block_size_u] = value;
+}
+
+template < typename type_t, uint64_t block_size_u >
+type_t cc0::block_sparse_array<type_t,block_size_u>::get(uint64_t index) const
+{
+	CC0_ARR_ASSERT(index < m_size);
+	const uint64_t block = index / block_size_u;
+	const uint64_t at = lower_bound(block);
+	return at < m_blocks.size() && m_blocks[at] == block ? m_values[at * block_size_u + index % block_size_u] : type_t();
+}
+
+template < typename type_t, uint64_t block_size_u >
+void cc0::block_sparse_array<type_t,block_size_u>::prune( void )
+{
+	uint64_t count = 0;
+	for (uint64_t i = 0; i < m_blocks.size(); ++i) {
+		bool nonzero = false;
+		for (uint64_t k = 0; k < block_size_u && !nonzero; ++k) {
+			nonzero = !cc0::internal::is_zero(m_values[i * block_size_u + k]);
+		}
+		if (nonzero) {
+			if (count != i) {
+				m_blocks[count] = m_blocks[i];
+				cc0::move(m_values(count * block_size_u, (count + 1) * block_size_u), m_values(i * block_size_u, (i + 1) * block_size_u));
+			}
+			++count;
+		}
+	}
+	m_blocks.resize(count);
+	m_values.resize(count * block_size_u);
+}
+
+template < typename type_t, uint64_t block_size_u >
+template < typename type2_t >
+void cc0::block_sparse_array<type_t,block_size_u>::from_dense(cc0::slice<type2_t> dense)
+{
+	create(dense.size());
+	for (uint64_t start = 0; start < dense.size(); start += block_size_u) {
+		const uint64_t end = dense.size() - start < block_size_u ? dense.size() : start + block_size_u;
+		bool nonzero = false;
+		for (uint64_t i = start; i < end && !nonzero; ++i) {
+			nonzero = !cc0::internal::is_zero(dense[i]);
+		}
+		if (nonzero) {
+			insert(m_blocks.size(), start / block_size_u);
+			cc0::copy(m_values((m_blocks.size() - 1) * block_size_u, m_values.size()), dense(start, end));
+		}
+	}
+}
+
+template < typename type_t, uint64_t block_size_u >
+template < typename type2_t >
+void cc0::block_sparse_array<type_t,block_size_u>::to_dense(cc0::slice<type2_t> dense) const
+{
+	CC0_ARR_ASSERT(dense.size() >= m_size);
+	typedef typename std::remove_cv<type2_t>::type value_t;
+	cc0::fill<type2_t>(dense(0, m_size), value_t());
+	for (uint64_t i = 0; i < m_blocks.size(); ++i) {
+		const uint64_t start = m_blocks[i] * block_size_u;
+		const uint64_t end = m_size - start < block_size_u ? m_size : start + block_size_u;
+		cc0::slice<const type_t> src = block(i);
+		cc0::copy(dense(start, end), src);
+	}
+}
+
+template < typename type_t, uint64_t block_size_u >
+template < uint64_t align_u >
+void cc0::block_sparse_array<type_t,block_size_u>::to_dense(cc0::array<type_t,0,align_u> &dense) const
+{
+	dense.create(m_size);
+	to_dense(dense(0, m_size));
+}
+
+template < typename type_t, uint64_t block_size_u >
+cc0::slice<const uint64_t> cc0::block_sparse_array<type_t,block_size_u>::blocks( void ) const
+{
+	return m_blocks(0, m_blocks.size());
+}
+
+template < typename type_t, uint64_t block_size_u >
+cc0::slice<type_t> cc0::block_sparse_array<type_t,block_size_u>::block(uint64_t i)
+{
+	CC0_ARR_ASSERT(i < m_blocks.size());
+	return m_values(i * block_size_u, (i + 1) * block_size_u);
+}
+
+template < typename type_t, uint64_t block_size_u >
+cc0::slice<const type_t> cc0::block_sparse_array<type_t,block_size_u>::block(uint64_t i) const
+{
+	CC0_ARR_ASSERT(i < m_blocks.size());
+	return m_values(i * block_size_u, (i + 1) * block_size_u);
+}
+
+template < typename type_t, uint64_t block_size_u >
+cc0::allocator *cc0::block_sparse_array<type_t,block_size_u>::get_allocator( void ) const
+{
+	return m_values.get_allocator();
+}
+
+template < typename type_t, uint64_t block_size_u >
+uint64_t cc0::block_sparse_array<type_t,block_size_u>::block_count( void ) const
+{
+	return m_blocks.size();
+}
+
+template < typename type_t, uint64_t block_size_u >
+uint64_t cc0::block_sparse_array<type_t,block_size_u>::size( void ) const
+{
+	return m_size;
+}
+
+template < typename type_t, typename type2_t >
+type_t cc0::dot(const cc0::sparse_array<type_t> &a, cc0::slice<type2_t> b)
+{
+	CC0_ARR_ASSERT(b.size() >= a.size());
+	const uint64_t *indices = a.indices();
+	const type_t *values = a.values();
+	const uint64_t count = a.count();
+	// Independent accumulators overlap the latency of the gathered loads.
+	type_t s[4] = { type_t(), type_t(), type_t(), type_t() };
+	uint64_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		s[0] = s[0] + values[i]     * b[indices[i]];
+		s[1] = s[1] + values[i + 1] * b[indices[i + 1]];
+		s[2] = s[2] + values[i + 2] * b[indices[i + 2]];
+		s[3] = s[3] + values[i + 3] * b[indices[i + 3]];
+	}
+	for (; i < count; ++i) {
+		s[0] = s[0] + values[i] * b[indices[i]];
+	}
+	return (s[0] + s[1]) + (s[2] + s[3]);
+}
+
+template < typename type_t, uint64_t block_size_u, typename type2_t >
+type_t cc0::dot(const cc0::block_sparse_array<type_t,block_size_u> &a, cc0::slice<type2_t> b)
+{
+	CC0_ARR_ASSERT(b.size() >= a.size());
+	type_t s = type_t();
+	const cc0::slice<const uint64_t> blocks = a.blocks();
+	for (uint64_t i = 0; i < blocks.size(); ++i) {
+		const uint64_t start = blocks[i] * block_size_u;
+		const uint64_t count = a.size() - start < block_size_u ? a.size() - start : block_size_u;
+		const type_t *x = a.block(i);
+		const type2_t *y = static_cast<const type2_t*>(b) + start;
+		type_t t = type_t();
+		for (uint64_t k = 0; k < count; ++k) {
+			t = t + x[k] * y[k];
+		}
+		s = s + t;
+	}
+	return s;
+}
+
+template < typename type_t, typename type2_t >
+void cc0::axpy(const type_t &alpha, const cc0::sparse_array<type_t> &x, cc0::slice<type2_t> y)
+{
+	CC0_ARR_ASSERT(y.size() >= x.size());
+	const uint64_t *indices = x.indices();
+	const type_t *values = x.values();
+	for (uint64_t i = 0; i < x.count(); ++i) {
+		y[indices[i]] += alpha * values[i];
+	}
+}
+
+template < typename type_t, uint64_t block_size_u, typename type2_t >
+void cc0::axpy(const type_t &alpha, const cc0::block_sparse_array<type_t,block_size_u> &x, cc0::slice<type2_t> y)
+{
+	CC0_ARR_ASSERT(y.size() >= x.size());
+	const cc0::slice<const uint64_t> blocks = x.blocks();
+	for (uint64_t i = 0; i < blocks.size(); ++i) {
+		const uint64_t start = blocks[i] * block_size_u;
+		const uint64_t count = x.size() - start < block_size_u ? x.size() - start : block_size_u;
+		const type_t *src = x.block(i);
+		type2_t *dst = static_cast<type2_t*>(y) + start;
+		for (uint64_t k = 0; k < count; ++k) {
+			dst[k] += alpha * src[k];
+		}
+	}
+}
+
+template < typename type_t >
+cc0::sparse_array<type_t> cc0::operator+(const cc0::sparse_array<type_t> &a, const cc0::sparse_array<type_t> &b)
+{
+	return cc0::internal::merge<cc0::internal::sparse_add>(a, b);
+}
+
+template < typename type_t >
+cc0::sparse_array<type_t> cc0::operator-(const cc0::sparse_array<type_t> &a, const cc0::sparse_array<type_t> &b)
+{
+	return cc0::internal::merge<cc0::internal::sparse_sub>(a, b);
+}
+
+template < typename type_t >
+cc0::sparse_array<type_t> cc0::operator*(const cc0::sparse_array<type_t> &a, const cc0::sparse_array<type_t> &b)
+{
+	return cc0::internal::merge<cc0::internal::sparse_mul>(a, b);
+}
+
+template < typename type_t, uint64_t block_size_u >
+cc0::block_sparse_array<type_t,block_size_u> cc0::operator+(const cc0::block_sparse_array<type_t,block_size_u> &a, const cc0::block_sparse_array<type_t,block_size_u> &b)
+{
+	return cc0::internal::merge<cc0::internal::sparse_add>(a, b);
+}
+
+template < typename type_t, uint64_t block_size_u >
+cc0::block_sparse_array<type_t,block_size_u> cc0::operator-(const cc0::block_sparse_array<type_t,block_size_u> &a, const cc0::block_sparse_array<type_t,block_size_u> &b)
+{
+	return cc0::internal::merge<cc0::internal::sparse_sub>(a, b);
+}
+
+template < typename type_t, uint64_t block_size_u >
+cc0::block_sparse_array<type_t,block_size_u> cc0::operator*(const cc0::block_sparse_array<type_t,block_size_u> &a, const cc0::block_sparse_array<type_t,block_size_u> &b)
+{
+	return cc0::internal::merge<cc0::internal::sparse_mul>(a, b);
+}
+
+#endif
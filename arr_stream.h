@@ -0,0 +1,544 @@
+/// @file
+/// @author github.com/SirJonthe
+/// @date 2023
+/// @copyright Public domain.
+/// @license CC0 1.0
+
+#ifndef CC0_ARR_STREAM_H_INCLUDED__
+#define CC0_ARR_STREAM_H_INCLUDED__
+
+#include <cerrno>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <fcntl.h>
+#include <unistd.h>
+#include "arr.h"
+
+namespace cc0
+{
+	namespace internal
+	{
+		/// @brief Reads from a file descriptor until a buffer is full or the end of the stream is reached, retrying interrupted and short reads.
+		/// @param fd The file descriptor.
+		/// @param mem The buffer.
+		/// @param bytes The size of the buffer in bytes.
+		/// @param error Set to true if reading failed.
+		/// @return The number of bytes read.
+		uint64_t read_fully(int fd, void *mem, uint64_t bytes, bool &error);
+
+		/// @brief Writes a buffer to a file descriptor in full, retrying interrupted and short writes.
+		/// @param fd The file descriptor.
+		/// @param mem The buffer.
+		/// @param bytes The size of the buffer in bytes.
+		/// @param error Set to true if writing failed, or made no progress.
+		/// @return The number of bytes written.
+		uint64_t write_fully(int fd, const void *mem, uint64_t bytes, bool &error);
+
+		/// @brief A background thread performing one blocking read or write at a time, so that the caller can process one buffer while the next is transferred.
+		class stream_worker
+		{
+		private:
+			std::thread             m_thread;
+			std::mutex              m_lock;
+			std::condition_variable m_work;
+			std::condition_variable m_done;
+			int                     m_fd;
+			void                   *m_mem;
+			uint64_t                m_bytes;
+			bool                    m_write;
+			bool                    m_queued;
+			bool                    m_pending;
+			bool                    m_finished;
+			bool                    m_error;
+			bool                    m_stop;
+
+		private:
+			/// @brief The loop of the background thread.
+			void run( void );
+
+		public:
+			/// @brief Creates a worker. The thread is started on the first transfer.
+			stream_worker( void );
+
+			stream_worker(const stream_worker&) = delete;
+			stream_worker &operator=(const stream_worker&) = delete;
+
+			/// @brief Waits for the current transfer to finish, and stops the thread.
+			~stream_worker( void );
+
+			/// @brief Starts a transfer in the background. The previous transfer must have been waited for.
+			/// @param fd The file descriptor.
+			/// @param mem The buffer to read to or write from. Must remain valid until the transfer has been waited for.
+			/// @param bytes The number of bytes to transfer.
+			/// @param write True to write the buffer, false to read into it.
+			void submit(int fd, void *mem, uint64_t bytes, bool write);
+
+			/// @brief Waits for the current transfer to finish.
+			/// @param bytes Set to the number of bytes transferred, or 0 if there was no transfer.
+			/// @return False if the transfer failed.
+			bool wait(uint64_t &bytes);
+		};
+	}
+
+	/// @brief Reads a file or file descriptor in fixed-size chunks, providing each chunk as a read-only slice. The next chunk is read in the background while the current chunk is processed. Chunk memory is allocated when a stream is opened, and reused for every chunk, as well as for later streams of the same or smaller chunk size.
+	/// @note Requires a POSIX system.
+	/// @warning Each chunk is only valid until the next call to next or close.
+	/// @tparam type_t The type of the elements in the stream. Must be trivially copyable. Trailing bytes at the end of the stream that do not make up a full element are discarded.
+	template < typename type_t >
+	class stream_reader
+	{
+		static_assert(std::is_trivially_copyable<type_t>::value, "Streamed elements must be trivially copyable");
+
+	public:
+		/// @brief The default number of bytes in a chunk.
+		static constexpr uint64_t default_chunk_bytes = 1024 * 1024;
+
+	private:
+		cc0::array<type_t>           m_buffers[2];
+		cc0::internal::stream_worker m_worker;
+		uint64_t                     m_chunk;
+		uint64_t                     m_next;
+		int                          m_fd;
+		bool                         m_own;
+		bool                         m_end;
+		bool                         m_error;
+
+	public:
+		/// @brief Creates a reader without a stream.
+		/// @param chunk_size The number of elements in a chunk.
+		explicit stream_reader(uint64_t chunk_size = default_chunk_bytes / sizeof(type_t));
+
+		stream_reader(const stream_reader&) = delete;
+		stream_reader &operator=(const stream_reader&) = delete;
+
+		/// @brief Closes the stream.
+		~stream_reader( void );
+
+		/// @brief Opens a file for reading, closing any previous stream, and starts reading the first chunk.
+		/// @param path The path of the file.
+		/// @return True if the file could be opened.
+		bool open(const char *path);
+
+		/// @brief Reads from an open file descriptor, e.g. a pipe or a socket, closing any previous stream, and starts reading the first chunk.
+		/// @param fd The file descriptor.
+		/// @param own True if the reader should close the file descriptor when done.
+		void attach(int fd, bool own = false);
+
+		/// @brief Waits for any read in progress, and closes the stream.
+		void close( void );
+
+		/// @brief Waits for the next chunk, and starts reading the chunk after it. Reading blocks until a full chunk has been read, or the end of the stream is reached, so only the last chunk may be smaller than the chunk size.
+		/// @return The chunk, or an empty slice at the end of the stream or if reading failed.
+		cc0::slice<const type_t> next( void );
+
+		/// @brief Calls a function with every remaining chunk of the stream.
+		/// @tparam fn_t The type of the function, called as fn(cc0::slice<const type_t>).
+		/// @param fn The function.
+		/// @return False if reading failed.
+		template < typename fn_t >
+		bool for_each(fn_t fn);
+
+		/// @brief Determines if there is an open stream.
+		/// @return True if there is an open stream.
+		bool is_open( void ) const;
+
+		/// @brief Determines if reading the stream failed.
+		/// @return True if reading failed.
+		bool failed( void ) const;
+
+		/// @brief Gets the chunk size.
+		/// @return The number of elements in a chunk.
+		uint64_t chunk_size( void ) const;
+	};
+
+	/// @brief Writes slices to a file or file descriptor through fixed-size chunks. Full chunks are written in the background while the next chunk is filled. Chunk memory is allocated when a stream is opened, and reused for every chunk, as well as for later streams of the same or smaller chunk size.
+	/// @note Requires a POSIX system.
+	/// @tparam type_t The type of the elements in the stream. Must be trivially copyable.
+	template < typename type_t >
+	class stream_writer
+	{
+		static_assert(std::is_trivially_copyable<type_t>::value, "Streamed elements must be trivially copyable");
+
+	public:
+		/// @brief The default number of bytes in a chunk.
+		static constexpr uint64_t default_chunk_bytes = 1024 * 1024;
+
+	private:
+		cc0::array<type_t>           m_buffers[2];
+		cc0::internal::stream_worker m_worker;
+		uint64_t                     m_chunk;
+		uint64_t                     m_current;
+		uint64_t                     m_fill;
+		int                          m_fd;
+		bool                         m_own;
+		bool                         m_error;
+
+	private:
+		/// @brief Waits for the previous chunk to be written, and starts writing the current chunk.
+		void submit( void );
+
+	public:
+		/// @brief Creates a writer without a stream.
+		/// @param chunk_size The number of elements in a chunk.
+		explicit stream_writer(uint64_t chunk_size = default_chunk_bytes / sizeof(type_t));
+
+		stream_writer(const stream_writer&) = delete;
+		stream_writer &operator=(const stream_writer&) = delete;
+
+		/// @brief Flushes and closes the stream.
+		~stream_writer( void );
+
+		/// @brief Creates or truncates a file for writing, closing any previous stream.
+		/// @param path The path of the file.
+		/// @return True if the file could be opened.
+		bool open(const char *path);
+
+		/// @brief Writes to an open file descriptor, e.g. a pipe or a socket, closing any previous stream.
+		/// @param fd The file descriptor.
+		/// @param own True if the writer should close the file descriptor when done.
+		void attach(int fd, bool own = false);
+
+		/// @brief Flushes and closes the stream.
+		/// @return False if writing failed at any point.
+		bool close( void );
+
+		/// @brief Appends elements to the stream. Elements are copied to the current chunk, and chunks are written as they fill up.
+		/// @param values The elements.
+		/// @return False if writing failed at any point.
+		bool write(cc0::slice<const type_t> values);
+
+		/// @brief Writes all elements appended so far, and waits for them to be written.
+		/// @return False if writing failed at any point.
+		bool flush( void );
+
+		/// @brief Determines if there is an open stream.
+		/// @return True if there is an open stream.
+		bool is_open( void ) const;
+
+		/// @brief Determines if writing the stream failed.
+		/// @return True if writing failed.
+		bool failed( void ) const;
+
+		/// @brief Gets the chunk size.
+		/// @return The number of elements in a chunk.
+		uint64_t chunk_size( void ) const;
+	};
+}
+
+inline uint64_t cc0::internal::read_fully(int fd, void *mem, uint64_t bytes, bool &error)
+{
+	uint64_t total = 0;
+	while (total < bytes) {
+		const ssize_t n = ::read(fd, static_cast<char*>(mem) + total, bytes - total);
+		if (n > 0) {
+			total += uint64_t(n);
+		} else if (n == 0) {
+			break;
+		} else if (errno != EINTR) {
+			error = true;
+			break;
+		}
+	}
+	return total;
+}
+
+inline uint64_t cc0::internal::write_fully(int fd, const void *mem, uint64_t bytes, bool &error)
+{
+	uint64_t total = 0;
+	while (total < bytes) {
+		const ssize_t n = ::write(fd, static_cast<const char*>(mem) + total, bytes - total);
+		if (n > 0) {
+			total += uint64_t(n);
+		} else if (n == 0 || errno != EINTR) {
+			// A write of no bytes makes no progress, and retrying it would never finish.
+			error = true;
+			break;
+		}
+	}
+	return total;
+}
+
+inline void cc0::internal::stream_worker::run( void )
+{
+	std::unique_lock<std::mutex> lock(m_lock);
+	for (;;) {
+		m_work.wait(lock, [this]{ return m_stop || m_queued; });
+		if (m_stop) {
+			return;
+		}
+		m_queued = false;
+		const int fd = m_fd;
+		void *mem = m_mem;
+		const uint64_t bytes = m_bytes;
+		const bool write = m_write;
+		lock.unlock();
+		bool error = false;
+		const uint64_t done = write ? cc0::internal::write_fully(fd, mem, bytes, error) : cc0::internal::read_fully(fd, mem, bytes, error);
+		lock.lock();
+		m_bytes = done;
+		m_error = error;
+		m_finished = true;
+		m_done.notify_all();
+	}
+}
+
+inline cc0::internal::stream_worker::stream_worker( void ) : m_fd(-1), m_mem(nullptr), m_bytes(0), m_write(false), m_queued(false), m_pending(false), m_finished(false), m_error(false), m_stop(false)
+{}
+
+inline cc0::internal::stream_worker::~stream_worker( void )
+{
+	uint64_t bytes;
+	wait(bytes);
+	if (m_thread.joinable()) {
+		{
+			std::lock_guard<std::mutex> guard(m_lock);
+			m_stop = true;
+		}
+		m_work.notify_all();
+		m_thread.join();
+	}
+}
+
+inline void cc0::internal::stream_worker::submit(int fd, void *mem, uint64_t bytes, bool write)
+{
+	if (!m_thread.joinable()) {
+		m_thread = std::thread(&stream_worker::run, this);
+	}
+	{
+		std::lock_guard<std::mutex> guard(m_lock);
+		m_fd       = fd;
+		m_mem      = mem;
+		m_bytes    = bytes;
+		m_write    = write;
+		m_queued   = true;
+		m_pending  = true;
+		m_finished = false;
+	}
+	m_work.notify_all();
+}
+
+inline bool cc0::internal::stream_worker::wait(uint64_t &bytes)
+{
+	std::unique_lock<std::mutex> lock(m_lock);
+	if (!m_pending) {
+		bytes = 0;
+		return true;
+	}
+	m_done.wait(lock, [this]{ return m_finished; });
+	m_pending = false;
+	bytes = m_bytes;
+	return !m_error;
+}
+
+template < typename type_t >
+cc0::stream_reader<type_t>::stream_reader(uint64_t chunk_size) : m_chunk(chunk_size > 0 ? chunk_size : 1), m_next(0), m_fd(-1), m_own(false), m_end(true), m_error(false)
+{}
+
+template < typename type_t >
+cc0::stream_reader<type_t>::~stream_reader( void )
+{
+	close();
+}
+
+template < typename type_t >
+bool cc0::stream_reader<type_t>::open(const char *path)
+{
+	close();
+	const int fd = ::open(path, O_RDONLY);
+	if (fd < 0) {
+		return false;
+	}
+	attach(fd, true);
+	return true;
+}
+
+template < typename type_t >
+void cc0::stream_reader<type_t>::attach(int fd, bool own)
+{
+	close();
+	m_buffers[0].create(m_chunk, true);
+	m_buffers[1].create(m_chunk, true);
+	m_fd = fd;
+	m_own = own;
+	m_next = 0;
+	m_end = false;
+	m_error = false;
+	m_worker.submit(m_fd, static_cast<type_t*>(m_buffers[0]), m_chunk * sizeof(type_t), false);
+}
+
+template < typename type_t >
+void cc0::stream_reader<type_t>::close( void )
+{
+	uint64_t bytes;
+	m_worker.wait(bytes);
+	if (m_fd >= 0 && m_own) {
+		::close(m_fd);
+	}
+	m_fd = -1;
+	m_own = false;
+	m_end = true;
+}
+
+template < typename type_t >
+cc0::slice<const type_t> cc0::stream_reader<type_t>::next( void )
+{
+	if (m_end) {
+		return cc0::slice<const type_t>();
+	}
+	uint64_t bytes;
+	if (!m_worker.wait(bytes)) {
+		m_error = true;
+		m_end = true;
+		return cc0::slice<const type_t>();
+	}
+	const uint64_t current = m_next;
+	if (bytes < m_chunk * sizeof(type_t)) {
+		m_end = true;
+	} else {
+		// The other buffer held the previous chunk, which the caller is done with.
+		m_next ^= 1;
+		m_worker.submit(m_fd, static_cast<type_t*>(m_buffers[m_next]), m_chunk * sizeof(type_t), false);
+	}
+	return m_buffers[current](0, bytes / sizeof(type_t));
+}
+
+template < typename type_t >
+template < typename fn_t >
+bool cc0::stream_reader<type_t>::for_each(fn_t fn)
+{
+	for (cc0::slice<const type_t> chunk = next(); chunk.size() > 0; chunk = next()) {
+		fn(chunk);
+	}
+	return !m_error;
+}
+
+template < typename type_t >
+bool cc0::stream_reader<type_t>::is_open( void ) const
+{
+	return m_fd >= 0;
+}
+
+template < typename type_t >
+bool cc0::stream_reader<type_t>::failed( void ) const
+{
+	return m_error;
+}
+
+template < typename type_t >
+uint64_t cc0::stream_reader<type_t>::chunk_size( void ) const
+{
+	return m_chunk;
+}
+
+template < typename type_t >
+void cc0::stream_writer<type_t>::submit( void )
+{
+	uint64_t bytes;
+	if (!m_worker.wait(bytes)) {
+		m_error = true;
+	}
+	if (m_fill > 0 && !m_error) {
+		m_worker.submit(m_fd, static_cast<type_t*>(m_buffers[m_current]), m_fill * sizeof(type_t), true);
+		m_current ^= 1;
+	}
+	m_fill = 0;
+}
+
+template < typename type_t >
+cc0::stream_writer<type_t>::stream_writer(uint64_t chunk_size) : m_chunk(chunk_size > 0 ? chunk_size : 1), m_current(0), m_fill(0), m_fd(-1), m_own(false), m_error(false)
+{}
+
+template < typename type_t >
+cc0::stream_writer<type_t>::~stream_writer( void )
+{
+	close();
+}
+
+template < typename type_t >
+bool cc0::stream_writer<type_t>::open(const char *path)
+{
+	close();
+	const int fd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (fd < 0) {
+		return false;
+	}
+	attach(fd, true);
+	return true;
+}
+
+template < typename type_t >
+void cc0::stream_writer<type_t>::attach(int fd, bool own)
+{
+	close();
+	m_buffers[0].create(m_chunk, true);
+	m_buffers[1].create(m_chunk, true);
+	m_fd = fd;
+	m_own = own;
+	m_current = 0;
+	m_fill = 0;
+	m_error = false;
+}
+
+template < typename type_t >
+bool cc0::stream_writer<type_t>::close( void )
+{
+	if (m_fd < 0) {
+		return !m_error;
+	}
+	flush();
+	if (m_own && ::close(m_fd) != 0) {
+		m_error = true;
+	}
+	m_fd = -1;
+	m_own = false;
+	return !m_error;
+}
+
+template < typename type_t >
+bool cc0::stream_writer<type_t>::write(cc0::slice<const type_t> values)
+{
+	uint64_t done = 0;
+	while (done < values.size() && m_fd >= 0 && !m_error) {
+		const uint64_t space = m_chunk - m_fill;
+		const uint64_t n = values.size() - done < space ? values.size() - done : space;
+		cc0::copy<type_t,const type_t>(m_buffers[m_current](m_fill, m_fill + n), values(done, done + n));
+		m_fill += n;
+		done += n;
+		if (m_fill == m_chunk) {
+			submit();
+		}
+	}
+	return !m_error && done == values.size();
+}
+
+template < typename type_t >
+bool cc0::stream_writer<type_t>::flush( void )
+{
+	submit();
+	uint64_t bytes;
+	if (!m_worker.wait(bytes)) {
+		m_error = true;
+	}
+	return !m_error;
+}
+
+template < typename type_t >
+bool cc0::stream_writer<type_t>::is_open( void ) const
+{
+	return m_fd >= 0;
+}
+
+template < typename type_t >
+bool cc0::stream_writer<type_t>::failed( void ) const
+{
+	return m_error;
+}
+
+template < typename type_t >
+uint64_t cc0::stream_writer<type_t>::chunk_size( void ) const
+{
+	return m_chunk;
+}
+
+#endif
@@ -0,0 +1,466 @@
+/// @file
+/// @author github.com/SirJonthe
+/// @date 2023
+/// @copyright Public domain.
+/// @license CC0 1.0
+
+// Benchmarks of the arr primitives against standard library baselines. Build with optimizations and run:
+//   g++ -std=c++11 -O2 -DNDEBUG bench/arr_bench.cpp -o arr_bench
+//   ./arr_bench [--format=csv|json] [--filter=<substring>] [--min-time=<seconds>]
+// Results are written to standard output, one record per benchmark, for diffing between builds.
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+#if __cplusplus >= 202002L
+	#include <span>
+#endif
+#include "../arr.h"
+
+namespace bench
+{
+	/// @brief A pointer and a size, standing in for std::span on standards before C++20.
+	/// @tparam type_t The type of the elements.
+	template < typename type_t >
+	struct span
+	{
+		type_t   *data;
+		uint64_t  size;
+	};
+
+	/// @brief Prevents the compiler from optimizing away the computation of a value.
+	/// @tparam type_t The type of the value.
+	/// @param value The value.
+	template < typename type_t >
+	void do_not_optimize(const type_t &value);
+
+	/// @brief Prevents the compiler from assuming that memory is unchanged across the call.
+	void clobber( void );
+
+	/// @brief Gets a printable name of an element type.
+	/// @tparam type_t The type.
+	template < typename type_t > struct type_name;
+	template <> struct type_name<uint8_t>     { static const char *get( void ) { return "u8"; } };
+	template <> struct type_name<uint32_t>    { static const char *get( void ) { return "u32"; } };
+	template <> struct type_name<double>      { static const char *get( void ) { return "f64"; } };
+	template <> struct type_name<std::string> { static const char *get( void ) { return "string"; } };
+
+	/// @brief Gets a non-trivial value of an element type.
+	/// @tparam type_t The type.
+	/// @param i A number to derive the value from.
+	/// @return The value.
+	template < typename type_t >
+	type_t make_value(uint64_t i);
+
+	/// @brief The options of a benchmark run.
+	struct options
+	{
+		bool        json;
+		const char *filter;
+		double      min_time;
+	};
+
+	/// @brief Runs benchmarks and writes their results.
+	class runner
+	{
+	private:
+		options m_options;
+		bool    m_first;
+
+	public:
+		/// @brief Creates a runner and writes the header of the results.
+		/// @param opt The options of the run.
+		explicit runner(const options &opt);
+
+		/// @brief Writes the footer of the results.
+		~runner( void );
+
+		/// @brief Measures a benchmark, unless it is filtered out, and writes the result. The benchmark is run with a doubling number of iterations until the run takes at least the minimum time.
+		/// @tparam fn_t The type of the benchmark function, called with the number of iterations to run.
+		/// @param group The operation being measured, e.g. "fill".
+		/// @param container The container being measured, e.g. "cc0::array".
+		/// @param type The name of the element type.
+		/// @param size The number of elements operated on by each iteration.
+		/// @param bytes The number of bytes processed by each iteration, or zero.
+		/// @param fn The benchmark function.
+		template < typename fn_t >
+		void run(const char *group, const char *container, const char *type, uint64_t size, uint64_t bytes, fn_t fn);
+	};
+}
+
+template < typename type_t >
+void bench::do_not_optimize(const type_t &value)
+{
+#if defined(__GNUC__)
+	asm volatile("" : : "r,m"(value) : "memory");
+#else
+	static volatile const void *sink;
+	sink = &value;
+#endif
+}
+
+inline void bench::clobber( void )
+{
+#if defined(__GNUC__)
+	asm volatile("" : : : "memory");
+#endif
+}
+
+template < typename type_t >
+type_t bench::make_value(uint64_t i)
+{
+	return type_t(i % 100 + 1);
+}
+
+namespace bench
+{
+	template <>
+	std::string make_value<std::string>(uint64_t i)
+	{
+		// Long enough to defeat the small string optimization.
+		return std::string(32, char('a' + i % 26));
+	}
+}
+
+bench::runner::runner(const options &opt) : m_options(opt), m_first(true)
+{
+	if (m_options.json) {
+		std::printf("{\n\t\"benchmarks\": [");
+	} else {
+		std::printf("group,container,type,size,iterations,ns_per_op,bytes_per_second\n");
+	}
+}
+
+bench::runner::~runner( void )
+{
+	if (m_options.json) {
+		std::printf("\n\t]\n}\n");
+	}
+}
+
+template < typename fn_t >
+void bench::runner::run(const char *group, const char *container, const char *type, uint64_t size, uint64_t bytes, fn_t fn)
+{
+	char name[256];
+	std::snprintf(name, sizeof(name), "%s/%s/%s/%llu", group, container, type, (unsigned long long)size);
+	if (m_options.filter != nullptr && std::strstr(name, m_options.filter) == nullptr) {
+		return;
+	}
+
+	typedef std::chrono::steady_clock clock;
+	uint64_t iterations = 1;
+	double   seconds = 0.0;
+	fn(1); // Warm up caches and allocator pools.
+	for (;;) {
+		const clock::time_point start = clock::now();
+		fn(iterations);
+		seconds = std::chrono::duration<double>(clock::now() - start).count();
+		if (seconds >= m_options.min_time || iterations >= (uint64_t(1) << 40)) {
+			break;
+		}
+		iterations *= seconds > m_options.min_time / 64.0 ? 2 : 8;
+	}
+	const double ns_per_op = seconds * 1e9 / double(iterations);
+	const double bytes_per_second = bytes > 0 ? double(bytes) * double(iterations) / seconds : 0.0;
+
+	if (m_options.json) {
+		std::printf("%s\n\t\t{ \"name\": \"%s\", \"group\": \"%s\", \"container\": \"%s\", \"type\": \"%s\", \"size\": %llu, \"iterations\": %llu, \"ns_per_op\": %.3f, \"bytes_per_second\": %.0f }", m_first ? "" : ",", name, group, container, type, (unsigned long long)size, (unsigned long long)iterations, ns_per_op, bytes_per_second);
+	} else {
+		std::printf("%s,%s,%s,%llu,%llu,%.3f,%.0f\n", group, container, type, (unsigned long long)size, (unsigned long long)iterations, ns_per_op, bytes_per_second);
+	}
+	std::fflush(stdout);
+	m_first = false;
+}
+
+// Creation and destruction of variable-sized arrays. Note that cc0::array default-initializes trivial elements, while std::vector value-initializes them.
+template < typename type_t >
+void bench_create_destroy(bench::runner &r, uint64_t size)
+{
+	const char    *type  = bench::type_name<type_t>::get();
+	const uint64_t bytes = 0;
+
+	r.run("create_destroy", "cc0::array", type, size, bytes, [size](uint64_t n) {
+		cc0::array<type_t> a;
+		for (uint64_t i = 0; i < n; ++i) {
+			a.create(size, false);
+			bench::do_not_optimize(static_cast<type_t*>(a));
+			a.destroy(false);
+		}
+	});
+	r.run("create_destroy", "cc0::array(use_pool)", type, size, bytes, [size](uint64_t n) {
+		cc0::array<type_t> a;
+		for (uint64_t i = 0; i < n; ++i) {
+			a.create(size, true);
+			bench::do_not_optimize(static_cast<type_t*>(a));
+			a.destroy(true);
+		}
+	});
+	r.run("create_destroy", "std::vector", type, size, bytes, [size](uint64_t n) {
+		std::vector<type_t> v;
+		for (uint64_t i = 0; i < n; ++i) {
+			v.resize(size);
+			bench::do_not_optimize(v.data());
+			v.clear();
+			v.shrink_to_fit();
+		}
+	});
+	r.run("create_destroy", "std::vector(keep_capacity)", type, size, bytes, [size](uint64_t n) {
+		std::vector<type_t> v;
+		for (uint64_t i = 0; i < n; ++i) {
+			v.resize(size);
+			bench::do_not_optimize(v.data());
+			v.clear();
+		}
+	});
+}
+
+// Deep copies of variable-sized arrays from the different source types.
+template < typename type_t >
+void bench_copy(bench::runner &r, uint64_t size)
+{
+	const char    *type  = bench::type_name<type_t>::get();
+	const uint64_t bytes = size * sizeof(type_t);
+
+	cc0::array<type_t> src(size);
+	std::vector<type_t> vsrc(size);
+	for (uint64_t i = 0; i < size; ++i) {
+		src[i] = vsrc[i] = bench::make_value<type_t>(i);
+	}
+
+	r.run("copy", "cc0::array<-array", type, size, bytes, [&src](uint64_t n) {
+		for (uint64_t i = 0; i < n; ++i) {
+			cc0::array<type_t> a(src);
+			bench::do_not_optimize(static_cast<type_t*>(a));
+		}
+	});
+	r.run("copy", "cc0::array<-slice", type, size, bytes, [&src](uint64_t n) {
+		const cc0::slice<const type_t> s = src;
+		for (uint64_t i = 0; i < n; ++i) {
+			cc0::array<type_t> a(s);
+			bench::do_not_optimize(static_cast<type_t*>(a));
+		}
+	});
+	r.run("copy", "cc0::array=array", type, size, bytes, [&src](uint64_t n) {
+		cc0::array<type_t> a;
+		for (uint64_t i = 0; i < n; ++i) {
+			a = src;
+			bench::do_not_optimize(static_cast<type_t*>(a));
+		}
+	});
+	r.run("copy", "std::vector<-vector", type, size, bytes, [&vsrc](uint64_t n) {
+		for (uint64_t i = 0; i < n; ++i) {
+			std::vector<type_t> v(vsrc);
+			bench::do_not_optimize(v.data());
+		}
+	});
+	r.run("copy", "std::vector=vector", type, size, bytes, [&vsrc](uint64_t n) {
+		std::vector<type_t> v;
+		for (uint64_t i = 0; i < n; ++i) {
+			v = vsrc;
+			bench::do_not_optimize(v.data());
+		}
+	});
+}
+
+// Copies of fixed-size arrays from fixed arrays and value lists.
+template < typename type_t, uint64_t size_u >
+void bench_copy_fixed(bench::runner &r)
+{
+	const char    *type  = bench::type_name<type_t>::get();
+	const uint64_t bytes = size_u * sizeof(type_t);
+
+	cc0::array<type_t,size_u> src;
+	cc0::values<type_t,size_u> vals;
+	std::array<type_t,size_u> ssrc;
+	for (uint64_t i = 0; i < size_u; ++i) {
+		src[i] = vals.v[i] = ssrc[i] = bench::make_value<type_t>(i);
+	}
+
+	r.run("copy_fixed", "cc0::array<-array", type, size_u, bytes, [&src](uint64_t n) {
+		for (uint64_t i = 0; i < n; ++i) {
+			bench::clobber();
+			cc0::array<type_t,size_u> a(src);
+			bench::do_not_optimize(a);
+		}
+	});
+	r.run("copy_fixed", "cc0::array<-values", type, size_u, bytes, [&vals](uint64_t n) {
+		for (uint64_t i = 0; i < n; ++i) {
+			bench::clobber();
+			cc0::array<type_t,size_u> a(vals);
+			bench::do_not_optimize(a);
+		}
+	});
+	r.run("copy_fixed", "std::array<-array", type, size_u, bytes, [&ssrc](uint64_t n) {
+		for (uint64_t i = 0; i < n; ++i) {
+			bench::clobber();
+			std::array<type_t,size_u> a(ssrc);
+			bench::do_not_optimize(a);
+		}
+	});
+}
+
+// Move assignment back and forth between two variable-sized arrays.
+template < typename type_t >
+void bench_move_assign(bench::runner &r, uint64_t size)
+{
+	const char *type = bench::type_name<type_t>::get();
+
+	r.run("move_assign", "cc0::array", type, size, 0, [size](uint64_t n) {
+		cc0::array<type_t> a(size), b;
+		for (uint64_t i = 0; i < n; ++i) {
+			b = std::move(a);
+			a = std::move(b);
+			bench::do_not_optimize(static_cast<type_t*>(a));
+		}
+	});
+	r.run("move_assign", "std::vector", type, size, 0, [size](uint64_t n) {
+		std::vector<type_t> a(size), b;
+		for (uint64_t i = 0; i < n; ++i) {
+			b = std::move(a);
+			a = std::move(b);
+			bench::do_not_optimize(a.data());
+		}
+	});
+}
+
+// Filling all elements with a value.
+template < typename type_t >
+void bench_fill(bench::runner &r, uint64_t size)
+{
+	const char    *type  = bench::type_name<type_t>::get();
+	const uint64_t bytes = size * sizeof(type_t);
+	const type_t   value = bench::make_value<type_t>(7);
+
+	r.run("fill", "cc0::fill(slice)", type, size, bytes, [size, &value](uint64_t n) {
+		cc0::array<type_t> a(size);
+		for (uint64_t i = 0; i < n; ++i) {
+			cc0::fill<type_t>(a, value);
+			bench::do_not_optimize(static_cast<type_t*>(a));
+		}
+	});
+	r.run("fill", "cc0::array(loop)", type, size, bytes, [size, &value](uint64_t n) {
+		cc0::array<type_t> a(size);
+		for (uint64_t i = 0; i < n; ++i) {
+			for (uint64_t j = 0; j < a.size(); ++j) {
+				a[j] = value;
+			}
+			bench::do_not_optimize(static_cast<type_t*>(a));
+		}
+	});
+	r.run("fill", "std::fill(vector)", type, size, bytes, [size, &value](uint64_t n) {
+		std::vector<type_t> v(size);
+		for (uint64_t i = 0; i < n; ++i) {
+			std::fill(v.begin(), v.end(), value);
+			bench::do_not_optimize(v.data());
+		}
+	});
+}
+
+// Creation of sub-views at every offset of an array, summing the first element of each view.
+template < typename type_t >
+void bench_slice(bench::runner &r, uint64_t size)
+{
+	const char    *type   = bench::type_name<type_t>::get();
+	const uint64_t window = size / 2;
+
+	cc0::array<type_t> a(size);
+	for (uint64_t i = 0; i < size; ++i) {
+		a[i] = bench::make_value<type_t>(i);
+	}
+
+	r.run("slice", "cc0::array(start,end)", type, size, 0, [&a, window](uint64_t n) {
+		uint64_t sum = 0;
+		for (uint64_t i = 0; i < n; ++i) {
+			const uint64_t start = i % (a.size() - window + 1);
+			cc0::slice<type_t> s = a(start, start + window);
+			bench::do_not_optimize(s);
+			sum += s.size();
+		}
+		bench::do_not_optimize(sum);
+	});
+	r.run("slice", "cc0::slice(start,end)", type, size, 0, [&a, window](uint64_t n) {
+		cc0::slice<type_t> full = a;
+		uint64_t sum = 0;
+		for (uint64_t i = 0; i < n; ++i) {
+			const uint64_t start = i % (full.size() - window + 1);
+			cc0::slice<type_t> s = full(start, start + window);
+			bench::do_not_optimize(s);
+			sum += s.size();
+		}
+		bench::do_not_optimize(sum);
+	});
+#if __cplusplus >= 202002L
+	r.run("slice", "std::span::subspan", type, size, 0, [&a, window](uint64_t n) {
+		const std::span<type_t> full(static_cast<type_t*>(a), a.size());
+		uint64_t sum = 0;
+		for (uint64_t i = 0; i < n; ++i) {
+			const uint64_t start = i % (full.size() - window + 1);
+			std::span<type_t> s = full.subspan(start, window);
+			bench::do_not_optimize(s);
+			sum += s.size();
+		}
+		bench::do_not_optimize(sum);
+	});
+#else
+	r.run("slice", "pointer+size", type, size, 0, [&a, window](uint64_t n) {
+		const bench::span<type_t> full = { static_cast<type_t*>(a), a.size() };
+		uint64_t sum = 0;
+		for (uint64_t i = 0; i < n; ++i) {
+			const uint64_t start = i % (full.size - window + 1);
+			bench::span<type_t> s = { full.data + start, window };
+			bench::do_not_optimize(s);
+			sum += s.size;
+		}
+		bench::do_not_optimize(sum);
+	});
+#endif
+}
+
+// Runs all benchmarks over one element type.
+template < typename type_t >
+void bench_type(bench::runner &r, uint64_t max_size)
+{
+	static const uint64_t sizes[] = { 16, 1024, 65536, 1048576 };
+	for (uint64_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]) && sizes[i] <= max_size; ++i) {
+		bench_create_destroy<type_t>(r, sizes[i]);
+		bench_copy<type_t>(r, sizes[i]);
+		bench_move_assign<type_t>(r, sizes[i]);
+		bench_fill<type_t>(r, sizes[i]);
+		bench_slice<type_t>(r, sizes[i]);
+	}
+	bench_copy_fixed<type_t,4>(r);
+	bench_copy_fixed<type_t,16>(r);
+	bench_copy_fixed<type_t,256>(r);
+}
+
+int main(int argc, char **argv)
+{
+	bench::options opt = { false, nullptr, 0.1 };
+	for (int i = 1; i < argc; ++i) {
+		if (std::strcmp(argv[i], "--format=json") == 0) {
+			opt.json = true;
+		} else if (std::strcmp(argv[i], "--format=csv") == 0) {
+			opt.json = false;
+		} else if (std::strncmp(argv[i], "--filter=", 9) == 0) {
+			opt.filter = argv[i] + 9;
+		} else if (std::strncmp(argv[i], "--min-time=", 11) == 0) {
+			opt.min_time = std::atof(argv[i] + 11);
+		} else {
+			std::fprintf(stderr, "usage: %s [--format=csv|json] [--filter=<substring>] [--min-time=<seconds>]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	bench::runner r(opt);
+	bench_type<uint8_t>(r, 1048576);
+	bench_type<uint32_t>(r, 1048576);
+	bench_type<double>(r, 1048576);
+	bench_type<std::string>(r, 65536); // Larger sizes of non-trivial elements mostly measure the allocator.
+	return 0;
+}